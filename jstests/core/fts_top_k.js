@@ -0,0 +1,79 @@
+// Tests that a $text query sorted by textScore with a limit returns the same scores as a full
+// text search, while reading only the postings it needs.
+// @tags: [
+//   assumes_no_implicit_index_creation,
+//   assumes_unsharded_collection,
+// ]
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const coll = db.fts_top_k;
+coll.drop();
+
+// A few documents mention "apple" and "banana" many times and score highly. The rest mention
+// each term once among filler words.
+let docs = [];
+for (let i = 0; i < 10; ++i) {
+    docs.push({_id: i, content: "apple ".repeat(10 + i) + "banana ".repeat(i)});
+}
+for (let i = 10; i < 300; ++i) {
+    docs.push({_id: i, content: "the apple and the banana were left on table number " + i});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({content: "text"}));
+
+function topScores(search, limit) {
+    return coll.find({$text: {$search: search}}, {score: {$meta: "textScore"}})
+        .sort({score: {$meta: "textScore"}})
+        .limit(limit)
+        .toArray()
+        .map(doc => doc.score);
+}
+
+function allScores(search) {
+    return coll.find({$text: {$search: search}}, {score: {$meta: "textScore"}})
+        .toArray()
+        .map(doc => doc.score)
+        .sort((a, b) => b - a);
+}
+
+for (let search of ["apple", "apple banana", "banana cherry"]) {
+    for (let limit of [1, 5, 20, 500]) {
+        assert.eq(allScores(search).slice(0, limit), topScores(search, limit), {search, limit});
+    }
+}
+
+// The TEXT_OR stage stops once no unread posting can beat the best five documents.
+let explain = coll.find({$text: {$search: "apple banana"}}, {score: {$meta: "textScore"}})
+                  .sort({score: {$meta: "textScore"}})
+                  .limit(5)
+                  .explain("executionStats");
+let textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+assert.neq(null, textOr, explain);
+assert.eq(5, textOr.topK, textOr);
+assert.eq(true, textOr.topKTerminatedEarly, textOr);
+assert.lt(textOr.docsExamined, docs.length, textOr);
+for (let ixscan of getPlanStages(textOr, "IXSCAN")) {
+    assert.lt(ixscan.keysExamined, docs.length - 10, textOr);
+}
+
+// Phrases and negations are checked after scoring, so they need every matching document.
+explain = coll.find({$text: {$search: "apple -banana"}}, {score: {$meta: "textScore"}})
+              .sort({score: {$meta: "textScore"}})
+              .limit(5)
+              .explain("executionStats");
+textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+assert.neq(null, textOr, explain);
+assert(!textOr.hasOwnProperty("topK"), textOr);
+
+// Without a limit every matching document is scored.
+explain = coll.find({$text: {$search: "apple"}}, {score: {$meta: "textScore"}})
+              .sort({score: {$meta: "textScore"}})
+              .explain("executionStats");
+textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+assert.neq(null, textOr, explain);
+assert(!textOr.hasOwnProperty("topK"), textOr);
+assert.eq(docs.length, textOr.docsExamined, textOr);
+})();
@@ -0,0 +1,55 @@
+// Tests that repeating $geoWithin and $geoIntersects queries on the same polygons, which reuse
+// cached coverings and prepared regions, keeps returning the same documents as a collection scan.
+// @tags: [
+//   assumes_no_implicit_index_creation,
+// ]
+(function() {
+"use strict";
+
+const coll = db.geo_within_repeated_polygon;
+coll.drop();
+
+let docs = [];
+let id = 0;
+for (let lng = -74.2; lng <= -73.7; lng += 0.01) {
+    for (let lat = 40.5; lat <= 41.0; lat += 0.01) {
+        docs.push({_id: id++, loc: {type: "Point", coordinates: [lng, lat]}});
+    }
+}
+assert.commandWorked(coll.insert(docs));
+
+function makeZone(lng, lat, radius, numVertices) {
+    let ring = [];
+    for (let i = 0; i < numVertices; ++i) {
+        const angle = 2 * Math.PI * i / numVertices;
+        ring.push([lng + radius * Math.cos(angle), lat + radius * Math.sin(angle)]);
+    }
+    ring.push(ring[0]);
+    return {type: "Polygon", coordinates: [ring]};
+}
+
+const zones = [
+    makeZone(-73.95, 40.75, 0.1, 8),
+    makeZone(-73.95, 40.75, 0.1, 500),
+    makeZone(-74.0, 40.7, 0.05, 50),
+];
+
+function ids(pred, hint) {
+    return coll.find({loc: pred}, {_id: 1}).hint(hint).sort({_id: 1}).toArray().map(d => d._id);
+}
+
+let expected = zones.map(zone => ids({$geoWithin: {$geometry: zone}}, {$natural: 1}));
+for (let i = 0; i < zones.length; ++i) {
+    assert.gt(expected[i].length, 0, zones[i]);
+    assert.eq(expected[i], ids({$geoIntersects: {$geometry: zones[i]}}, {$natural: 1}));
+}
+
+assert.commandWorked(coll.createIndex({loc: "2dsphere"}));
+for (let repeat = 0; repeat < 3; ++repeat) {
+    for (let i = 0; i < zones.length; ++i) {
+        assert.eq(expected[i], ids({$geoWithin: {$geometry: zones[i]}}, {loc: "2dsphere"}));
+        assert.eq(expected[i], ids({$geoWithin: {$geometry: zones[i]}}, {$natural: 1}));
+        assert.eq(expected[i], ids({$geoIntersects: {$geometry: zones[i]}}, {loc: "2dsphere"}));
+    }
+}
+})();
@@ -0,0 +1,75 @@
+// Tests that index keys stay correct when an update changes fields next to, but not inside, the
+// paths an index depends on, and when it changes the fields referenced by a partial filter.
+// @tags: [assumes_unsharded_collection, requires_fcv_44]
+(function() {
+"use strict";
+
+const coll = db.update_unaffected_index_keys;
+coll.drop();
+
+assert.commandWorked(coll.createIndex({"a.b": 1}));
+assert.commandWorked(coll.createIndex({"a.b.c": 1, d: 1}));
+assert.commandWorked(coll.createIndex({e: 1}, {partialFilterExpression: {f: {$gt: 0}}}));
+assert.commandWorked(coll.createIndex({g: "hashed"}));
+
+// Returns the keys of the index with 'keyPattern' for the document with '_id'.
+function indexKeys(keyPattern, _id) {
+    return coll.find({_id: _id}).hint(keyPattern).returnKey().toArray();
+}
+
+// Checks that the indexes hold the keys generated by the current version of document '_id'. The
+// document must have a scalar 'a.b'.
+function assertIndexKeysMatchDocument(_id) {
+    const doc = coll.findOne({_id: _id});
+    assert.eq([{"a.b": doc.a.b}], indexKeys({"a.b": 1}, _id), tojson(doc));
+
+    const partialKeys = indexKeys({e: 1}, _id);
+    if (doc.f > 0) {
+        assert.eq([{e: doc.hasOwnProperty("e") ? doc.e : null}], partialKeys, tojson(doc));
+    } else {
+        assert.eq([], partialKeys, tojson(doc));
+    }
+
+    assert.eq(1, indexKeys({"a.b.c": 1, d: 1}, _id).length, tojson(doc));
+    assert.eq(1, indexKeys({g: "hashed"}, _id).length, tojson(doc));
+}
+
+assert.commandWorked(coll.insert({_id: 0, a: {b: 1, x: 1}, d: 1, e: 1, f: 0, g: 1}));
+assertIndexKeysMatchDocument(0);
+
+// Changing a sibling of an indexed subfield, or an unindexed field, leaves the keys alone.
+assert.commandWorked(coll.update({_id: 0}, {$set: {"a.x": 2, h: 1}}));
+assertIndexKeysMatchDocument(0);
+
+// Changing the indexed subfield updates the keys.
+assert.commandWorked(coll.update({_id: 0}, {$set: {"a.b": 2}}));
+assertIndexKeysMatchDocument(0);
+assert.eq(1, coll.find({"a.b": 2}).hint({"a.b": 1}).itcount());
+assert.eq(0, coll.find({"a.b": 1}).hint({"a.b": 1}).itcount());
+
+// Changing the type of the parent of an indexed subfield updates the keys.
+assert.commandWorked(coll.update({_id: 0}, {$set: {a: [{b: 3}, {b: 4}]}}));
+assert.eq(1, coll.find({"a.b": 4}).hint({"a.b": 1}).itcount());
+assert.commandWorked(coll.update({_id: 0}, {$set: {a: {b: 5}}}));
+assertIndexKeysMatchDocument(0);
+
+// Changing only the field referenced by a partial filter moves the document into and out of
+// the partial index.
+assert.commandWorked(coll.update({_id: 0}, {$set: {f: 1}}));
+assertIndexKeysMatchDocument(0);
+assert.eq(1, coll.find({e: 1, f: {$gt: 0}}).hint({e: 1}).itcount());
+assert.commandWorked(coll.update({_id: 0}, {$set: {f: -1}}));
+assertIndexKeysMatchDocument(0);
+assert.eq(0, coll.find({e: 1, f: {$gt: 0}}).hint({e: 1}).itcount());
+
+// Replacement-style updates are handled the same way.
+assert.commandWorked(coll.update({_id: 0}, {a: {b: 5, y: 1}, d: 1, e: 2, f: 2, g: 1}));
+assertIndexKeysMatchDocument(0);
+assert.commandWorked(coll.update({_id: 0}, {a: {b: 6, y: 1}, d: 1, e: 2, f: 2, g: 2}));
+assertIndexKeysMatchDocument(0);
+assert.eq(1, coll.find({g: 2}).hint({g: "hashed"}).itcount());
+assert.eq(0, coll.find({g: 1}).hint({g: "hashed"}).itcount());
+
+const res = assert.commandWorked(coll.validate({full: true}));
+assert(res.valid, tojson(res));
+}());
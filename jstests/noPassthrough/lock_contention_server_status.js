@@ -0,0 +1,54 @@
+/**
+ * Tests that serverStatus reports lock wait time histograms in its 'lockContention' section, and
+ * the most waited on collections when asked to.
+ */
+(function() {
+'use strict';
+
+load("jstests/libs/parallel_shell_helpers.js");
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB('test');
+const lockTarget = 'test.contended';
+
+// Run two shells which repeatedly take the same collection lock in MODE_X, so that they wait for
+// each other.
+function startContendingShell() {
+    return startParallelShell(
+        funWithArgs(function(lockTarget) {
+            for (let i = 0; i < 50; i++) {
+                assert.commandWorked(db.adminCommand(
+                    {sleep: 1, millis: 10, lock: 'w', lockTarget: lockTarget}));
+            }
+        }, lockTarget), conn.port);
+}
+const awaitShells = [startContendingShell(), startContendingShell()];
+awaitShells.forEach((awaitShell) => awaitShell());
+
+// The histograms are reported by default, with every bucket, so that their shape doesn't change
+// and FTDC can collect them. The most waited on resources are only reported on request.
+const defaultSection = assert.commandWorked(db.serverStatus()).lockContention;
+assert(defaultSection, 'lockContention is missing from serverStatus');
+assert(!defaultSection.hasOwnProperty('topWaitedResources'), tojson(defaultSection));
+assert.eq(24, Object.keys(defaultSection.waitTimeHistogramMicros.Collection.r).length);
+assert.eq(24, Object.keys(defaultSection.waitTimeHistogramMicros.Global.w).length);
+
+const lockContention =
+    assert.commandWorked(db.serverStatus({lockContention: {includeTopWaitedResources: 1}}))
+        .lockContention;
+jsTestLog('lockContention: ' + tojson(lockContention));
+
+// Every wait for the collection lock lands in exactly one histogram bucket.
+const collectionWaits = lockContention.waitTimeHistogramMicros.Collection.W;
+assert(collectionWaits, tojson(lockContention));
+const numWaits = Object.values(collectionWaits).reduce((total, count) => total + count, 0);
+assert.gt(numWaits, 0, tojson(collectionWaits));
+
+const top = lockContention.topWaitedResources;
+assert.gt(top.length, 0, tojson(lockContention));
+assert.eq(lockTarget, top[0].resource, tojson(top));
+assert.eq('Collection', top[0].type, tojson(top));
+assert.gt(top[0].waitTimeMicros, 0, tojson(top));
+
+MongoRunner.stopMongod(conn);
+})();
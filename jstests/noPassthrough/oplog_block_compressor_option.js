@@ -0,0 +1,34 @@
+/**
+ * Tests that --wiredTigerOplogBlockCompressor sets the block compressor used for the oplog without
+ * changing the block compressor used for other collections.
+ *
+ * @tags: [requires_replication,requires_wiredtiger]
+ */
+(function() {
+'use strict';
+
+const rst = new ReplSetTest({
+    nodes: 1,
+    nodeOptions: {
+        wiredTigerCollectionBlockCompressor: 'snappy',
+        wiredTigerOplogBlockCompressor: 'zstd',
+    }
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+assert.commandWorked(primary.getDB('test').coll.insert({a: 1}));
+
+const oplogStats = primary.getDB('local').oplog.rs.stats();
+assert.gt(oplogStats['wiredTiger']['creationString'].search('block_compressor=zstd'),
+          -1,
+          tojson(oplogStats['wiredTiger']['creationString']));
+
+const collStats = primary.getDB('test').coll.stats();
+assert.gt(collStats['wiredTiger']['creationString'].search('block_compressor=snappy'),
+          -1,
+          tojson(collStats['wiredTiger']['creationString']));
+
+rst.stopSet();
+}());
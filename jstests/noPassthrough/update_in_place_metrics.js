@@ -0,0 +1,51 @@
+/**
+ * Tests that serverStatus counts updates applied in place by mutable BSON separately from updates
+ * which rewrite the whole document.
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB('test');
+const coll = db.update_in_place_metrics;
+
+function updateMetrics() {
+    return db.serverStatus().metrics.update;
+}
+
+function assertMetricsDelta(before, expected) {
+    const after = updateMetrics();
+    for (let name of ['inPlace', 'rewrite']) {
+        assert.eq(after[name] - before[name], expected[name] || 0, {name, before, after});
+    }
+}
+
+const bigArray = Array.from({length: 10000}, (_, i) => i);
+assert.commandWorked(coll.insert({_id: 0, counter: 0, name: 'abc', arr: bigArray}));
+
+// A same-size change is applied in place by mutable BSON.
+let before = updateMetrics();
+assert.commandWorked(coll.update({_id: 0}, {$inc: {counter: 1}}));
+assertMetricsDelta(before, {inPlace: 1});
+
+// Appending to the array, growing a string and adding a field all change the size of the
+// document, which is rewritten.
+before = updateMetrics();
+assert.commandWorked(coll.update({_id: 0}, {$push: {arr: 10000}}));
+assert.commandWorked(coll.update({_id: 0}, {$set: {name: 'abcdefghijklmnop'}}));
+assert.commandWorked(coll.update({_id: 0}, {$set: {'sub.x': 1}}));
+assertMetricsDelta(before, {rewrite: 3});
+
+bigArray.push(10000);
+assert.docEq({_id: 0, counter: 1, name: 'abcdefghijklmnop', arr: bigArray, sub: {x: 1}},
+             coll.findOne({_id: 0}));
+
+// Updates which affect an index are rewritten even when they keep the document's size.
+assert.commandWorked(coll.createIndex({name: 1}));
+before = updateMetrics();
+assert.commandWorked(coll.update({_id: 0}, {$set: {name: 'xyzxyzxyzxyzxyzx'}}));
+assertMetricsDelta(before, {rewrite: 1});
+assert.eq(1, coll.find({name: 'xyzxyzxyzxyzxyzx'}).hint({name: 1}).itcount());
+
+MongoRunner.stopMongod(conn);
+}());
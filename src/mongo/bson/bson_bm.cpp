@@ -31,6 +31,7 @@
 
 #include <benchmark/benchmark.h>
 
+#include "mongo/bson/bson_validate.h"
 #include "mongo/bson/bsonobjbuilder.h"
 
 namespace mongo {
@@ -63,7 +64,71 @@ void BM_arrayLookup(benchmark::State& state) {
     state.SetItemsProcessed(totalLen);
 }
 
+/**
+ * Builds a document of at least 'targetSize' bytes with a mix of field types resembling user data:
+ * numbers, short strings, dates, and nested objects and arrays. Returns the name of its last field
+ * through 'lastFieldName'.
+ */
+BSONObj buildDocument(int targetSize, std::string* lastFieldName) {
+    BSONObjBuilder builder;
+    builder.append("_id", OID::gen());
+    for (int i = 0; builder.len() < targetSize; i++) {
+        *lastFieldName = "field" + std::to_string(i);
+        switch (i % 5) {
+            case 0:
+                builder.append(*lastFieldName, i);
+                break;
+            case 1:
+                builder.append(*lastFieldName, "a string of typical length " + *lastFieldName);
+                break;
+            case 2:
+                builder.append(*lastFieldName, i * 1.5);
+                break;
+            case 3:
+                builder.appendDate(*lastFieldName, Date_t::fromMillisSinceEpoch(i));
+                break;
+            case 4:
+                builder.append(*lastFieldName,
+                               BSON("street"
+                                    << "1 Main St"
+                                    << "zip" << i << "tags" << BSON_ARRAY("x" << i)));
+                break;
+        }
+    }
+    return builder.obj();
+}
+
+void BM_validate(benchmark::State& state) {
+    std::string lastFieldName;
+    BSONObj doc = buildDocument(state.range(0), &lastFieldName);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(validateBSON(doc.objdata(), doc.objsize(), BSONVersion::kLatest));
+    }
+    state.SetBytesProcessed(state.iterations() * doc.objsize());
+}
+
+void BM_getFieldLast(benchmark::State& state) {
+    std::string lastFieldName;
+    BSONObj doc = buildDocument(state.range(0), &lastFieldName);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(doc.getField(lastFieldName));
+    }
+    state.SetBytesProcessed(state.iterations() * doc.objsize());
+}
+
+void BM_getFieldMissing(benchmark::State& state) {
+    std::string lastFieldName;
+    BSONObj doc = buildDocument(state.range(0), &lastFieldName);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(doc.getField("missingField"));
+    }
+    state.SetBytesProcessed(state.iterations() * doc.objsize());
+}
+
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayLookup)->Ranges({{{1}, {100'000}}});
+BENCHMARK(BM_validate)->RangeMultiplier(2)->Range(2 * 1024, 64 * 1024);
+BENCHMARK(BM_getFieldLast)->RangeMultiplier(2)->Range(2 * 1024, 64 * 1024);
+BENCHMARK(BM_getFieldMissing)->RangeMultiplier(2)->Range(2 * 1024, 64 * 1024);
 
 }  // namespace mongo
@@ -634,6 +634,28 @@ TEST(BSONObj, getFields) {
     ASSERT_EQUALS(fields[2].numberInt(), 6);
 }
 
+TEST(BSONObj, getFieldOnWideObject) {
+    BSONObjBuilder bob;
+    for (int i = 0; i < 100; ++i) {
+        bob.append("field" + std::to_string(i), i);
+    }
+    bob.append("decoy", "missing");
+    bob.append("prefixed", 1);
+    const BSONObj obj = bob.obj();
+    ASSERT_GTE(obj.objsize(), 1024);
+
+    ASSERT_EQUALS(obj.getField("field0").numberInt(), 0);
+    ASSERT_EQUALS(obj.getField("field99").numberInt(), 99);
+    ASSERT_EQUALS(obj.getField("prefixed").numberInt(), 1);
+
+    // Absent names, including ones which occur in a value or as a prefix or suffix of a field name.
+    ASSERT(obj.getField("missing").eoo());
+    ASSERT(obj.getField("prefix").eoo());
+    ASSERT(obj.getField("ield0").eoo());
+    ASSERT(obj.getField("field100").eoo());
+    ASSERT(obj.getField("").eoo());
+}
+
 TEST(BSONObj, getFieldsWithDuplicates) {
     auto e = BSON("a" << 2 << "b"
                       << "3"
@@ -27,9 +27,9 @@
  *    it in the license file.
  */
 
+#include <boost/container/small_vector.hpp>
 #include <cstring>
 #include <limits>
-#include <vector>
 
 #include "mongo/base/data_view.h"
 #include "mongo/bson/bson_depth.h"
@@ -309,8 +309,9 @@ Status validateElementInfo(Buffer* buffer,
 }
 
 Status validateBSONIterative(Buffer* buffer) {
-    std::vector<ValidationObjectFrame> frames;
-    frames.reserve(16);
+    // Validation runs on every document received from a client, so keep the frames of typical
+    // nesting depths on the stack rather than allocating them.
+    boost::container::small_vector<ValidationObjectFrame, 16> frames;
     ValidationObjectFrame* curr = nullptr;
     ValidationState::State state = ValidationState::BeginObj;
 
@@ -365,5 +365,23 @@ TEST(BSONValidateFast, InvalidType) {
     ASSERT_THROWS_CODE(obj.woCompare(BSON("A" << 1)), DBException, 10320);
 }
 
+TEST(BSONValidateFast, DeeplyNestedObjects) {
+    // Nest deeper than the number of frames the validator keeps inline.
+    BSONObj obj = BSON("x" << 1);
+    for (int i = 0; i < 100; ++i) {
+        obj = BSON("a" << obj << "b" << BSON_ARRAY(i << "str"));
+    }
+    ASSERT_OK(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+
+    // Corrupt the size of the innermost object.
+    BSONObj copy = obj.copy();
+    char* innermost = const_cast<char*>(copy.objdata());
+    for (int i = 0; i < 100; ++i) {
+        innermost = const_cast<char*>(BSONObj(innermost).firstElement().value());
+    }
+    DataView(innermost).write(tagLittleEndian(BSONObj(innermost).objsize() + 1));
+    ASSERT_NOT_OK(validateBSON(copy.objdata(), copy.objsize(), BSONVersion::kLatest));
+}
+
 
 }  // namespace
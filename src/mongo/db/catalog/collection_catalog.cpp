@@ -68,6 +68,18 @@ private:
     CollectionUUID _uuid;
 };
 
+/**
+ * Replaces '*shard' with a copy that has 'update' applied to it. Must only be called by writers
+ * serialized on '_catalogLock', as concurrent updates of the same shard would lose writes.
+ */
+template <typename Shard, typename UpdateFn>
+void updateLookupShard(std::shared_ptr<const Shard>* shard, UpdateFn&& update) {
+    auto current = std::atomic_load(shard);
+    auto next = current ? std::make_shared<Shard>(*current) : std::make_shared<Shard>();
+    update(*next);
+    std::atomic_store(shard, std::shared_ptr<const Shard>(std::move(next)));
+}
+
 }  // namespace
 
 CollectionCatalog::iterator::iterator(StringData dbName,
@@ -193,14 +205,14 @@ void CollectionCatalog::setCollectionNamespace(OperationContext* opCtx,
                                                Collection* coll,
                                                const NamespaceString& fromCollection,
                                                const NamespaceString& toCollection) {
-    // Rather than maintain, in addition to the UUID -> Collection* mapping, an auxiliary
-    // data structure with the UUID -> namespace mapping, the CollectionCatalog relies on
-    // Collection::ns() to provide UUID to namespace lookup. In addition, the CollectionCatalog
-    // does not require callers to hold locks.
+    // The point lookups answer UUID to namespace queries from the namespace cached in the lookup
+    // snapshots, but iteration and onCloseCatalog still rely on Collection::ns(). In addition,
+    // the CollectionCatalog does not require callers to hold locks.
     //
     // This means that Collection::ns() may be called while only '_catalogLock' (and no lock
     // manager locks) are held. The purpose of this function is ensure that we write to the
-    // Collection's namespace string under '_catalogLock'.
+    // Collection's namespace string under '_catalogLock', and that the new namespace is
+    // published to the lookup snapshots at the same time.
     invariant(coll);
     stdx::lock_guard<Latch> lock(_catalogLock);
 
@@ -208,6 +220,7 @@ void CollectionCatalog::setCollectionNamespace(OperationContext* opCtx,
 
     _collections[toCollection] = _collections[fromCollection];
     _collections.erase(fromCollection);
+    _renameLookupEntry(lock, coll->uuid(), fromCollection, toCollection);
 
     ResourceId oldRid = ResourceId(RESOURCE_COLLECTION, fromCollection.ns());
     ResourceId newRid = ResourceId(RESOURCE_COLLECTION, toCollection.ns());
@@ -221,6 +234,7 @@ void CollectionCatalog::setCollectionNamespace(OperationContext* opCtx,
 
         _collections[fromCollection] = _collections[toCollection];
         _collections.erase(toCollection);
+        _renameLookupEntry(lock, coll->uuid(), toCollection, fromCollection);
 
         ResourceId oldRid = ResourceId(RESOURCE_COLLECTION, fromCollection.ns());
         ResourceId newRid = ResourceId(RESOURCE_COLLECTION, toCollection.ns());
@@ -258,15 +272,19 @@ Collection* CollectionCatalog::lookupCollectionByUUID(OperationContext* opCtx,
         return coll;
     }
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto coll = _lookupCollectionByUUID(lock, uuid);
-    return (coll && coll->isCommitted()) ? coll : nullptr;
+    auto shard = std::atomic_load(&_uuidLookupShards[_lookupShardFor(uuid)]);
+    if (!shard) {
+        return nullptr;
+    }
+    auto it = shard->find(uuid);
+    return (it != shard->end() && it->second.committed) ? it->second.collection : nullptr;
 }
 
 void CollectionCatalog::makeCollectionVisible(CollectionUUID uuid) {
     stdx::lock_guard<Latch> lock(_catalogLock);
     auto coll = _lookupCollectionByUUID(lock, uuid);
     coll->setCommitted(true);
+    _publishLookupEntry(lock, uuid, {coll, uuid, coll->ns(), true});
 }
 
 bool CollectionCatalog::isCollectionAwaitingVisibility(CollectionUUID uuid) const {
@@ -286,10 +304,12 @@ Collection* CollectionCatalog::lookupCollectionByNamespace(OperationContext* opC
         return coll;
     }
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto it = _collections.find(nss);
-    auto coll = (it == _collections.end() ? nullptr : it->second);
-    return (coll && coll->isCommitted()) ? coll : nullptr;
+    auto shard = std::atomic_load(&_nssLookupShards[_lookupShardFor(nss)]);
+    if (!shard) {
+        return nullptr;
+    }
+    auto it = shard->find(nss);
+    return (it != shard->end() && it->second.committed) ? it->second.collection : nullptr;
 }
 
 boost::optional<NamespaceString> CollectionCatalog::lookupNSSByUUID(OperationContext* opCtx,
@@ -298,14 +318,16 @@ boost::optional<NamespaceString> CollectionCatalog::lookupNSSByUUID(OperationCon
         return coll->ns();
     }
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto foundIt = _catalog.find(uuid);
-    if (foundIt != _catalog.end()) {
-        boost::optional<NamespaceString> ns = foundIt->second->ns();
-        invariant(!ns.get().isEmpty());
-        return _collections.find(ns.get())->second->isCommitted() ? ns : boost::none;
+    if (auto shard = std::atomic_load(&_uuidLookupShards[_lookupShardFor(uuid)])) {
+        auto it = shard->find(uuid);
+        if (it != shard->end()) {
+            invariant(!it->second.nss.isEmpty());
+            return it->second.committed ? boost::make_optional(it->second.nss) : boost::none;
+        }
     }
 
+    stdx::lock_guard<Latch> lock(_catalogLock);
+
     // Only in the case that the catalog is closed and a UUID is currently unknown, resolve it
     // using the pre-close state. This ensures that any tasks reloading the catalog can see their
     // own updates.
@@ -323,11 +345,13 @@ boost::optional<CollectionUUID> CollectionCatalog::lookupUUIDByNSS(
         return coll->uuid();
     }
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto it = _collections.find(nss);
-    if (it != _collections.end()) {
-        boost::optional<CollectionUUID> uuid = it->second->uuid();
-        return it->second->isCommitted() ? uuid : boost::none;
+    auto shard = std::atomic_load(&_nssLookupShards[_lookupShardFor(nss)]);
+    if (!shard) {
+        return boost::none;
+    }
+    auto it = shard->find(nss);
+    if (it != shard->end() && it->second.committed) {
+        return it->second.uuid;
     }
     return boost::none;
 }
@@ -475,6 +499,9 @@ void CollectionCatalog::registerCollection(CollectionUUID uuid, std::unique_ptr<
     _catalog[uuid] = std::move(*coll);
     _collections[ns] = _catalog[uuid].get();
     _orderedCollections[dbIdPair] = _catalog[uuid].get();
+    _publishLookupEntry(lock,
+                        uuid,
+                        {_catalog[uuid].get(), uuid, ns, _catalog[uuid]->isCommitted()});
 
     auto dbRid = ResourceId(RESOURCE_DATABASE, dbName);
     addResource(dbRid, dbName);
@@ -502,6 +529,7 @@ std::unique_ptr<Collection> CollectionCatalog::deregisterCollection(CollectionUU
     _orderedCollections.erase(dbIdPair);
     _collections.erase(ns);
     _catalog.erase(uuid);
+    _removeLookupEntry(lock, uuid, ns);
 
     auto collRid = ResourceId(RESOURCE_COLLECTION, ns.ns());
     removeResource(collRid, ns.ns());
@@ -537,6 +565,10 @@ void CollectionCatalog::deregisterAllCollections() {
     _collections.clear();
     _orderedCollections.clear();
     _catalog.clear();
+    for (size_t i = 0; i < kNumLookupShards; ++i) {
+        std::atomic_store(&_uuidLookupShards[i], std::shared_ptr<const UUIDLookupShard>());
+        std::atomic_store(&_nssLookupShards[i], std::shared_ptr<const NamespaceLookupShard>());
+    }
 
     stdx::lock_guard<Latch> resourceLock(_resourceLock);
     _resourceInformation.clear();
@@ -544,6 +576,52 @@ void CollectionCatalog::deregisterAllCollections() {
     _generationNumber++;
 }
 
+size_t CollectionCatalog::_lookupShardFor(const CollectionUUID& uuid) {
+    return CollectionUUID::Hash()(uuid) % kNumLookupShards;
+}
+
+size_t CollectionCatalog::_lookupShardFor(const NamespaceString& nss) {
+    return std::hash<std::string>()(nss.ns()) % kNumLookupShards;
+}
+
+void CollectionCatalog::_publishLookupEntry(WithLock,
+                                            CollectionUUID uuid,
+                                            const LookupEntry& entry) {
+    updateLookupShard(&_uuidLookupShards[_lookupShardFor(uuid)],
+                      [&](UUIDLookupShard& shard) { shard.insert_or_assign(uuid, entry); });
+    updateLookupShard(
+        &_nssLookupShards[_lookupShardFor(entry.nss)],
+        [&](NamespaceLookupShard& shard) { shard.insert_or_assign(entry.nss, entry); });
+}
+
+void CollectionCatalog::_removeLookupEntry(WithLock,
+                                           CollectionUUID uuid,
+                                           const NamespaceString& nss) {
+    updateLookupShard(&_uuidLookupShards[_lookupShardFor(uuid)],
+                      [&](UUIDLookupShard& shard) { shard.erase(uuid); });
+    updateLookupShard(&_nssLookupShards[_lookupShardFor(nss)],
+                      [&](NamespaceLookupShard& shard) { shard.erase(nss); });
+}
+
+void CollectionCatalog::_renameLookupEntry(WithLock lock,
+                                           CollectionUUID uuid,
+                                           const NamespaceString& fromNss,
+                                           const NamespaceString& toNss) {
+    auto uuidShard = std::atomic_load(&_uuidLookupShards[_lookupShardFor(uuid)]);
+    invariant(uuidShard);
+    auto it = uuidShard->find(uuid);
+    invariant(it != uuidShard->end());
+
+    auto entry = it->second;
+    entry.nss = toNss;
+
+    // Publish the new name before retiring the old one, so that a concurrent reader observes the
+    // collection under at least one of its names.
+    _publishLookupEntry(lock, uuid, entry);
+    updateLookupShard(&_nssLookupShards[_lookupShardFor(fromNss)],
+                      [&](NamespaceLookupShard& shard) { shard.erase(fromNss); });
+}
+
 CollectionCatalog::iterator CollectionCatalog::begin(StringData db) const {
     return iterator(db, _generationNumber, *this);
 }
@@ -29,8 +29,10 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <map>
+#include <memory>
 #include <set>
 
 #include "mongo/db/catalog/collection.h"
@@ -314,6 +316,44 @@ private:
                                                            const stdx::lock_guard<Latch>&);
     mutable mongo::Mutex _catalogLock;
 
+    /**
+     * Entry in the lock-free lookup snapshots. Caches the namespace and visibility of the
+     * collection so that readers never dereference a Collection that a concurrent drop may be
+     * about to destroy.
+     */
+    struct LookupEntry {
+        Collection* collection;
+        // Copied out of 'collection' so that readers of an old snapshot never dereference a
+        // Collection which a concurrent drop may be destroying.
+        CollectionUUID uuid;
+        NamespaceString nss;
+        bool committed;
+    };
+
+    using UUIDLookupShard = stdx::unordered_map<CollectionUUID, LookupEntry, CollectionUUID::Hash>;
+    using NamespaceLookupShard = stdx::unordered_map<NamespaceString, LookupEntry>;
+
+    static constexpr size_t kNumLookupShards = 256;
+
+    static size_t _lookupShardFor(const CollectionUUID& uuid);
+    static size_t _lookupShardFor(const NamespaceString& nss);
+
+    void _publishLookupEntry(WithLock, CollectionUUID uuid, const LookupEntry& entry);
+    void _removeLookupEntry(WithLock, CollectionUUID uuid, const NamespaceString& nss);
+    void _renameLookupEntry(WithLock,
+                            CollectionUUID uuid,
+                            const NamespaceString& fromNss,
+                            const NamespaceString& toNss);
+
+    /**
+     * Immutable copies of the UUID and namespace lookup maps, split into shards so that a DDL
+     * operation only copies the one shard it modifies. Writers build a new shard under
+     * '_catalogLock' and publish it with std::atomic_store; the point lookups read it with
+     * std::atomic_load and so never take '_catalogLock'. A null shard is empty.
+     */
+    std::array<std::shared_ptr<const UUIDLookupShard>, kNumLookupShards> _uuidLookupShards;
+    std::array<std::shared_ptr<const NamespaceLookupShard>, kNumLookupShards> _nssLookupShards;
+
     /**
      * When present, indicates that the catalog is in closed state, and contains a map from UUID
      * to pre-close NSS. See also onCloseCatalog.
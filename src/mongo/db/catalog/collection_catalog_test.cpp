@@ -38,6 +38,8 @@
 #include "mongo/db/operation_context_noop.h"
 #include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/db/storage/durable_catalog.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 
@@ -527,6 +529,85 @@ TEST_F(CollectionCatalogTest, RenameCollection) {
     ASSERT_EQUALS(catalog.lookupCollectionByUUID(&opCtx, uuid), collection);
 }
 
+TEST_F(CollectionCatalogTest, LookupsByNamespaceFollowRename) {
+    auto uuid = CollectionUUID::gen();
+    NamespaceString oldNss(nss.db(), "oldcol");
+    std::unique_ptr<Collection> collUnique = std::make_unique<CollectionMock>(oldNss);
+    auto collection = collUnique.get();
+    catalog.registerCollection(uuid, &collUnique);
+
+    NamespaceString newNss(nss.db(), "newcol");
+    catalog.setCollectionNamespace(&opCtx, collection, oldNss, newNss);
+    ASSERT_EQUALS(*catalog.lookupNSSByUUID(&opCtx, uuid), newNss);
+    ASSERT_EQUALS(*catalog.lookupUUIDByNSS(&opCtx, newNss), uuid);
+    ASSERT_EQUALS(catalog.lookupCollectionByNamespace(&opCtx, newNss), collection);
+    ASSERT_EQUALS(catalog.lookupUUIDByNSS(&opCtx, oldNss), boost::none);
+    ASSERT(catalog.lookupCollectionByNamespace(&opCtx, oldNss) == nullptr);
+
+    catalog.deregisterCollection(uuid);
+    ASSERT_EQUALS(catalog.lookupNSSByUUID(&opCtx, uuid), boost::none);
+    ASSERT_EQUALS(catalog.lookupUUIDByNSS(&opCtx, newNss), boost::none);
+    ASSERT(catalog.lookupCollectionByNamespace(&opCtx, newNss) == nullptr);
+}
+
+TEST_F(CollectionCatalogTest, LookupsHideCollectionUntilMadeVisible) {
+    auto uuid = CollectionUUID::gen();
+    NamespaceString newNss(nss.db(), "newcol");
+    std::unique_ptr<Collection> collUnique = std::make_unique<CollectionMock>(newNss);
+    auto collection = collUnique.get();
+    collection->setCommitted(false);
+    catalog.registerCollection(uuid, &collUnique);
+
+    ASSERT(catalog.isCollectionAwaitingVisibility(uuid));
+    ASSERT(catalog.lookupCollectionByUUID(&opCtx, uuid) == nullptr);
+    ASSERT(catalog.lookupCollectionByNamespace(&opCtx, newNss) == nullptr);
+    ASSERT_EQUALS(catalog.lookupNSSByUUID(&opCtx, uuid), boost::none);
+    ASSERT_EQUALS(catalog.lookupUUIDByNSS(&opCtx, newNss), boost::none);
+
+    catalog.makeCollectionVisible(uuid);
+    ASSERT_EQUALS(catalog.lookupCollectionByUUID(&opCtx, uuid), collection);
+    ASSERT_EQUALS(catalog.lookupCollectionByNamespace(&opCtx, newNss), collection);
+    ASSERT_EQUALS(*catalog.lookupNSSByUUID(&opCtx, uuid), newNss);
+    ASSERT_EQUALS(*catalog.lookupUUIDByNSS(&opCtx, newNss), uuid);
+}
+
+TEST_F(CollectionCatalogTest, LookupsAreConsistentDuringConcurrentRegistration) {
+    AtomicWord<bool> done{false};
+    int numLookups = 0;
+    int numInconsistentLookups = 0;
+    stdx::thread reader([&] {
+        OperationContextNoop readerOpCtx;
+        while (!done.load()) {
+            // The collection registered by the fixture is never touched by the writer below.
+            // Failed assertions must be raised on the main thread, so only count them here.
+            const auto nssForUUID = catalog.lookupNSSByUUID(&readerOpCtx, colUUID);
+            const auto uuidForNss = catalog.lookupUUIDByNSS(&readerOpCtx, nss);
+            if (catalog.lookupCollectionByUUID(&readerOpCtx, colUUID) != col ||
+                catalog.lookupCollectionByNamespace(&readerOpCtx, nss) != col || !nssForUUID ||
+                *nssForUUID != nss || !uuidForNss || *uuidForNss != colUUID) {
+                ++numInconsistentLookups;
+            }
+            ++numLookups;
+        }
+    });
+
+    for (int i = 0; i < 1000; ++i) {
+        auto uuid = CollectionUUID::gen();
+        NamespaceString newNss(nss.db(), "coll" + std::to_string(i));
+        std::unique_ptr<Collection> collUnique = std::make_unique<CollectionMock>(newNss);
+        auto collection = collUnique.get();
+        catalog.registerCollection(uuid, &collUnique);
+        ASSERT_EQUALS(catalog.lookupCollectionByNamespace(&opCtx, newNss), collection);
+        catalog.deregisterCollection(uuid);
+        ASSERT(catalog.lookupCollectionByUUID(&opCtx, uuid) == nullptr);
+    }
+
+    done.store(true);
+    reader.join();
+    ASSERT_GT(numLookups, 0);
+    ASSERT_EQUALS(numInconsistentLookups, 0);
+}
+
 TEST_F(CollectionCatalogTest, LookupNSSByUUIDForClosedCatalogReturnsOldNSSIfDropped) {
     catalog.onCloseCatalog(&opCtx);
     catalog.deregisterCollection(colUUID);
@@ -32,10 +32,12 @@
 #include <boost/optional.hpp>
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/ordering.h"
 #include "mongo/bson/timestamp.h"
+#include "mongo/db/field_ref.h"
 #include "mongo/db/index/multikey_paths.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/key_string.h"
@@ -89,6 +91,14 @@ public:
 
     virtual const CollatorInterface* getCollator() const = 0;
 
+    /**
+     * Returns the paths whose values determine this index's keys for a document, including the
+     * paths referenced by its partial filter expression. Two documents with equal values at all of
+     * these paths generate the same keys. Returns nullptr if the keys of this index may depend on
+     * any path, as is the case for text and wildcard indexes.
+     */
+    virtual const std::vector<FieldRef>* getIndexedPaths() const = 0;
+
     /// ---------------------
 
     virtual void setIsReady(const bool newIsReady) = 0;
@@ -42,6 +42,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/index_names.h"
 #include "mongo/db/logical_clock.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_parser.h"
@@ -61,6 +62,34 @@ namespace mongo {
 
 using std::string;
 
+namespace {
+
+/**
+ * Adds the paths referenced by the partial filter expression 'expr' to 'paths'. Only logical
+ * nodes are descended into, since the children of other nodes have paths relative to their
+ * parent's.
+ */
+void addFilterPaths(const MatchExpression* expr, std::vector<FieldRef>* paths) {
+    if (!expr->path().empty()) {
+        paths->emplace_back(expr->path());
+    }
+
+    switch (expr->matchType()) {
+        case MatchExpression::AND:
+        case MatchExpression::OR:
+        case MatchExpression::NOR:
+        case MatchExpression::NOT:
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                addFilterPaths(expr->getChild(i), paths);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+}  // namespace
+
 IndexCatalogEntryImpl::IndexCatalogEntryImpl(OperationContext* const opCtx,
                                              const std::string& ident,
                                              std::unique_ptr<IndexDescriptor> descriptor,
@@ -122,6 +151,17 @@ IndexCatalogEntryImpl::IndexCatalogEntryImpl(OperationContext* const opCtx,
                     "descriptor_indexName"_attr = _descriptor->indexName(),
                     "filter"_attr = redact(filter));
     }
+
+    const auto& accessMethodName = _descriptor->getAccessMethodName();
+    if (accessMethodName != IndexNames::TEXT && accessMethodName != IndexNames::WILDCARD) {
+        _indexedPaths.emplace();
+        for (auto&& elem : _descriptor->keyPattern()) {
+            _indexedPaths->emplace_back(elem.fieldNameStringData());
+        }
+        if (_filterExpression) {
+            addFilterPaths(_filterExpression.get(), &*_indexedPaths);
+        }
+    }
 }
 
 IndexCatalogEntryImpl::~IndexCatalogEntryImpl() {
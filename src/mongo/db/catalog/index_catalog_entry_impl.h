@@ -116,6 +116,10 @@ public:
         return _collator.get();
     }
 
+    const std::vector<FieldRef>* getIndexedPaths() const final {
+        return _indexedPaths.get_ptr();
+    }
+
     /// ---------------------
 
     void setIsReady(bool newIsReady) final;
@@ -230,6 +234,9 @@ private:
     // Special ExpressionContext used to evaluate the partial filter expression.
     boost::intrusive_ptr<ExpressionContext> _expCtxForFilter;
 
+    // The paths which determine this index's keys, or boost::none if they may depend on any path.
+    boost::optional<std::vector<FieldRef>> _indexedPaths;
+
     // cached stuff
 
     Ordering _ordering;  // TODO: this might be b-tree specific
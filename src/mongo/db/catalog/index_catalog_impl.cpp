@@ -33,6 +33,7 @@
 
 #include "mongo/db/catalog/index_catalog_impl.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/base/init.h"
@@ -1443,6 +1444,47 @@ Status IndexCatalogImpl::_indexRecords(OperationContext* opCtx,
     return _indexFilteredRecords(opCtx, index, filteredBsonRecords, keysInsertedOut);
 }
 
+namespace {
+/**
+ * Returns true if 'oldDoc' and 'newDoc' hold the same value at 'path', considering the path
+ * components from 'level' onwards. Differing subdocuments are descended into, so that a change to
+ * a sibling of an indexed field is not mistaken for a change to the field itself. Arrays must be
+ * identical, since any of their elements may be traversed by the remainder of the path.
+ */
+bool sameValueAtPath(const BSONObj& oldDoc,
+                     const BSONObj& newDoc,
+                     const FieldRef& path,
+                     size_t level) {
+    const StringData field = path.getPart(level);
+    const BSONElement oldElem = oldDoc[field];
+    const BSONElement newElem = newDoc[field];
+    if (oldElem.binaryEqualValues(newElem)) {
+        return true;
+    }
+
+    return level + 1 < path.numParts() && oldElem.type() == BSONType::Object &&
+        newElem.type() == BSONType::Object &&
+        sameValueAtPath(oldElem.embeddedObject(), newElem.embeddedObject(), path, level + 1);
+}
+
+/**
+ * Returns true if updating 'oldDoc' to 'newDoc' cannot change the keys of 'index', because the
+ * two documents agree at every path the keys depend on.
+ */
+bool indexKeysUnchanged(const IndexCatalogEntry* index,
+                        const BSONObj& oldDoc,
+                        const BSONObj& newDoc) {
+    const auto* indexedPaths = index->getIndexedPaths();
+    if (!indexedPaths) {
+        return false;
+    }
+
+    return std::all_of(indexedPaths->begin(), indexedPaths->end(), [&](const FieldRef& path) {
+        return sameValueAtPath(oldDoc, newDoc, path, 0);
+    });
+}
+}  // namespace
+
 Status IndexCatalogImpl::_updateRecord(OperationContext* const opCtx,
                                        IndexCatalogEntry* index,
                                        const BSONObj& oldDoc,
@@ -1450,6 +1492,12 @@ Status IndexCatalogImpl::_updateRecord(OperationContext* const opCtx,
                                        const RecordId& recordId,
                                        int64_t* const keysInsertedOut,
                                        int64_t* const keysDeletedOut) {
+    // Most updates only touch a few fields, so skip generating the keys of indexes over other
+    // fields altogether rather than diffing two identical key sets.
+    if (indexKeysUnchanged(index, oldDoc, newDoc)) {
+        return Status::OK();
+    }
+
     IndexAccessMethod* iam = index->accessMethod();
 
     InsertDeleteOptions options;
@@ -40,7 +40,7 @@
 namespace mongo {
 namespace {
 
-const int kMaxPerfThreads = 16;  // max number of threads to use for lock perf
+const int kMaxPerfThreads = 128;  // max number of threads to use for lock perf
 
 
 class DConcurrencyTest : public benchmark::Fixture {
@@ -90,6 +90,34 @@ BENCHMARK_DEFINE_F(DConcurrencyTest, BM_ResourceMutexExclusive)(benchmark::State
     }
 }
 
+BENCHMARK_DEFINE_F(DConcurrencyTest, BM_GlobalIntentSharedLock)(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        makeKClientsWithLockers(state.threads);
+    }
+
+    for (auto keepRunning : state) {
+        Lock::GlobalLock glk(clients[state.thread_index].second.get(), MODE_IS);
+    }
+
+    if (state.thread_index == 0) {
+        clients.clear();
+    }
+}
+
+BENCHMARK_DEFINE_F(DConcurrencyTest, BM_DBIntentExclusiveLock)(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        makeKClientsWithLockers(state.threads);
+    }
+
+    for (auto keepRunning : state) {
+        Lock::DBLock dlk(clients[state.thread_index].second.get(), "test", MODE_IX);
+    }
+
+    if (state.thread_index == 0) {
+        clients.clear();
+    }
+}
+
 BENCHMARK_DEFINE_F(DConcurrencyTest, BM_CollectionIntentSharedLock)(benchmark::State& state) {
     std::unique_ptr<ForceSupportsDocLocking> supportDocLocking;
 
@@ -171,6 +199,9 @@ BENCHMARK_REGISTER_F(DConcurrencyTest, BM_StdMutex)->ThreadRange(1, kMaxPerfThre
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_ResourceMutexShared)->ThreadRange(1, kMaxPerfThreads);
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_ResourceMutexExclusive)->ThreadRange(1, kMaxPerfThreads);
 
+BENCHMARK_REGISTER_F(DConcurrencyTest, BM_GlobalIntentSharedLock)->ThreadRange(1, kMaxPerfThreads);
+BENCHMARK_REGISTER_F(DConcurrencyTest, BM_DBIntentExclusiveLock)->ThreadRange(1, kMaxPerfThreads);
+
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionIntentSharedLock)
     ->ThreadRange(1, kMaxPerfThreads);
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionIntentExclusiveLock)
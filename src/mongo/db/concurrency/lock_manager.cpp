@@ -33,6 +33,7 @@
 
 #include "mongo/db/concurrency/lock_manager.h"
 
+#include <algorithm>
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
@@ -45,6 +46,7 @@
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/str.h"
 #include "mongo/util/timer.h"
@@ -413,9 +415,24 @@ void LockHead::migratePartitionedLockHeads() {
 // Have more buckets than CPUs to reduce contention on lock and caches
 const unsigned LockManager::_numLockBuckets(128);
 
-// Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+namespace {
+
+// Balance scalability of intent locks against potential added cost of conflicting locks. Only the
+// partitions which actually hold requests for a resource need to be visited when a conflicting
+// request migrates them, so it is cheap to have a few more partitions than hardware threads.
+const unsigned kMinPartitions = 32;
+const unsigned kMaxPartitions = 1024;
+
+unsigned computeNumPartitions() {
+    const unsigned target = std::min(2 * stdx::thread::hardware_concurrency(), kMaxPartitions);
+    unsigned numPartitions = kMinPartitions;
+    while (numPartitions < target) {
+        numPartitions *= 2;
+    }
+    return numPartitions;
+}
+
+}  // namespace
 
 // static
 std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serviceContext) {
@@ -443,7 +460,7 @@ std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serv
     return lockToClientMap;
 }
 
-LockManager::LockManager() {
+LockManager::LockManager() : _numPartitions(computeNumPartitions()) {
     _lockBuckets = new LockBucket[_numLockBuckets];
     _partitions = new Partition[_numPartitions];
 }
@@ -839,7 +856,7 @@ LockManager::LockBucket* LockManager::_getBucket(ResourceId resId) const {
 }
 
 LockManager::Partition* LockManager::_getPartition(LockRequest* request) const {
-    return &_partitions[request->locker->getId() % _numPartitions];
+    return &_partitions[request->locker->getId() & (_numPartitions - 1)];
 }
 
 void LockManager::dump() const {
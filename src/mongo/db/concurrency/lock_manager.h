@@ -42,6 +42,7 @@
 #include "mongo/platform/compiler.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/new.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/mutex.h"
 
@@ -157,7 +158,9 @@ private:
 
     // These types describe the locks hash table
 
-    struct LockBucket {
+    // Buckets and partitions are cache line aligned, so that threads working on neighbouring ones
+    // do not invalidate each other's cache lines when taking the mutex.
+    struct alignas(stdx::hardware_destructive_interference_size) LockBucket {
         SimpleMutex mutex;
         typedef stdx::unordered_map<ResourceId, LockHead*> Map;
         Map data;
@@ -167,7 +170,7 @@ private:
     // Each locker maps to a partition that is used for resources acquired in intent modes
     // modes and potentially other modes that don't conflict with themselves. This avoids
     // contention on the regular LockHead in the lock manager.
-    struct Partition {
+    struct alignas(stdx::hardware_destructive_interference_size) Partition {
         PartitionedLockHead* find(ResourceId resId);
         PartitionedLockHead* findOrInsert(ResourceId resId);
         typedef stdx::unordered_map<ResourceId, PartitionedLockHead*> Map;
@@ -219,7 +222,8 @@ private:
     static const unsigned _numLockBuckets;
     LockBucket* _lockBuckets;
 
-    static const unsigned _numPartitions;
+    // Always a power of two, see LockManager::LockManager.
+    const unsigned _numPartitions;
     Partition* _partitions;
 };
 }  // namespace mongo
@@ -317,6 +317,48 @@ TEST(LockManager, Conflict) {
     ASSERT(request2.numNotifies == 1);
 }
 
+TEST(LockManager, ConflictWithIntentLocksFromManyPartitions) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_DATABASE, std::string("TestDB"));
+
+    // Use enough lockers to spread the intent requests over every partition, whatever the number
+    // of partitions chosen for this machine.
+    const int kNumIntentLockers = 2048;
+
+    std::vector<std::unique_ptr<LockerImpl>> lockers;
+    std::vector<std::unique_ptr<LockRequestCombo>> requests;
+    for (int i = 0; i < kNumIntentLockers; i++) {
+        lockers.push_back(std::make_unique<LockerImpl>());
+        requests.push_back(std::make_unique<LockRequestCombo>(lockers.back().get()));
+        ASSERT(LOCK_OK ==
+               lockMgr.lock(resId, requests.back().get(), i % 2 ? MODE_IX : MODE_IS));
+    }
+
+    LockerImpl exclusiveLocker;
+    LockRequestCombo exclusiveRequest(&exclusiveLocker);
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &exclusiveRequest, MODE_X));
+
+    // The exclusive request is only granted once the last intent request is released
+    for (int i = 0; i < kNumIntentLockers; i++) {
+        ASSERT(exclusiveRequest.numNotifies == 0);
+        lockMgr.unlock(requests[i].get());
+    }
+
+    ASSERT(exclusiveRequest.numNotifies == 1);
+    ASSERT(exclusiveRequest.lastResult == LOCK_OK);
+
+    // New intent requests now have to wait behind the exclusive one
+    LockerImpl intentLocker;
+    LockRequestCombo intentRequest(&intentLocker);
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &intentRequest, MODE_IS));
+
+    lockMgr.unlock(&exclusiveRequest);
+    ASSERT(intentRequest.numNotifies == 1);
+    ASSERT(intentRequest.lastResult == LOCK_OK);
+
+    lockMgr.unlock(&intentRequest);
+}
+
 TEST(LockManager, MultipleConflict) {
     LockManager lockMgr;
     const ResourceId resId(RESOURCE_COLLECTION, std::string("TestDB.collection"));
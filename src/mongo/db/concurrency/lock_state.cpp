@@ -87,16 +87,37 @@ public:
         _get(id).recordWaitTime(resId, mode, waitMicros);
     }
 
+    /**
+     * Records the total time a single lock request spent waiting, unlike recordWaitTime, which
+     * may be called several times for the same request.
+     */
+    void recordCompletedWait(LockerId id, ResourceId resId, LockMode mode, uint64_t waitMicros) {
+        _partitions[id % NumPartitions].waitTimeHistograms.recordWait(resId, mode, waitMicros);
+        _contendedResources.recordWait(resId, waitMicros);
+    }
+
     void report(SingleThreadedLockStats* outStats) const {
         for (int i = 0; i < NumPartitions; i++) {
             outStats->append(_partitions[i].stats);
         }
     }
 
+    void report(SingleThreadedLockWaitTimeHistograms* outHistograms) const {
+        for (int i = 0; i < NumPartitions; i++) {
+            outHistograms->append(_partitions[i].waitTimeHistograms);
+        }
+    }
+
+    std::vector<ContendedResourceSketch::Entry> getTopContendedResources(size_t n) const {
+        return _contendedResources.getTopEntries(n);
+    }
+
     void reset() {
         for (int i = 0; i < NumPartitions; i++) {
             _partitions[i].stats.reset();
+            _partitions[i].waitTimeHistograms.reset();
         }
+        _contendedResources.reset();
     }
 
 private:
@@ -104,6 +125,7 @@ private:
     // separate page/cache line in order to avoid false sharing.
     struct alignas(stdx::hardware_destructive_interference_size) AlignedLockStats {
         AtomicLockStats stats;
+        AtomicLockWaitTimeHistograms waitTimeHistograms;
     };
 
     enum { NumPartitions = 8 };
@@ -115,6 +137,8 @@ private:
 
 
     AlignedLockStats _partitions[NumPartitions];
+
+    ContendedResourceSketch _contendedResources;
 };
 
 
@@ -959,26 +983,38 @@ void LockerImpl::_lockComplete(OperationContext* opCtx,
     const uint64_t startOfTotalWaitTime = curTimeMicros64();
     uint64_t startOfCurrentWaitTime = startOfTotalWaitTime;
 
+    // Account for the whole wait whether the lock is granted, times out or is interrupted. The
+    // guard around each wait below keeps 'startOfCurrentWaitTime' current even if it throws.
+    ON_BLOCK_EXIT([&] {
+        globalStats.recordCompletedWait(
+            _id, resId, mode, startOfCurrentWaitTime - startOfTotalWaitTime);
+    });
+
     while (true) {
         // It is OK if this call wakes up spuriously, because we re-evaluate the remaining
         // wait time anyways.
         // If we have an operation context, we want to use its interruptible wait so that
         // pending lock acquisitions can be cancelled, so long as no callers have requested an
         // uninterruptible lock.
-        if (opCtx && _uninterruptibleLocksRequested == 0) {
-            result = _notify.wait(opCtx, waitTime);
-        } else {
-            result = _notify.wait(waitTime);
+        {
+            // Account for the time spent waiting on the notification object, including when the
+            // wait is interrupted.
+            ON_BLOCK_EXIT([&] {
+                const uint64_t curTimeMicros = curTimeMicros64();
+                const uint64_t elapsedTimeMicros = curTimeMicros - startOfCurrentWaitTime;
+                startOfCurrentWaitTime = curTimeMicros;
+
+                globalStats.recordWaitTime(_id, resId, mode, elapsedTimeMicros);
+                _stats.recordWaitTime(resId, mode, elapsedTimeMicros);
+            });
+
+            if (opCtx && _uninterruptibleLocksRequested == 0) {
+                result = _notify.wait(opCtx, waitTime);
+            } else {
+                result = _notify.wait(waitTime);
+            }
         }
 
-        // Account for the time spent waiting on the notification object
-        const uint64_t curTimeMicros = curTimeMicros64();
-        const uint64_t elapsedTimeMicros = curTimeMicros - startOfCurrentWaitTime;
-        startOfCurrentWaitTime = curTimeMicros;
-
-        globalStats.recordWaitTime(_id, resId, mode, elapsedTimeMicros);
-        _stats.recordWaitTime(resId, mode, elapsedTimeMicros);
-
         if (result == LOCK_OK)
             break;
 
@@ -988,7 +1024,7 @@ void LockerImpl::_lockComplete(OperationContext* opCtx,
         }
 
         const auto totalBlockTime = duration_cast<Milliseconds>(
-            Microseconds(int64_t(curTimeMicros - startOfTotalWaitTime)));
+            Microseconds(int64_t(startOfCurrentWaitTime - startOfTotalWaitTime)));
         waitTime = (totalBlockTime < timeout) ? std::min(timeout - totalBlockTime, MaxWaitTime)
                                               : Milliseconds(0);
 
@@ -1117,6 +1153,14 @@ void reportGlobalLockingStats(SingleThreadedLockStats* outStats) {
     globalStats.report(outStats);
 }
 
+void reportGlobalLockWaitTimeHistograms(SingleThreadedLockWaitTimeHistograms* outHistograms) {
+    globalStats.report(outHistograms);
+}
+
+std::vector<ContendedResourceSketch::Entry> getGlobalTopContendedResources(size_t n) {
+    return globalStats.getTopContendedResources(n);
+}
+
 void resetGlobalLockStats() {
     globalStats.reset();
 }
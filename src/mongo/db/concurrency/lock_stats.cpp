@@ -31,9 +31,19 @@
 
 #include "mongo/db/concurrency/lock_stats.h"
 
+#include <algorithm>
+
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/bits.h"
+#include "mongo/platform/random.h"
 
 namespace mongo {
+namespace {
+
+// Picks the waits recorded by ContendedResourceSketch.
+thread_local PseudoRandom threadPrng{SecureRandom().nextInt64()};
+
+}  // namespace
 
 template <typename CounterType>
 LockStats<CounterType>::LockStats() {
@@ -135,4 +145,123 @@ void LockStats<CounterType>::reset() {
 template class LockStats<int64_t>;
 template class LockStats<AtomicWord<long long>>;
 
+
+template <typename CounterType>
+LockWaitTimeHistograms<CounterType>::LockWaitTimeHistograms() {
+    reset();
+}
+
+template <typename CounterType>
+int LockWaitTimeHistograms<CounterType>::bucketFor(int64_t waitMicros) {
+    if (waitMicros < 2) {
+        return 0;
+    }
+
+    const int log2 = 63 - countLeadingZeros64(static_cast<unsigned long long>(waitMicros));
+    return std::min(log2, kNumBuckets - 1);
+}
+
+template <typename CounterType>
+void LockWaitTimeHistograms<CounterType>::report(BSONObjBuilder* builder) const {
+    // As in LockStats, skip resource type and mode 0, which are sentinels for no lock.
+    for (int row = 1; row < kNumRows; row++) {
+        const char* rowName = row == ResourceTypesCount
+            ? "oplog"
+            : resourceTypeName(static_cast<ResourceType>(row));
+
+        BSONObjBuilder section(builder->subobjStart(rowName));
+        for (int mode = 1; mode < LockModesCount; mode++) {
+            BSONObjBuilder modeSection(
+                section.subobjStart(legacyModeName(static_cast<LockMode>(mode))));
+            for (int bucket = 0; bucket < kNumBuckets; bucket++) {
+                // Name each bucket after the lower bound of the wait times it counts.
+                const long long lowerBoundMicros = bucket == 0 ? 0 : 1LL << bucket;
+                modeSection.append(std::to_string(lowerBoundMicros),
+                                   static_cast<long long>(
+                                       CounterOps::get(_buckets[row][mode][bucket])));
+            }
+        }
+    }
+}
+
+template <typename CounterType>
+void LockWaitTimeHistograms<CounterType>::reset() {
+    for (int row = 0; row < kNumRows; row++) {
+        for (int mode = 0; mode < LockModesCount; mode++) {
+            for (int bucket = 0; bucket < kNumBuckets; bucket++) {
+                CounterOps::set(_buckets[row][mode][bucket], 0);
+            }
+        }
+    }
+}
+
+template class LockWaitTimeHistograms<int64_t>;
+template class LockWaitTimeHistograms<AtomicWord<long long>>;
+
+
+void ContendedResourceSketch::recordWait(ResourceId resId, int64_t waitMicros) {
+    const ResourceType type = resId.getType();
+    if (type != RESOURCE_DATABASE && type != RESOURCE_COLLECTION) {
+        return;
+    }
+
+    if (_samplingInterval > 1 &&
+        threadPrng.nextInt64(static_cast<int64_t>(_samplingInterval)) != 0) {
+        return;
+    }
+
+    const auto weight = static_cast<int64_t>(_samplingInterval);
+    _record(resId, weight, waitMicros * weight);
+}
+
+void ContendedResourceSketch::_record(ResourceId resId, int64_t waitCount, int64_t waitMicros) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    const auto end = _entries.begin() + _numEntries;
+    auto it = std::find_if(
+        _entries.begin(), end, [&](const Entry& entry) { return entry.resId == resId; });
+    if (it != end) {
+        it->waitCount += waitCount;
+        it->waitTimeMicros += waitMicros;
+        return;
+    }
+
+    if (_numEntries < kCapacity) {
+        _entries[_numEntries++] = {resId, waitCount, waitMicros, 0};
+        return;
+    }
+
+    // All slots are taken, so evict the resource with the least wait time. The newcomer inherits
+    // its wait time, which bounds how much the newcomer's estimate may exceed its true value.
+    auto minIt = std::min_element(_entries.begin(), end, [](const Entry& a, const Entry& b) {
+        return a.waitTimeMicros < b.waitTimeMicros;
+    });
+    *minIt = {resId,
+              minIt->waitCount + waitCount,
+              minIt->waitTimeMicros + waitMicros,
+              minIt->waitTimeMicros};
+}
+
+std::vector<ContendedResourceSketch::Entry> ContendedResourceSketch::getTopEntries(
+    size_t n) const {
+    std::vector<Entry> entries;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        entries.assign(_entries.begin(), _entries.begin() + _numEntries);
+    }
+
+    n = std::min(n, entries.size());
+    std::partial_sort(
+        entries.begin(), entries.begin() + n, entries.end(), [](const Entry& a, const Entry& b) {
+            return a.waitTimeMicros > b.waitTimeMicros;
+        });
+    entries.resize(n);
+    return entries;
+}
+
+void ContendedResourceSketch::reset() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _numEntries = 0;
+}
+
 }  // namespace mongo
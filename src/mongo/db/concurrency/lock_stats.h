@@ -29,8 +29,12 @@
 
 #pragma once
 
+#include <array>
+#include <vector>
+
 #include "mongo/db/concurrency/lock_manager_defs.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
 
 namespace mongo {
 
@@ -216,13 +220,136 @@ typedef LockStats<int64_t> SingleThreadedLockStats;
 typedef LockStats<AtomicWord<long long>> AtomicLockStats;
 
 
+/**
+ * Log-scale histograms of the time individual lock requests spent waiting before being granted
+ * (or timing out), kept per resource type and mode, with the oplog split out as in LockStats.
+ * Bucket 0 counts waits shorter than 2 microseconds and bucket i > 0 counts waits in the range
+ * [2^i, 2^(i+1)) microseconds, with the last bucket also counting everything longer.
+ *
+ * The counters live in fixed arrays, so recording a wait never allocates.
+ */
+template <typename CounterType>
+class LockWaitTimeHistograms {
+public:
+    static constexpr int kNumBuckets = 24;
+
+    LockWaitTimeHistograms();
+
+    static int bucketFor(int64_t waitMicros);
+
+    void recordWait(ResourceId resId, LockMode mode, int64_t waitMicros) {
+        CounterOps::add(_buckets[_row(resId)][mode][bucketFor(waitMicros)], 1);
+    }
+
+    int64_t getCount(ResourceId resId, LockMode mode, int bucket) const {
+        return CounterOps::get(_buckets[_row(resId)][mode][bucket]);
+    }
+
+    template <typename OtherType>
+    void append(const LockWaitTimeHistograms<OtherType>& other) {
+        for (int row = 0; row < kNumRows; row++) {
+            for (int mode = 0; mode < LockModesCount; mode++) {
+                for (int bucket = 0; bucket < kNumBuckets; bucket++) {
+                    CounterOps::add(_buckets[row][mode][bucket],
+                                    other._buckets[row][mode][bucket]);
+                }
+            }
+        }
+    }
+
+    /**
+     * Reports every bucket of every resource type and mode, including empty ones, so that the
+     * report always has the same shape and can be collected by FTDC.
+     */
+    void report(BSONObjBuilder* builder) const;
+    void reset();
+
+private:
+    template <typename T>
+    friend class LockWaitTimeHistograms;
+
+    // One row per resource type, plus a last row for the oplog.
+    static constexpr int kNumRows = ResourceTypesCount + 1;
+
+    static int _row(ResourceId resId) {
+        return resId == resourceIdOplog ? ResourceTypesCount : resId.getType();
+    }
+
+    CounterType _buckets[kNumRows][LockModesCount][kNumBuckets];
+};
+
+typedef LockWaitTimeHistograms<int64_t> SingleThreadedLockWaitTimeHistograms;
+typedef LockWaitTimeHistograms<AtomicWord<long long>> AtomicLockWaitTimeHistograms;
+
+
+/**
+ * Approximates the database and collection resources with the most lock wait time, using the
+ * Space-Saving algorithm over a fixed number of slots. Each wait is recorded with probability
+ * 1/samplingInterval, weighted accordingly, so that the mutex protecting the slots stays off the
+ * path of most waiters. Waits are picked at random rather than by a counter, which could keep
+ * missing a resource whose waits recur with the same period. The reported wait times are
+ * estimates which may overcount a resource by at most its 'errorMicros'.
+ */
+class ContendedResourceSketch {
+    ContendedResourceSketch(const ContendedResourceSketch&) = delete;
+    ContendedResourceSketch& operator=(const ContendedResourceSketch&) = delete;
+
+public:
+    static constexpr size_t kCapacity = 64;
+    static constexpr uint64_t kSamplingInterval = 4;
+
+    struct Entry {
+        ResourceId resId;
+        int64_t waitCount = 0;
+        int64_t waitTimeMicros = 0;
+        int64_t errorMicros = 0;
+    };
+
+    explicit ContendedResourceSketch(uint64_t samplingInterval = kSamplingInterval)
+        : _samplingInterval(samplingInterval) {}
+
+    /**
+     * Only waits on RESOURCE_DATABASE and RESOURCE_COLLECTION resources are tracked; others are
+     * ignored.
+     */
+    void recordWait(ResourceId resId, int64_t waitMicros);
+
+    /**
+     * Returns up to 'n' entries ordered by descending estimated wait time.
+     */
+    std::vector<Entry> getTopEntries(size_t n) const;
+
+    void reset();
+
+private:
+    void _record(ResourceId resId, int64_t waitCount, int64_t waitMicros);
+
+    const uint64_t _samplingInterval;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ContendedResourceSketch::_mutex");
+    std::array<Entry, kCapacity> _entries;
+    size_t _numEntries = 0;
+};
+
+
 /**
  * Reports instance-wide locking statistics, which can then be converted to BSON or logged.
  */
 void reportGlobalLockingStats(SingleThreadedLockStats* outStats);
 
 /**
- * Currently used for testing only.
+ * Reports instance-wide lock wait time histograms.
+ */
+void reportGlobalLockWaitTimeHistograms(SingleThreadedLockWaitTimeHistograms* outHistograms);
+
+/**
+ * Returns up to 'n' of the database and collection resources with the most sampled wait time
+ * across all Locker instances.
+ */
+std::vector<ContendedResourceSketch::Entry> getGlobalTopContendedResources(size_t n);
+
+/**
+ * Currently used for testing only. Also resets the wait time histograms and contended resources.
  */
 void resetGlobalLockStats();
 
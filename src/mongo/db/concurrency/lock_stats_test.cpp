@@ -32,7 +32,9 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/lock_manager_test_help.h"
 #include "mongo/db/service_context_test_fixture.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -91,6 +93,194 @@ TEST_F(LockStatsTest, Wait) {
     ASSERT_GREATER_THAN(stats.get(resId, MODE_S).combinedWaitTimeMicros, 0);
 }
 
+TEST_F(LockStatsTest, WaitTimeHistogram) {
+    const ResourceId resId(RESOURCE_COLLECTION, std::string("LockStats.WaitTimeHistogram"));
+
+    resetGlobalLockStats();
+
+    LockerForTests locker(MODE_IX);
+    locker.lock(resId, MODE_X);
+
+    auto opCtx = makeOperationContext();
+
+    {
+        LockerForTests lockerConflict(MODE_IX);
+        ASSERT_EQUALS(LOCK_WAITING, lockerConflict.lockBeginForTest(opCtx.get(), resId, MODE_S));
+        ASSERT_THROWS_CODE(lockerConflict.lockCompleteForTest(
+                               opCtx.get(), resId, MODE_S, Date_t::now() + Milliseconds(5)),
+                           AssertionException,
+                           ErrorCodes::LockTimeout);
+    }
+
+    SingleThreadedLockWaitTimeHistograms histograms;
+    reportGlobalLockWaitTimeHistograms(&histograms);
+
+    // The timed out request is counted exactly once, however many times it woke up.
+    int64_t numWaits = 0;
+    int64_t numWaitsOfAtLeast4ms = 0;
+    for (int bucket = 0; bucket < SingleThreadedLockWaitTimeHistograms::kNumBuckets; bucket++) {
+        numWaits += histograms.getCount(resId, MODE_S, bucket);
+        if (bucket >= 12) {
+            numWaitsOfAtLeast4ms += histograms.getCount(resId, MODE_S, bucket);
+        }
+        ASSERT_EQUALS(0, histograms.getCount(resId, MODE_X, bucket));
+    }
+    ASSERT_EQUALS(1, numWaits);
+    ASSERT_EQUALS(1, numWaitsOfAtLeast4ms);
+
+    BSONObjBuilder builder;
+    histograms.report(&builder);
+    auto report = builder.done();
+    // Empty buckets are reported too, so that the report always has the same shape.
+    for (auto mode : {MODE_S, MODE_X}) {
+        auto modeReport = report.getObjectField("Collection").getObjectField(legacyModeName(mode));
+        ASSERT_EQUALS(SingleThreadedLockWaitTimeHistograms::kNumBuckets, modeReport.nFields());
+
+        int numNonEmptyBuckets = 0;
+        for (auto&& bucket : modeReport) {
+            numNonEmptyBuckets += bucket.numberLong() > 0;
+        }
+        ASSERT_EQUALS(mode == MODE_S ? 1 : 0, numNonEmptyBuckets);
+    }
+    auto globalReport = report.getObjectField("Global").getObjectField(legacyModeName(MODE_IS));
+    ASSERT_EQUALS(SingleThreadedLockWaitTimeHistograms::kNumBuckets, globalReport.nFields());
+}
+
+TEST_F(LockStatsTest, WaitTimeHistogramCountsInterruptedWait) {
+    const ResourceId resId(RESOURCE_COLLECTION, std::string("LockStats.InterruptedWait"));
+
+    resetGlobalLockStats();
+
+    LockerForTests locker(MODE_IX);
+    locker.lock(resId, MODE_X);
+
+    auto opCtx = makeOperationContext();
+
+    {
+        LockerForTests lockerConflict(MODE_IX);
+        ASSERT_EQUALS(LOCK_WAITING, lockerConflict.lockBeginForTest(opCtx.get(), resId, MODE_S));
+
+        stdx::thread killer([&] {
+            sleepmillis(10);
+            stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+            opCtx->markKilled();
+        });
+        ASSERT_THROWS_CODE(
+            lockerConflict.lockCompleteForTest(opCtx.get(), resId, MODE_S, Date_t::max()),
+            AssertionException,
+            ErrorCodes::Interrupted);
+        killer.join();
+    }
+
+    // The time spent in the interrupted wait is accounted for.
+    SingleThreadedLockStats stats;
+    reportGlobalLockingStats(&stats);
+    ASSERT_GREATER_THAN_OR_EQUALS(stats.get(resId, MODE_S).combinedWaitTimeMicros, 4096);
+
+    SingleThreadedLockWaitTimeHistograms histograms;
+    reportGlobalLockWaitTimeHistograms(&histograms);
+    int64_t numWaits = 0;
+    for (int bucket = 0; bucket < SingleThreadedLockWaitTimeHistograms::kNumBuckets; bucket++) {
+        if (bucket < 12) {
+            ASSERT_EQUALS(0, histograms.getCount(resId, MODE_S, bucket));
+        }
+        numWaits += histograms.getCount(resId, MODE_S, bucket);
+    }
+    ASSERT_EQUALS(1, numWaits);
+}
+
+TEST(LockWaitTimeHistogramsTest, BucketBoundaries) {
+    using Histograms = SingleThreadedLockWaitTimeHistograms;
+    ASSERT_EQUALS(0, Histograms::bucketFor(0));
+    ASSERT_EQUALS(0, Histograms::bucketFor(1));
+    ASSERT_EQUALS(1, Histograms::bucketFor(2));
+    ASSERT_EQUALS(1, Histograms::bucketFor(3));
+    ASSERT_EQUALS(2, Histograms::bucketFor(4));
+    ASSERT_EQUALS(9, Histograms::bucketFor(1023));
+    ASSERT_EQUALS(10, Histograms::bucketFor(1024));
+    ASSERT_EQUALS(Histograms::kNumBuckets - 1, Histograms::bucketFor(1LL << 40));
+}
+
+TEST(ContendedResourceSketchTest, ReportsMostWaitedOnResourcesFirst) {
+    // Record every wait so that the estimates are exact.
+    ContendedResourceSketch sketch(1);
+    const ResourceId hot(RESOURCE_COLLECTION, std::string("sketch.hot"));
+    const ResourceId warm(RESOURCE_DATABASE, std::string("sketch"));
+    const ResourceId cold(RESOURCE_COLLECTION, std::string("sketch.cold"));
+
+    for (int i = 0; i < 100; i++) {
+        sketch.recordWait(hot, 1000);
+    }
+    for (int i = 0; i < 10; i++) {
+        sketch.recordWait(warm, 1000);
+        sketch.recordWait(cold, 10);
+    }
+
+    // Waits on other resource types are not tracked.
+    for (int i = 0; i < 1000; i++) {
+        sketch.recordWait(resourceIdGlobal, 1000);
+    }
+
+    auto top = sketch.getTopEntries(3);
+    ASSERT_EQUALS(3U, top.size());
+    ASSERT_EQUALS(hot, top[0].resId);
+    ASSERT_EQUALS(warm, top[1].resId);
+    ASSERT_EQUALS(cold, top[2].resId);
+    ASSERT_EQUALS(100 * 1000, top[0].waitTimeMicros);
+    ASSERT_EQUALS(0, top[0].errorMicros);
+    ASSERT_EQUALS(10 * 10, top[2].waitTimeMicros);
+
+    sketch.reset();
+    ASSERT(sketch.getTopEntries(2).empty());
+}
+
+TEST(ContendedResourceSketchTest, EvictsLeastWaitedOnResourceWhenFull) {
+    ContendedResourceSketch sketch(1);
+
+    for (size_t i = 0; i <= ContendedResourceSketch::kCapacity; i++) {
+        const ResourceId resId(RESOURCE_COLLECTION, "sketch.coll" + std::to_string(i));
+        sketch.recordWait(resId, 1000 + i);
+    }
+
+    auto top = sketch.getTopEntries(ContendedResourceSketch::kCapacity + 1);
+    ASSERT_EQUALS(ContendedResourceSketch::kCapacity, top.size());
+
+    // The last resource took over the slot of the first, the least waited on, and inherited its
+    // wait time as the error bound.
+    const ResourceId last(RESOURCE_COLLECTION,
+                          "sketch.coll" + std::to_string(ContendedResourceSketch::kCapacity));
+    ASSERT_EQUALS(last, top[0].resId);
+    ASSERT_EQUALS(1000, top[0].errorMicros);
+}
+
+TEST(ContendedResourceSketchTest, SamplingDoesNotAliasWithPeriodicWaits) {
+    ContendedResourceSketch sketch;
+    const ResourceId periodic(RESOURCE_COLLECTION, std::string("sketch.periodic"));
+    const ResourceId other(RESOURCE_COLLECTION, std::string("sketch.other"));
+
+    // One wait on 'periodic' in every kSamplingInterval waits. A counter taking every
+    // kSamplingInterval-th wait would sample either all of them or none.
+    const int numRounds = 4000;
+    const auto interval = static_cast<int>(ContendedResourceSketch::kSamplingInterval);
+    for (int i = 0; i < numRounds; i++) {
+        sketch.recordWait(periodic, 1);
+        for (int j = 1; j < interval; j++) {
+            sketch.recordWait(other, 1);
+        }
+    }
+
+    // Each estimate is the number of waits plus or minus a few percent, so these bounds are many
+    // standard deviations wide.
+    auto top = sketch.getTopEntries(2);
+    ASSERT_EQUALS(2U, top.size());
+    ASSERT_EQUALS(other, top[0].resId);
+    ASSERT_EQUALS(periodic, top[1].resId);
+    ASSERT_GT(top[1].waitCount, numRounds / 2);
+    ASSERT_LT(top[1].waitCount, numRounds * 3 / 2);
+    ASSERT_GT(top[0].waitCount, numRounds * (interval - 1) / 2);
+    ASSERT_LT(top[0].waitCount, numRounds * (interval - 1) * 3 / 2);
+}
+
 TEST_F(LockStatsTest, Reporting) {
     const ResourceId resId(RESOURCE_COLLECTION, std::string("LockStats.Reporting"));
 
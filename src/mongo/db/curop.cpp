@@ -46,6 +46,7 @@
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/db/json.h"
+#include "mongo/db/operation_buffer_pool.h"
 #include "mongo/db/prepare_conflict_tracker.h"
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/query/getmore_request.h"
@@ -849,6 +850,10 @@ string OpDebug::report(OperationContext* opCtx, const SingleThreadedLockStats* l
         s << " flowControl:" << flowControlObj.toString();
     }
 
+    if (auto bufferPoolPeakBytes = OperationBufferPool::get(opCtx).peakBytes()) {
+        s << " bufferPoolPeakBytes:" << bufferPoolPeakBytes;
+    }
+
     {
         const auto& readConcern = repl::ReadConcernArgs::get(opCtx);
         if (readConcern.isSpecified()) {
@@ -1017,6 +1022,10 @@ void OpDebug::report(OperationContext* opCtx,
         pAttrs->add("flowControl", flowControlObj);
     }
 
+    if (auto bufferPoolPeakBytes = OperationBufferPool::get(opCtx).peakBytes()) {
+        pAttrs->add("bufferPoolPeakBytes", static_cast<long long>(bufferPoolPeakBytes));
+    }
+
     {
         const auto& readConcern = repl::ReadConcernArgs::get(opCtx);
         if (readConcern.isSpecified()) {
@@ -1131,6 +1140,10 @@ void OpDebug::append(OperationContext* opCtx,
         flowControlBuilder.appendElements(flowControlMetrics);
     }
 
+    if (auto bufferPoolPeakBytes = OperationBufferPool::get(opCtx).peakBytes()) {
+        b.appendNumber("bufferPoolPeakBytes", static_cast<long long>(bufferPoolPeakBytes));
+    }
+
     {
         const auto& readConcern = repl::ReadConcernArgs::get(opCtx);
         if (readConcern.isSpecified()) {
@@ -1390,6 +1403,12 @@ std::function<BSONObj(ProfileFilter::Args)> OpDebug::appendStaged(StringSet requ
         flowControlBuilder.appendElements(flowControlMetrics);
     });
 
+    addIfNeeded("bufferPoolPeakBytes", [](auto field, auto args, auto& b) {
+        if (auto bufferPoolPeakBytes = OperationBufferPool::get(args.opCtx).peakBytes()) {
+            b.appendNumber(field, static_cast<long long>(bufferPoolPeakBytes));
+        }
+    });
+
     addIfNeeded("writeConcern", [](auto field, auto args, auto& b) {
         if (args.op.writeConcern && !args.op.writeConcern->usedDefault) {
             b.append(field, args.op.writeConcern->toBSON());
@@ -37,6 +37,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/resume_token.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -44,6 +45,119 @@ using boost::intrusive_ptr;
 using std::string;
 using std::vector;
 
+DocumentShapeRegistry::DocumentShapeRegistry(size_t maxShapes)
+    : _maxShapes(maxShapes), _empty(new DocumentShape(this)) {}
+
+DocumentShapeRegistry::~DocumentShapeRegistry() {
+    delete _empty;
+}
+
+DocumentShapeRegistry& DocumentShapeRegistry::get() {
+    // Shapes may be needed by Documents constructed during static initialization.
+    static auto& registry = *new DocumentShapeRegistry();
+    return registry;
+}
+
+DocumentShape::DocumentShape(DocumentShapeRegistry* registry) : _registry(registry) {}
+
+DocumentShape::DocumentShape(const DocumentShape* parent, StringData name)
+    : _registry(parent->_registry),
+      _parent(parent),
+      _name(name.toString()),
+      _position(parent->_nextPosition),
+      _nextPosition(static_cast<unsigned>(
+          ValueElement::align(parent->_nextPosition + sizeof(ValueElement) + name.size()))),
+      _numFields(parent->_numFields + 1) {}
+
+DocumentShape::~DocumentShape() {
+    for (auto&& slot : _transitions) {
+        delete slot.load();
+    }
+    delete _fieldTable.load();
+}
+
+const DocumentShape* DocumentShape::empty() {
+    return DocumentShapeRegistry::get().empty();
+}
+
+size_t DocumentShape::numShapes() {
+    return DocumentShapeRegistry::get().numShapes();
+}
+
+const DocumentShape* DocumentShape::transition(StringData name) const {
+    if (_numFields >= kMaxFields) {
+        return nullptr;
+    }
+
+    for (auto&& slot : _transitions) {
+        auto next = slot.load();
+        if (!next) {
+            break;
+        }
+        if (StringData(next->_name) == name) {
+            return next;
+        }
+    }
+
+    // Slots are never cleared and the shape count never decreases, so a shape whose slots are
+    // all taken, or a registry which is full, can be given up on without serializing with every
+    // other thread that misses.
+    if (_transitions.back().load()) {
+        return nullptr;
+    }
+    auto& registry = *_registry;
+    if (registry._numShapes.load() >= registry._maxShapes) {
+        return nullptr;
+    }
+
+    stdx::lock_guard<Latch> lk(registry._mutex);
+    // Another thread may have added the transition since we looked.
+    for (auto&& slot : _transitions) {
+        auto next = slot.load();
+        if (next && StringData(next->_name) == name) {
+            return next;
+        }
+        if (!next) {
+            if (registry._numShapes.load() >= registry._maxShapes) {
+                return nullptr;
+            }
+            next = new DocumentShape(this, name);
+            registry._numShapes.fetchAndAdd(1);
+            slot.store(next);
+            return next;
+        }
+    }
+
+    // Too many distinct layouts branch off here to be worth sharing.
+    return nullptr;
+}
+
+Position DocumentShape::findField(StringData name) const {
+    const auto& table = fieldTable();
+    auto it = table.find(name);
+    return it == table.end() ? Position() : it->second;
+}
+
+const DocumentShape::FieldTable& DocumentShape::fieldTable() const {
+    if (auto table = _fieldTable.load()) {
+        return *table;
+    }
+
+    auto table = std::make_unique<FieldTable>();
+    table->reserve(_numFields);
+    // Walk from the last field to the first so that, like the per-document hash table, the first
+    // of several fields with the same name is the one found.
+    for (auto shape = this; shape->_parent; shape = shape->_parent) {
+        (*table)[shape->_name] = Position(shape->_position);
+    }
+
+    FieldTable* expected = nullptr;
+    if (_fieldTable.compareAndSwap(&expected, table.get())) {
+        return *table.release();
+    }
+    return *expected;
+}
+
 const DocumentStorage DocumentStorage::kEmptyDoc;
 
 const StringDataSet Document::allMetadataFieldNames{Document::metaFieldTextScore,
@@ -130,7 +244,9 @@ bool DocumentStorageIterator::shouldSkipDeleted() {
 Position DocumentStorage::findFieldInCache(StringData requested) const {
     int reqSize = requested.size();  // get size calculation out of the way if needed
 
-    if (_numFields >= HASH_TAB_MIN) {  // hash lookup
+    if (_shape && _numFields >= HASH_TAB_MIN) {  // shared shape lookup
+        return _shape->findField(requested);
+    } else if (_numFields >= HASH_TAB_MIN) {  // hash lookup
         const unsigned hash = hashKey(requested);
         const unsigned bucket = hash & _hashTabMask;
 
@@ -217,11 +333,25 @@ Value& DocumentStorage::appendField(StringData name, ValueElement::Kind kind) {
 
     _numFields++;
 
-    if (_numFields > HASH_TAB_MIN) {
+    if (_numFields == HASH_TAB_MIN) {
+        // Smaller documents are scanned linearly, so they only start following shapes now.
+        _shape = DocumentShape::empty();
+        for (auto it = iteratorCacheOnly(); _shape && !it.atEnd(); it.advance()) {
+            _shape = _shape->transition(it->nameSD());
+        }
+        if (!_shape) {
+            // adds all fields to hash table (including the one we just added)
+            rehash();
+        }
+    } else if (_shape) {
+        dassert(_shape->getNextPosition() == pos);
+        _shape = _shape->transition(name);
+        if (!_shape) {
+            // Left the shape tree, so from now on this document maintains its own hash table.
+            rehash();
+        }
+    } else if (_numFields > HASH_TAB_MIN) {
         addFieldToHashTable(pos);
-    } else if (_numFields == HASH_TAB_MIN) {
-        // adds all fields to hash table (including the one we just added)
-        rehash();
     }
 
     return getField(pos).val;
@@ -266,7 +396,7 @@ void DocumentStorage::alloc(unsigned newSize) {
         // This just copies the elements
         memcpy(_cache, oldBuf.get(), _usedBytes);
 
-        if (_numFields >= HASH_TAB_MIN) {
+        if (!_shape && _numFields >= HASH_TAB_MIN) {
             // if we were hashing, deal with the hash table
             if (doingRehash) {
                 rehash();
@@ -310,6 +440,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
         out->_hashTabMask = _hashTabMask;
         out->_usedBytes = _usedBytes;
         out->_numFields = _numFields;
+        out->_shape = _shape;
 
         dassert(out->allocatedBytes() == bufferBytes);
 
@@ -357,6 +488,7 @@ void DocumentStorage::reset(const BSONObj& bson, bool stripMetadata) {
     _usedBytes = 0;
     _numFields = 0;
     _hashTabMask = 0;
+    _shape = nullptr;
 
     // Clean metadata.
     _metadataFields = DocumentMetadataFields{};
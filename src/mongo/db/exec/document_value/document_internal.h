@@ -31,14 +31,18 @@
 
 #include <third_party/murmurhash3/MurmurHash3.h>
 
+#include <array>
 #include <bitset>
 #include <boost/intrusive_ptr.hpp>
 
 #include "mongo/base/static_assert.h"
 #include "mongo/db/exec/document_value/document_metadata_fields.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/stdx/variant.h"
 #include "mongo/util/intrusive_counter.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 /** Helper class to make the position in a document abstract
@@ -70,6 +74,7 @@ public:
 private:
     explicit Position(size_t i) : index(i) {}
     unsigned index;
+    friend class DocumentShape;
     friend class DocumentStorage;
     friend class DocumentStorageIterator;
     friend class DocumentStorageCacheIterator;
@@ -143,6 +148,124 @@ private:
 MONGO_STATIC_ASSERT(sizeof(ValueElement) ==
                     (sizeof(Value) + sizeof(Position) + sizeof(int) + sizeof(char) + 1));
 
+/**
+ * A shape describes the layout of a DocumentStorage cache: the ordered sequence of field names
+ * appended to it. Since the position of a field in the cache depends only on the names appended
+ * before it, every document with the same shape has each field at the same position, so a single
+ * name-to-position table can be shared by all of them instead of each document hashing its own
+ * field names.
+ *
+ * Shapes form a transition tree rooted at the empty shape and owned by a DocumentShapeRegistry.
+ * Documents only start following shapes once they have HASH_TAB_MIN fields, since smaller ones
+ * are scanned linearly. To bound their memory a document stops following shapes (and builds its
+ * own hash table) when it has too many fields, when its current shape already has too many
+ * distinct successors, or when its registry's limit on the number of shapes has been reached.
+ *
+ * Internal class. Consumers shouldn't care about this.
+ */
+class DocumentShapeRegistry;
+
+class DocumentShape {
+    DocumentShape(const DocumentShape&) = delete;
+    DocumentShape& operator=(const DocumentShape&) = delete;
+
+public:
+    static constexpr size_t kMaxFields = 64;
+    static constexpr size_t kMaxTransitions = 8;
+    static constexpr size_t kMaxShapes = 4096;
+
+    /// The shape of a document with no fields in its cache, in the process-wide registry.
+    static const DocumentShape* empty();
+
+    /// Returns the number of shapes in the process-wide registry, including the empty shape.
+    static size_t numShapes();
+
+    /**
+     * Returns the shape obtained by appending a field named 'name' to this shape or nullptr if
+     * one of the limits described above has been reached. Thread safe.
+     */
+    const DocumentShape* transition(StringData name) const;
+
+    /**
+     * Returns the position of the first field named 'name' in documents of this shape or
+     * Position() if there is none. Thread safe.
+     */
+    Position findField(StringData name) const;
+
+    size_t numFields() const {
+        return _numFields;
+    }
+
+    /// Returns the position the next appended field will have.
+    Position getNextPosition() const {
+        return Position(_nextPosition);
+    }
+
+private:
+    friend class DocumentShapeRegistry;
+
+    using FieldTable = StringMap<Position>;
+
+    explicit DocumentShape(DocumentShapeRegistry* registry);
+    DocumentShape(const DocumentShape* parent, StringData name);
+
+    /// Destroys the shapes which transition from this one.
+    ~DocumentShape();
+
+    const FieldTable& fieldTable() const;
+
+    DocumentShapeRegistry* const _registry;
+    const DocumentShape* _parent = nullptr;
+    const std::string _name;
+    const unsigned _position = 0;
+    const unsigned _nextPosition = 0;
+    const size_t _numFields = 0;
+
+    // Append-only; a slot is published once and never changes afterwards.
+    mutable std::array<AtomicWord<DocumentShape*>, kMaxTransitions> _transitions{};
+
+    // Built on the first lookup since most intermediate shapes are never searched.
+    mutable AtomicWord<FieldTable*> _fieldTable{nullptr};
+};
+
+/**
+ * Owns a tree of shapes and limits how many it may hold. Documents follow the shapes of the
+ * process-wide registry, which is never destroyed. Tests can create their own registries to reach
+ * the limits without affecting any other document.
+ */
+class DocumentShapeRegistry {
+    DocumentShapeRegistry(const DocumentShapeRegistry&) = delete;
+    DocumentShapeRegistry& operator=(const DocumentShapeRegistry&) = delete;
+
+public:
+    explicit DocumentShapeRegistry(size_t maxShapes = DocumentShape::kMaxShapes);
+
+    /// Destroys every shape of this registry. No document may still follow any of them.
+    ~DocumentShapeRegistry();
+
+    static DocumentShapeRegistry& get();
+
+    const DocumentShape* empty() const {
+        return _empty;
+    }
+
+    /// Returns the number of shapes created so far, including the empty shape.
+    size_t numShapes() const {
+        return _numShapes.load();
+    }
+
+private:
+    friend class DocumentShape;
+
+    const size_t _maxShapes;
+
+    // Serializes the creation of shapes. Following an existing transition never takes it.
+    Mutex _mutex = MONGO_MAKE_LATCH("DocumentShapeRegistry::_mutex");
+    AtomicWord<size_t> _numShapes{1};
+
+    DocumentShape* const _empty;
+};
+
 class DocumentStorage;
 
 /**
@@ -507,6 +630,15 @@ public:
         return _bson;
     }
 
+    /**
+     * Returns the shape shared by documents whose cache holds the same sequence of fields, or
+     * nullptr if this document has fewer than HASH_TAB_MIN fields or has left the shape tree and
+     * uses its own hash table.
+     */
+    const DocumentShape* shape() const {
+        return _shape;
+    }
+
 private:
     /// Returns the position of the named field in the cache or Position()
     Position findFieldInCache(StringData name) const;
@@ -578,6 +710,11 @@ private:
     unsigned _numFields;    // this includes removed fields
     unsigned _hashTabMask;  // equal to hashTabBuckets()-1 but used more often
 
+    // While non-null, the fields in _cache are exactly those of the shape, in order, and lookups
+    // go through the shape's shared table; the hash table in _cache is left unpopulated. Set once
+    // the document reaches HASH_TAB_MIN fields.
+    const DocumentShape* _shape = nullptr;
+
     BSONObj _bson;
 
     // This field determines the number of bytes from `_bson` that is put into the cache.
@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/document_value/document.h"
+
+namespace mongo {
+namespace {
+
+constexpr int kNumDocs = 1000;
+
+/**
+ * Builds 'kNumDocs' BSON documents which all have the same 'numFields' fields, as a collection
+ * scan feeding an aggregation pipeline typically would.
+ */
+std::vector<BSONObj> buildSameShapeDocuments(int numFields) {
+    std::vector<BSONObj> docs;
+    docs.reserve(kNumDocs);
+    for (int i = 0; i < kNumDocs; ++i) {
+        BSONObjBuilder bob;
+        bob.append("_id", i);
+        for (int j = 1; j < numFields; ++j) {
+            bob.append(str::stream() << "field" << j, i * j);
+        }
+        docs.push_back(bob.obj());
+    }
+    return docs;
+}
+
+/**
+ * Mimics {$addFields: {sum: {$add: ['$field1', '$field2']}, prod: ...}} followed by reading the
+ * computed fields, which faults the referenced fields into the cache and appends new ones.
+ */
+void BM_addFields(benchmark::State& state) {
+    const auto numFields = static_cast<int>(state.range(0));
+    const auto docs = buildSameShapeDocuments(numFields);
+    const auto last = std::string(str::stream() << "field" << (numFields - 1));
+    for (auto _ : state) {
+        for (auto&& bson : docs) {
+            MutableDocument md{Document{bson}};
+            const auto a = md.peek()["field1"].getInt();
+            const auto b = md.peek()[last].getInt();
+            md.addField("sum", Value(a + b));
+            md.addField("prod", Value(a * b));
+            md.addField("tag", Value("x"_sd));
+            auto doc = md.freeze();
+            benchmark::DoNotOptimize(doc["sum"]);
+            benchmark::DoNotOptimize(doc["field1"]);
+            benchmark::DoNotOptimize(doc[last]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kNumDocs);
+}
+
+/**
+ * Mimics an inclusion $project of every other field followed by a second stage looking each of
+ * them up by name.
+ */
+void BM_project(benchmark::State& state) {
+    const auto numFields = static_cast<int>(state.range(0));
+    const auto docs = buildSameShapeDocuments(numFields);
+    std::vector<std::string> projected;
+    for (int j = 0; j < numFields; j += 2) {
+        projected.push_back(j == 0 ? std::string("_id") : str::stream() << "field" << j);
+    }
+    for (auto _ : state) {
+        for (auto&& bson : docs) {
+            const Document input{bson};
+            MutableDocument md(projected.size());
+            for (auto&& name : projected) {
+                md.addField(name, input[name]);
+            }
+            auto doc = md.freeze();
+            for (auto&& name : projected) {
+                benchmark::DoNotOptimize(doc[name]);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kNumDocs);
+}
+
+BENCHMARK(BM_addFields)->RangeMultiplier(2)->Range(8, 64);
+BENCHMARK(BM_project)->RangeMultiplier(2)->Range(8, 64);
+
+}  // namespace
+}  // namespace mongo
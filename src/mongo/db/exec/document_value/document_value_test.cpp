@@ -30,6 +30,7 @@
 #define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
 
 #include <math.h>
+#include <deque>
 #include <sstream>
 
 #include "mongo/platform/basic.h"
@@ -406,6 +407,160 @@ TEST(DocumentCache, DocumentmemUsageForSorterShouldNotCountAllMemory) {
     ASSERT(150 * totalUpdatedSortedSize < totalApproxSize);
 }
 
+TEST(DocumentShape, DocumentsWithTheSameFieldsShareAShape) {
+    DocumentStorage first;
+    DocumentStorage second;
+    for (auto&& name : {"a", "bb", "ccc", "dddd", "e", "f"}) {
+        first.appendField(name, ValueElement::Kind::kInserted) = Value(1);
+        second.appendField(name, ValueElement::Kind::kInserted) = Value(2);
+    }
+
+    ASSERT(first.shape());
+    ASSERT_EQ(first.shape(), second.shape());
+    ASSERT_EQ(6U, first.shape()->numFields());
+    ASSERT_EQ(first.findField("dddd", DocumentStorage::LookupPolicy::kCacheOnly),
+              second.findField("dddd", DocumentStorage::LookupPolicy::kCacheOnly));
+    ASSERT_VALUE_EQ(Value(1), first.getField("ccc"));
+    ASSERT_VALUE_EQ(Value(2), second.getField("ccc"));
+    ASSERT_VALUE_EQ(Value(), second.getField("g"));
+
+    // A clone keeps the shape of the original.
+    ASSERT_EQ(first.shape(), first.clone()->shape());
+
+    // The same fields in a different order make a different shape.
+    DocumentStorage reordered;
+    for (auto&& name : {"bb", "a", "ccc", "dddd", "e", "f"}) {
+        reordered.appendField(name, ValueElement::Kind::kInserted) = Value(3);
+    }
+    ASSERT(reordered.shape());
+    ASSERT_NE(first.shape(), reordered.shape());
+    ASSERT_VALUE_EQ(Value(3), reordered.getField("a"));
+}
+
+TEST(DocumentShape, FirstOfDuplicateFieldNamesIsFound) {
+    DocumentStorage storage;
+    for (int i = 0; i < 6; ++i) {
+        storage.appendField("dup", ValueElement::Kind::kInserted) = Value(i);
+    }
+    ASSERT(storage.shape());
+    ASSERT_VALUE_EQ(Value(0), storage.getField("dup"));
+}
+
+TEST(DocumentShape, DocumentWithTooManyFieldsLeavesShapeAndKeepsItsFields) {
+    DocumentStorage storage;
+    const int numFields = DocumentShape::kMaxFields + 10;
+    for (int i = 0; i < numFields; ++i) {
+        storage.appendField("field" + std::to_string(i), ValueElement::Kind::kInserted) = Value(i);
+    }
+
+    ASSERT_FALSE(storage.shape());
+    for (int i = 0; i < numFields; ++i) {
+        ASSERT_VALUE_EQ(Value(i), storage.getField("field" + std::to_string(i)));
+    }
+    ASSERT_EQ(static_cast<size_t>(numFields), storage.computeSize());
+}
+
+TEST(DocumentShape, DocumentLeavesShapeWhenTooManyLayoutsBranchOff) {
+    // Use a leading field no other test appends so that the transitions below are all new.
+    const StringData prefix = "branchingShapeTestPrefix";
+    std::vector<boost::intrusive_ptr<DocumentStorage>> storages;
+    for (size_t i = 0; i <= DocumentShape::kMaxTransitions; ++i) {
+        auto storage = make_intrusive<DocumentStorage>();
+        storage->appendField(prefix, ValueElement::Kind::kInserted) = Value(0);
+        for (int j = 0; j < 4; ++j) {
+            storage->appendField(str::stream() << "branch" << i << "_" << j,
+                                 ValueElement::Kind::kInserted) = Value(j);
+        }
+        storages.push_back(storage);
+    }
+
+    for (size_t i = 0; i < DocumentShape::kMaxTransitions; ++i) {
+        ASSERT(storages[i]->shape());
+    }
+    ASSERT_FALSE(storages.back()->shape());
+    for (size_t i = 0; i < storages.size(); ++i) {
+        ASSERT_VALUE_EQ(Value(0), storages[i]->getField(prefix));
+        ASSERT_VALUE_EQ(Value(3), storages[i]->getField(str::stream() << "branch" << i << "_3"));
+    }
+}
+
+TEST(DocumentShape, MutableDocumentFollowsTheShapeOfItsFields) {
+    auto makeDoc = [](int i) {
+        MutableDocument md;
+        for (auto&& name : {"_id", "x", "y", "z", "w"}) {
+            md.addField(name, Value(i));
+        }
+        md.setField("x", Value(-i));
+        return md.freeze();
+    };
+    const Document first = makeDoc(1);
+    const Document second = makeDoc(2);
+
+    ASSERT_VALUE_EQ(Value(-1), first["x"]);
+    ASSERT_VALUE_EQ(Value(-2), second["x"]);
+    ASSERT_VALUE_EQ(Value(2), second["w"]);
+    ASSERT_EQ(first.positionOf("w"), second.positionOf("w"));
+    assertRoundTrips(first);
+}
+
+TEST(DocumentShape, SmallDocumentsDoNotFollowShapes) {
+    const size_t numShapesBefore = DocumentShape::numShapes();
+    DocumentStorage storage;
+    for (auto&& name : {"smallShapeTestA", "smallShapeTestB", "smallShapeTestC"}) {
+        storage.appendField(name, ValueElement::Kind::kInserted) = Value(1);
+    }
+    ASSERT_FALSE(storage.shape());
+    ASSERT_EQ(numShapesBefore, DocumentShape::numShapes());
+    ASSERT_VALUE_EQ(Value(1), storage.getField("smallShapeTestB"));
+
+    // The shape of all of its fields is looked up once the document is large enough.
+    storage.appendField("smallShapeTestD", ValueElement::Kind::kInserted) = Value(2);
+    ASSERT(storage.shape());
+    ASSERT_EQ(4U, storage.shape()->numFields());
+    ASSERT_EQ(numShapesBefore + 4, DocumentShape::numShapes());
+    ASSERT_VALUE_EQ(Value(1), storage.getField("smallShapeTestB"));
+    ASSERT_VALUE_EQ(Value(2), storage.getField("smallShapeTestD"));
+}
+
+TEST(DocumentShape, TransitionFailsOnceSlotsOrShapeLimitAreExhausted) {
+    // A registry of its own, so that reaching its limit leaves the process-wide one untouched.
+    const size_t kMaxShapes = 100;
+    DocumentShapeRegistry registry(kMaxShapes);
+    const DocumentShape* base = registry.empty()->transition("base");
+    ASSERT(base);
+
+    auto childName = [](size_t i) { return std::string(str::stream() << "child" << i); };
+    std::deque<const DocumentShape*> frontier{base};
+    std::vector<const DocumentShape*> baseChildren;
+    while (registry.numShapes() < kMaxShapes) {
+        auto shape = frontier.front();
+        frontier.pop_front();
+        for (size_t i = 0; i < DocumentShape::kMaxTransitions; ++i) {
+            auto child = shape->transition(childName(i));
+            if (!child) {
+                break;
+            }
+            if (shape == base) {
+                baseChildren.push_back(child);
+            }
+            frontier.push_back(child);
+        }
+    }
+    ASSERT_EQ(kMaxShapes, registry.numShapes());
+    ASSERT_EQ(DocumentShape::kMaxTransitions, baseChildren.size());
+
+    // Every transition slot of 'base' is taken.
+    ASSERT_FALSE(base->transition("unseen"));
+    // The newest shapes still have free slots, but no more shapes can be created.
+    ASSERT_FALSE(frontier.back()->transition("unseen"));
+    ASSERT_EQ(kMaxShapes, registry.numShapes());
+
+    // Existing transitions are still followed.
+    for (size_t i = 0; i < baseChildren.size(); ++i) {
+        ASSERT_EQ(baseChildren[i], base->transition(childName(i)));
+    }
+}
+
 /** Add Document fields. */
 class AddField {
 public:
@@ -51,6 +51,10 @@ public:
         return _obj;
     }
 
+    const BSONObj* getBSONObj() const final {
+        return _wsm->hasObj() ? &_obj : nullptr;
+    }
+
     ElementIterator* allocateIterator(const ElementPath* path) const final {
         // BSONElementIterator does some interesting things with arrays that I don't think
         // SimpleArrayElementIterator does.
@@ -794,6 +794,15 @@ struct TextOrStats : public SpecificStats {
     }
 
     size_t fetches;
+
+    // The number of best-scoring documents a top-K text search returns, or zero if it returns
+    // every matching document.
+    size_t topK = 0;
+
+    // Whether a top-K text search stopped before reading every posting of its terms, and the
+    // highest score an unread document could have had at that point.
+    bool topKTerminatedEarly = false;
+    double topKScoreBound = 0.0;
 };
 
 struct TrialStats : public SpecificStats {
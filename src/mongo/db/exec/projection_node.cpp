@@ -197,10 +197,13 @@ void ProjectionNode::applyExpressions(const Document& root, MutableDocument* out
         } else {
             auto expressionIt = _expressions.find(field);
             invariant(expressionIt != _expressions.end());
-            outputDoc->setField(
-                field,
-                expressionIt->second->evaluate(
-                    root, &expressionIt->second->getExpressionContext()->variables));
+            auto& variables = expressionIt->second->getExpressionContext()->variables;
+            if (auto compiledIt = _compiledExpressions.find(field);
+                compiledIt != _compiledExpressions.end()) {
+                outputDoc->setField(field, compiledIt->second->evaluate(root, &variables));
+            } else {
+                outputDoc->setField(field, expressionIt->second->evaluate(root, &variables));
+            }
         }
     }
 }
@@ -259,8 +262,12 @@ void ProjectionNode::reportComputedPaths(std::set<std::string>* computedPaths,
 }
 
 void ProjectionNode::optimize() {
+    _compiledExpressions.clear();
     for (auto&& expressionIt : _expressions) {
         _expressions[expressionIt.first] = expressionIt.second->optimize();
+        if (auto compiled = CompiledExpression::compile(_expressions[expressionIt.first])) {
+            _compiledExpressions[expressionIt.first] = std::move(compiled);
+        }
     }
     for (auto&& childPair : _children) {
         childPair.second->optimize();
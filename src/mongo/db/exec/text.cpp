@@ -126,6 +126,18 @@ unique_ptr<PlanStage> TextStage::buildTextTree(OperationContext* opCtx,
 
         textScorer->addChildren(std::move(indexScanList));
 
+        // The TEXT_MATCH stage only rejects documents when the query has phrases, negations or
+        // is case or diacritic sensitive. Otherwise every document scored by the TEXT_OR stage is
+        // returned, so it may keep just the best 'topK' of them.
+        const auto& query = _params.query;
+        if (_params.topK > 0 && query.getNegatedTerms().empty() &&
+            query.getPositivePhr().empty() && query.getNegatedPhr().empty() &&
+            !query.getCaseSensitive() && !query.getDiacriticSensitive()) {
+            textScorer->setTopK(_params.topK,
+                                std::vector<std::string>(query.getTermsForBounds().begin(),
+                                                         query.getTermsForBounds().end()));
+        }
+
         textMatchStage = std::make_unique<TextMatchStage>(
             expCtx(), std::move(textScorer), _params.query, _params.spec, ws);
     } else {
@@ -64,6 +64,9 @@ struct TextStageParams {
     // True if we need the text score in the output, because the projection includes the 'textScore'
     // metadata field.
     bool wantTextScore = true;
+
+    // If non-zero, only the 'topK' documents with the highest text scores are needed.
+    size_t topK = 0;
 };
 
 /**
@@ -29,6 +29,7 @@
 
 #include "mongo/db/exec/text_or.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <vector>
@@ -74,6 +75,16 @@ void TextOrStage::addChildren(Children childrenToAdd) {
                      std::make_move_iterator(childrenToAdd.end()));
 }
 
+void TextOrStage::setTopK(size_t topK, std::vector<std::string> terms) {
+    invariant(topK > 0);
+    invariant(terms.size() == _children.size());
+    _topK = topK;
+    _terms = std::move(terms);
+    _termBounds.assign(_children.size(), fts::MAX_WEIGHT);
+    _childExhausted.assign(_children.size(), false);
+    _specificStats.topK = topK;
+}
+
 bool TextOrStage::isEOF() {
     return _internalState == State::kDone;
 }
@@ -182,8 +193,33 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     }
 
     if (PlanStage::ADVANCED == childState) {
-        return addTerm(id, out);
+        const auto state = addTerm(id, out);
+        if (_topK && state != PlanStage::NEED_YIELD) {
+            if (topKComplete()) {
+                _specificStats.topKTerminatedEarly = true;
+                finishReadingTerms();
+            } else {
+                advanceTopKChild();
+            }
+        }
+        return state;
     } else if (PlanStage::IS_EOF == childState) {
+        if (_topK) {
+            _termBounds[_currentChild] = 0;
+            _childExhausted[_currentChild] = true;
+            if (std::all_of(_childExhausted.begin(), _childExhausted.end(), [](bool exhausted) {
+                    return exhausted;
+                })) {
+                finishReadingTerms();
+            } else if (topKComplete()) {
+                _specificStats.topKTerminatedEarly = true;
+                finishReadingTerms();
+            } else {
+                advanceTopKChild();
+            }
+            return PlanStage::NEED_TIME;
+        }
+
         // Done with this child.
         ++_currentChild;
 
@@ -193,9 +229,7 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
         }
 
         // If we're here we are done reading results.  Move to the next state.
-        _scoreIterator = _scores.begin();
-        _internalState = State::kReturningResults;
-
+        finishReadingTerms();
         return PlanStage::NEED_TIME;
     } else if (PlanStage::FAILURE == childState) {
         // If a stage fails, it may create a status WSM to indicate why it
@@ -217,7 +251,53 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     }
 }
 
+void TextOrStage::advanceTopKChild() {
+    do {
+        _currentChild = (_currentChild + 1) % _children.size();
+    } while (_childExhausted[_currentChild]);
+}
+
+double TextOrStage::topKScoreBound() const {
+    // Sum in the same order as the scores of the documents are summed, so that an unread document
+    // scoring exactly the bound cannot round above it.
+    double bound = 0;
+    for (auto termBound : _termBounds) {
+        bound += termBound;
+    }
+    return bound;
+}
+
+bool TextOrStage::topKComplete() const {
+    return _topKHeap.size() == _topK && _topKHeap.front().score >= topKScoreBound();
+}
+
+void TextOrStage::finishReadingTerms() {
+    if (_topK) {
+        _specificStats.topKScoreBound = topKScoreBound();
+
+        // Sorting a min-heap by its own comparator leaves it in descending order.
+        std::sort_heap(_topKHeap.begin(), _topKHeap.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.score > rhs.score;
+        });
+    }
+
+    _scoreIterator = _scores.begin();
+    _internalState = State::kReturningResults;
+}
+
 PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
+    if (_topK) {
+        if (_topKPosition == _topKHeap.size()) {
+            _internalState = State::kDone;
+            return PlanStage::IS_EOF;
+        }
+
+        const TopKEntry& entry = _topKHeap[_topKPosition++];
+        _ws->get(entry.wsid)->metadata().setTextScore(entry.score);
+        *out = entry.wsid;
+        return PlanStage::ADVANCED;
+    }
+
     if (_scoreIterator == _scores.end()) {
         _internalState = State::kDone;
         return PlanStage::IS_EOF;
@@ -246,7 +326,25 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
     invariant(wsm->getState() == WorkingSetMember::RID_AND_IDX);
     invariant(1 == wsm->keyData.size());
     const IndexKeyDatum newKeyData = wsm->keyData.back();  // copy to keep it around.
-    TextRecordData* textRecordData = &_scores[wsm->recordId];
+
+    // Locate score within possibly compound key: {prefix,term,score,suffix}.
+    BSONObjIterator keyIt(newKeyData.keyData);
+    for (unsigned i = 0; i < _ftsSpec.numExtraBefore(); i++) {
+        keyIt.next();
+    }
+
+    keyIt.next();  // Skip past 'term'.
+
+    BSONElement scoreElement = keyIt.next();
+    double documentTermScore = scoreElement.number();
+
+    if (_topK) {
+        // The child scans by descending score, so none of its unread postings scores higher.
+        _termBounds[_currentChild] = documentTermScore;
+    }
+
+    const RecordId recordId = wsm->recordId;
+    TextRecordData* textRecordData = &_scores[recordId];
 
     if (textRecordData->score < 0) {
         // We have already rejected this document for not matching the filter.
@@ -285,6 +383,15 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
 
         // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
         wsm->makeObjOwnedIfNeeded();
+
+        if (_topK) {
+            addTopKCandidate(recordId);
+            return NEED_TIME;
+        }
+    } else if (_topK) {
+        // The document was scored in full when we first saw it.
+        _ws->free(wsid);
+        return NEED_TIME;
     } else {
         // We already have a working set member for this RecordId. Free the new WSM and retrieve the
         // old one. Note that since we don't keep all index keys, we could get a score that doesn't
@@ -295,20 +402,52 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         wsm = _ws->get(textRecordData->wsid);
     }
 
-    // Locate score within possibly compound key: {prefix,term,score,suffix}.
-    BSONObjIterator keyIt(newKeyData.keyData);
-    for (unsigned i = 0; i < _ftsSpec.numExtraBefore(); i++) {
-        keyIt.next();
+    // Aggregate relevance score, term keys.
+    textRecordData->score += documentTermScore;
+    return NEED_TIME;
+}
+
+void TextOrStage::addTopKCandidate(const RecordId& recordId) {
+    TextRecordData* textRecordData = &_scores[recordId];
+    WorkingSetMember* wsm = _ws->get(textRecordData->wsid);
+
+    // Score the document for every term of the query rather than waiting for the postings of
+    // the other terms, summing in the same order as the postings would have been.
+    fts::TermFrequencyMap termFrequencies;
+    _ftsSpec.scoreDocument(wsm->doc.value().toBson(), &termFrequencies);
+    double score = 0;
+    for (const auto& term : _terms) {
+        auto it = termFrequencies.find(term);
+        if (it != termFrequencies.end()) {
+            score += it->second;
+        }
     }
 
-    keyIt.next();  // Skip past 'term'.
+    const auto minHeapComparator = [](const TopKEntry& lhs, const TopKEntry& rhs) {
+        return lhs.score > rhs.score;
+    };
 
-    BSONElement scoreElement = keyIt.next();
-    double documentTermScore = scoreElement.number();
+    if (_topKHeap.size() == _topK) {
+        TopKEntry& worst = _topKHeap.front();
+        if (score <= worst.score) {
+            _ws->free(textRecordData->wsid);
+            textRecordData->wsid = WorkingSet::INVALID_ID;
+            textRecordData->score = -1;
+            return;
+        }
 
-    // Aggregate relevance score, term keys.
-    textRecordData->score += documentTermScore;
-    return NEED_TIME;
+        TextRecordData* evicted = &_scores[worst.recordId];
+        _ws->free(evicted->wsid);
+        evicted->wsid = WorkingSet::INVALID_ID;
+        evicted->score = -1;
+
+        std::pop_heap(_topKHeap.begin(), _topKHeap.end(), minHeapComparator);
+        _topKHeap.pop_back();
+    }
+
+    textRecordData->score = score;
+    _topKHeap.push_back({score, recordId, textRecordData->wsid});
+    std::push_heap(_topKHeap.begin(), _topKHeap.end(), minHeapComparator);
 }
 
 }  // namespace mongo
@@ -30,6 +30,8 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/fts/fts_spec.h"
@@ -77,6 +79,17 @@ public:
 
     void addChildren(Children childrenToAdd);
 
+    /**
+     * Restricts the output to the 'topK' documents with the highest scores. Each child must scan
+     * the postings of the corresponding entry of 'terms' in order of descending score.
+     *
+     * The children are then read in turn rather than one after another, and every newly seen
+     * document is scored in full from its fetched contents. Reading stops as soon as the 'topK'
+     * best documents found so far score at least as high as the sum of the scores of the last
+     * posting read from each child, since no unread document can do better.
+     */
+    void setTopK(size_t topK, std::vector<std::string> terms);
+
     bool isEOF() final;
 
     StageState doWork(WorkingSetID* out) final;
@@ -118,6 +131,26 @@ private:
      */
     StageState addTerm(WorkingSetID wsid, WorkingSetID* out);
 
+    /**
+     * Helper called from addTerm in top-K mode to score the newly fetched document for
+     * 'recordId' and either keep it among the best documents found so far or discard it.
+     */
+    void addTopKCandidate(const RecordId& recordId);
+
+    /**
+     * Helpers for top-K mode. Moves on to the next child which is not exhausted, returns the
+     * highest score an unread document could have, and returns whether no unread posting can
+     * change the best documents found so far.
+     */
+    void advanceTopKChild();
+    double topKScoreBound() const;
+    bool topKComplete() const;
+
+    /**
+     * Moves to kReturningResults once all the postings needed have been read.
+     */
+    void finishReadingTerms();
+
     /**
      * Worker for kReturningResults. Returns a wsm with RecordID and Score.
      */
@@ -150,6 +183,30 @@ private:
     ScoreMap _scores;
     ScoreMap::const_iterator _scoreIterator;
 
+    // If non-zero, only the '_topK' best-scoring documents are returned. In that mode '_scores'
+    // holds a negative score for every document which was seen but is not among the best, and
+    // the full score of the others, which are also in '_topKHeap'.
+    size_t _topK = 0;
+
+    // The term scanned by each child.
+    std::vector<std::string> _terms;
+
+    // The score of the last posting read from each child, which bounds the score of its unread
+    // postings. Zero once the child is exhausted.
+    std::vector<double> _termBounds;
+    std::vector<bool> _childExhausted;
+
+    struct TopKEntry {
+        double score;
+        RecordId recordId;
+        WorkingSetID wsid;
+    };
+
+    // A min-heap on score of the best documents found so far. Sorted by descending score when
+    // returning results, with '_topKPosition' the index of the next one to return.
+    std::vector<TopKEntry> _topKHeap;
+    size_t _topKPosition = 0;
+
     TextOrStats _specificStats;
 
     // Members needed only for using the TextMatchableDocument.
@@ -39,6 +39,7 @@
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bson_comparator_interface_base.h"
 #include "mongo/bson/mutable/algorithm.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
@@ -73,6 +74,12 @@ namespace {
 const char idFieldName[] = "_id";
 const FieldRef idFieldRef(idFieldName);
 
+// Counts the updates written as damages found by mutable BSON and as full document rewrites.
+Counter64 updateInPlaceCounter;
+ServerStatusMetricField<Counter64> displayUpdateInPlace("update.inPlace", &updateInPlaceCounter);
+Counter64 updateRewriteCounter;
+ServerStatusMetricField<Counter64> displayUpdateRewrite("update.rewrite", &updateRewriteCounter);
+
 void addObjectIDIdField(mb::Document* doc) {
     const auto idElem = doc->makeElementNewOID(idFieldName);
     uassert(17268, "Could not create new ObjectId '_id' field.", idElem.ok());
@@ -285,6 +292,7 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                 wunit.commit();
 
                 newObj = uassertStatusOK(std::move(newRecStatus)).releaseToBson();
+                updateInPlaceCounter.increment();
             }
 
             newRecordId = recordId;
@@ -316,6 +324,7 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                                                            &args);
                 invariant(oldObj.snapshotId() == opCtx()->recoveryUnit()->getSnapshotId());
                 wunit.commit();
+                updateRewriteCounter.increment();
             }
         }
 
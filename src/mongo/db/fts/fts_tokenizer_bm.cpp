@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/fts/fts_language.h"
+#include "mongo/db/fts/fts_unicode_tokenizer.h"
+
+namespace mongo {
+namespace fts {
+namespace {
+
+constexpr auto kEnglishText =
+    "The quick brown fox jumps over the lazy dog while the other foxes were running through "
+    "the fields, looking for something to eat before the winter arrived in the valley. ";
+
+constexpr auto kFrenchText =
+    "Le cœur déçu mais l'âme plutôt naïve, Louÿs rêva de crapaüter en canoë au delà des îles, "
+    "près du mälström où brûlent les novæ. Ça fait déjà une année qu'il répète ces phrases. ";
+
+/**
+ * Tokenizes 'numRepeats' copies of 'text' in 'language' with a single UnicodeFTSTokenizer, as
+ * index key generation does for each indexed string of a document.
+ */
+void runTokenizer(benchmark::State& state, const char* language, StringData text) {
+    std::string document;
+    for (int i = 0; i < state.range(0); ++i) {
+        document.append(text.rawData(), text.size());
+    }
+
+    UnicodeFTSTokenizer tokenizer(&FTSLanguage::make(language, TEXT_INDEX_VERSION_3));
+    size_t numTokens = 0;
+    for (auto _ : state) {
+        tokenizer.reset(document.c_str(), FTSTokenizer::kNone);
+        while (tokenizer.moveNext()) {
+            benchmark::DoNotOptimize(tokenizer.get());
+            ++numTokens;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * document.size());
+    state.counters["tokens"] = benchmark::Counter(numTokens, benchmark::Counter::kIsRate);
+}
+
+void BM_TokenizeAsciiEnglish(benchmark::State& state) {
+    runTokenizer(state, "english", kEnglishText);
+}
+
+void BM_TokenizeLatinFrench(benchmark::State& state) {
+    runTokenizer(state, "french", kFrenchText);
+}
+
+void BM_TokenizeAsciiNone(benchmark::State& state) {
+    runTokenizer(state, "none", kEnglishText);
+}
+
+BENCHMARK(BM_TokenizeAsciiEnglish)->Arg(1)->Arg(100);
+BENCHMARK(BM_TokenizeLatinFrench)->Arg(1)->Arg(100);
+BENCHMARK(BM_TokenizeAsciiNone)->Arg(1)->Arg(100);
+
+}  // namespace
+}  // namespace fts
+}  // namespace mongo
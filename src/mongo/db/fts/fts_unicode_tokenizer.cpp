@@ -31,6 +31,7 @@
 
 #include "mongo/db/fts/fts_unicode_tokenizer.h"
 
+#include <cstring>
 #include <memory>
 
 #include "mongo/db/fts/fts_query_impl.h"
@@ -45,6 +46,25 @@ namespace fts {
 
 using std::string;
 
+namespace {
+/**
+ * Returns, for each ASCII character, whether it is a delimiter in 'language'.
+ */
+const std::array<bool, 128>* getAsciiDelimiters(unicode::DelimiterListLanguage language) {
+    static const auto tables = [] {
+        std::array<std::array<bool, 128>, 2> tables;
+        for (char32_t ch = 0; ch < 128; ++ch) {
+            tables[0][ch] =
+                unicode::codepointIsDelimiter(ch, unicode::DelimiterListLanguage::kEnglish);
+            tables[1][ch] =
+                unicode::codepointIsDelimiter(ch, unicode::DelimiterListLanguage::kNotEnglish);
+        }
+        return tables;
+    }();
+    return &tables[language == unicode::DelimiterListLanguage::kEnglish ? 0 : 1];
+}
+}  // namespace
+
 UnicodeFTSTokenizer::UnicodeFTSTokenizer(const FTSLanguage* language)
     : _language(language),
       _stemmer(language),
@@ -53,12 +73,24 @@ UnicodeFTSTokenizer::UnicodeFTSTokenizer(const FTSLanguage* language)
                              ? unicode::DelimiterListLanguage::kEnglish
                              : unicode::DelimiterListLanguage::kNotEnglish),
       _caseFoldMode(_language->str() == "turkish" ? unicode::CaseFoldMode::kTurkish
-                                                  : unicode::CaseFoldMode::kNormal) {}
+                                                  : unicode::CaseFoldMode::kNormal),
+      _asciiDelimiters(getAsciiDelimiters(_delimListLanguage)) {}
 
 void UnicodeFTSTokenizer::reset(StringData document, Options options) {
     _options = options;
     _pos = 0;
-    _document.resetData(document);  // Validates that document is valid UTF8.
+
+    // ASCII documents need neither UTF-8 validation nor conversion to UTF-32. Like the conversion,
+    // stop at the first NUL byte.
+    _isAscii = unicode::String::isAscii(document);
+    if (_isAscii) {
+        const auto nul = std::memchr(document.rawData(), '\0', document.size());
+        _asciiDocument.assign(document.rawData(),
+                              nul ? static_cast<const char*>(nul) - document.rawData()
+                                  : document.size());
+    } else {
+        _document.resetData(document);  // Validates that document is valid UTF8.
+    }
 
     // Skip any leading delimiters (and handle the case where the document is entirely delimiters).
     _skipDelimiters();
@@ -66,15 +98,14 @@ void UnicodeFTSTokenizer::reset(StringData document, Options options) {
 
 bool UnicodeFTSTokenizer::moveNext() {
     while (true) {
-        if (_pos >= _document.size()) {
+        if (_pos >= _documentSize()) {
             _word = "";
             return false;
         }
 
         // Traverse through non-delimiters and build the next token.
         size_t start = _pos++;
-        while (_pos < _document.size() &&
-               (!unicode::codepointIsDelimiter(_document[_pos], _delimListLanguage))) {
+        while (_pos < _documentSize() && !_isDelimiter(_pos)) {
             ++_pos;
         }
         const size_t len = _pos - start;
@@ -84,14 +115,19 @@ bool UnicodeFTSTokenizer::moveNext() {
 
         // Stop words are case-sensitive and diacritic sensitive, so we need them to be lower cased
         // but with diacritics not removed to check against the stop word list.
-        _word = _document.toLowerToBuf(&_wordBuf, _caseFoldMode, start, len);
+        const StringData asciiToken =
+            _isAscii ? StringData(_asciiDocument.data() + start, len) : StringData();
+        _word = _isAscii
+            ? unicode::String::caseFoldAndStripDiacritics(
+                  &_wordBuf, asciiToken, unicode::String::kDiacriticSensitive, _caseFoldMode)
+            : _document.toLowerToBuf(&_wordBuf, _caseFoldMode, start, len);
 
         if ((_options & kFilterStopWords) && _stopWords->isStopWord(_word)) {
             continue;
         }
 
         if (_options & kGenerateCaseSensitiveTokens) {
-            _word = _document.substrToBuf(&_wordBuf, start, len);
+            _word = _isAscii ? asciiToken : _document.substrToBuf(&_wordBuf, start, len);
         }
 
         // The stemmer is diacritic sensitive, so stem the word before removing diacritics.
@@ -112,8 +148,7 @@ StringData UnicodeFTSTokenizer::get() const {
 }
 
 void UnicodeFTSTokenizer::_skipDelimiters() {
-    while (_pos < _document.size() &&
-           unicode::codepointIsDelimiter(_document[_pos], _delimListLanguage)) {
+    while (_pos < _documentSize() && _isDelimiter(_pos)) {
         ++_pos;
     }
 }
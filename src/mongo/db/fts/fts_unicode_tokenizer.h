@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <array>
+#include <string>
+
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_tokenizer.h"
 #include "mongo/db/fts/stemmer.h"
@@ -74,12 +77,32 @@ private:
      */
     void _skipDelimiters();
 
+    /**
+     * Returns true if the character at position 'pos' of the current document is a delimiter.
+     */
+    bool _isDelimiter(size_t pos) const {
+        return _isAscii ? (*_asciiDelimiters)[static_cast<unsigned char>(_asciiDocument[pos])]
+                        : unicode::codepointIsDelimiter(_document[pos], _delimListLanguage);
+    }
+
+    /**
+     * Returns the number of characters in the current document.
+     */
+    size_t _documentSize() const {
+        return _isAscii ? _asciiDocument.size() : _document.size();
+    }
+
     const FTSLanguage* const _language;
     const Stemmer _stemmer;
     const StopWords* const _stopWords;
     const unicode::DelimiterListLanguage _delimListLanguage;
     const unicode::CaseFoldMode _caseFoldMode;
+    const std::array<bool, 128>* const _asciiDelimiters;
 
+    // Documents which are entirely ASCII are tokenized bytewise from '_asciiDocument'; all others
+    // are converted to UTF-32 in '_document'.
+    bool _isAscii = false;
+    std::string _asciiDocument;
     unicode::String _document;
     size_t _pos;
     StringData _word;
@@ -239,5 +239,54 @@ TEST(FtsUnicodeTokenizer, FrenchStopWordsAndDiacriticSensitive) {
     ASSERT_EQUALS("excit", terms[4]);
 }
 
+// ASCII documents are tokenized bytewise, and must produce the same tokens as documents which go
+// through the UTF-32 conversion. A trailing non-ASCII word forces the latter.
+TEST(FtsUnicodeTokenizer, AsciiMatchesUtf32) {
+    const char* const documents[] = {
+        "Do you see Mark's dog running?",
+        "  , THE QUICK-brown fox; jumped over\tthe LAZY dogs... ",
+        "Ou^vert `accent` marks I IN Istanbul",
+        "",
+        ",;. ",
+    };
+    const FTSTokenizer::Options optionSets[] = {
+        FTSTokenizer::kNone,
+        FTSTokenizer::kFilterStopWords,
+        FTSTokenizer::kGenerateCaseSensitiveTokens,
+        FTSTokenizer::kGenerateDiacriticSensitiveTokens,
+        FTSTokenizer::kGenerateCaseSensitiveTokens |
+            FTSTokenizer::kGenerateDiacriticSensitiveTokens | FTSTokenizer::kFilterStopWords,
+    };
+
+    for (const char* language : {"english", "french", "turkish", "none"}) {
+        for (auto options : optionSets) {
+            for (const char* document : documents) {
+                auto asciiTerms = tokenizeString(document, language, options);
+                const std::string nonAsciiDocument = std::string(document) + " caf\xc3\xa9";
+                auto utf32Terms = tokenizeString(nonAsciiDocument.c_str(), language, options);
+                ASSERT_FALSE(utf32Terms.empty());
+                utf32Terms.pop_back();
+                ASSERT(asciiTerms == utf32Terms)
+                    << language << " " << static_cast<int>(options) << " " << document;
+            }
+        }
+    }
+}
+
+// Documents are truncated at an embedded NUL byte whether or not they are ASCII.
+TEST(FtsUnicodeTokenizer, AsciiStopsAtNul) {
+    const std::string document("one two\0three", 13);
+    UnicodeFTSTokenizer tokenizer(&FTSLanguage::make("english", TEXT_INDEX_VERSION_3));
+    tokenizer.reset(document, FTSTokenizer::kNone);
+
+    std::vector<std::string> terms;
+    while (tokenizer.moveNext()) {
+        terms.push_back(tokenizer.get().toString());
+    }
+    ASSERT_EQUALS(2U, terms.size());
+    ASSERT_EQUALS("one", terms[0]);
+    ASSERT_EQUALS("two", terms[1]);
+}
+
 }  // namespace fts
 }  // namespace mongo
@@ -27,32 +27,187 @@
  *    it in the license file.
  */
 
+#include <array>
 #include <cstdlib>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "mongo/db/fts/stemmer.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/new.h"
+#include "mongo/util/assert_util.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 
 namespace fts {
 
-Stemmer::Stemmer(const FTSLanguage* language) {
-    _stemmer = nullptr;
-    if (language->str() != "none")
-        _stemmer = sb_stemmer_new(language->str().c_str(), "UTF_8");
+/**
+ * The state shared by every Stemmer for a single language: a pool of idle Snowball stemmers,
+ * which are not thread-safe and so are used by one Stemmer at a time, and a direct-mapped cache
+ * of the stems of recently seen words. The cache is split into shards, each with its own mutex,
+ * so that threads stemming different words rarely contend. Its size is fixed, so the memory it
+ * takes does not grow with the number of threads.
+ */
+class SharedStemmerState {
+    SharedStemmerState(const SharedStemmerState&) = delete;
+    SharedStemmerState& operator=(const SharedStemmerState&) = delete;
+
+public:
+    explicit SharedStemmerState(const FTSLanguage* language) : _language(language) {}
+
+    static SharedStemmerState& get(const FTSLanguage* language);
+
+    struct sb_stemmer* acquireStemmer() {
+        {
+            stdx::lock_guard<Latch> lk(_poolMutex);
+            if (!_idleStemmers.empty()) {
+                auto stemmer = _idleStemmers.back();
+                _idleStemmers.pop_back();
+                return stemmer;
+            }
+        }
+
+        auto stemmer = sb_stemmer_new(_language->str().c_str(), "UTF_8");
+        invariant(stemmer);
+        return stemmer;
+    }
+
+    void releaseStemmer(struct sb_stemmer* stemmer) {
+        {
+            stdx::lock_guard<Latch> lk(_poolMutex);
+            if (_idleStemmers.size() < kMaxIdleStemmers) {
+                _idleStemmers.push_back(stemmer);
+                return;
+            }
+        }
+        sb_stemmer_delete(stemmer);
+    }
+
+    /**
+     * Copies the cached stem of 'word' into 'stem' and returns true, or returns false if the stem
+     * of 'word' is not cached.
+     */
+    bool findStem(StringData word, std::string* stem) {
+        if (word.size() > kMaxCachedWordSize) {
+            return false;
+        }
+
+        auto [shard, entry] = _locate(word);
+        stdx::lock_guard<Latch> lk(shard->mutex);
+        if (!entry->valid || entry->word != std::string_view(word.rawData(), word.size())) {
+            return false;
+        }
+        stem->assign(entry->stem);
+        return true;
+    }
+
+    void addStem(StringData word, StringData stem) {
+        if (word.size() > kMaxCachedWordSize) {
+            return;
+        }
+
+        auto [shard, entry] = _locate(word);
+        stdx::lock_guard<Latch> lk(shard->mutex);
+        entry->word.assign(word.rawData(), word.size());
+        entry->stem.assign(stem.rawData(), stem.size());
+        entry->valid = true;
+    }
+
+private:
+    // Long words are rarely repeated, and would make the cache entries expensive to copy into.
+    static constexpr size_t kMaxCachedWordSize = 32;
+    static constexpr size_t kNumShards = 16;
+    static constexpr size_t kEntriesPerShard = 128;
+    // Stemmers beyond these are freed when returned, rather than kept for later Stemmers.
+    static constexpr size_t kMaxIdleStemmers = 8;
+
+    struct Entry {
+        bool valid = false;
+        std::string word;
+        std::string stem;
+    };
+
+    struct alignas(stdx::hardware_destructive_interference_size) Shard {
+        Mutex mutex = MONGO_MAKE_LATCH("SharedStemmerState::Shard::mutex");
+        std::array<Entry, kEntriesPerShard> entries;
+    };
+
+    std::pair<Shard*, Entry*> _locate(StringData word) {
+        const size_t hash = std::hash<std::string_view>{}({word.rawData(), word.size()});
+        auto& shard = _shards[hash % kNumShards];
+        return {&shard, &shard.entries[(hash / kNumShards) % kEntriesPerShard]};
+    }
+
+    const FTSLanguage* const _language;
+
+    Mutex _poolMutex = MONGO_MAKE_LATCH("SharedStemmerState::_poolMutex");
+    std::vector<struct sb_stemmer*> _idleStemmers;
+
+    std::array<Shard, kNumShards> _shards;
+};
+
+SharedStemmerState& SharedStemmerState::get(const FTSLanguage* language) {
+    // A Stemmer is constructed for every tokenized document, so each thread remembers the states
+    // it has looked up rather than taking the registry mutex every time. FTSLanguage instances are
+    // singletons, so there is at most one entry per language in either list.
+    thread_local std::vector<std::pair<const FTSLanguage*, SharedStemmerState*>> seen;
+    for (auto&& [seenLanguage, state] : seen) {
+        if (seenLanguage == language) {
+            return *state;
+        }
+    }
+
+    struct Registry {
+        Mutex mutex = MONGO_MAKE_LATCH("SharedStemmerState::Registry::mutex");
+        std::vector<std::pair<const FTSLanguage*, std::unique_ptr<SharedStemmerState>>> states;
+    };
+    static auto& registry = *new Registry();
+
+    SharedStemmerState* state = nullptr;
+    {
+        stdx::lock_guard<Latch> lk(registry.mutex);
+        for (auto&& [stateLanguage, registered] : registry.states) {
+            if (stateLanguage == language) {
+                state = registered.get();
+                break;
+            }
+        }
+        if (!state) {
+            registry.states.emplace_back(language,
+                                         std::make_unique<SharedStemmerState>(language));
+            state = registry.states.back().second.get();
+        }
+    }
+
+    seen.emplace_back(language, state);
+    return *state;
 }
 
+Stemmer::Stemmer(const FTSLanguage* language)
+    : _shared(language->str() != "none" ? &SharedStemmerState::get(language) : nullptr) {}
+
 Stemmer::~Stemmer() {
     if (_stemmer) {
-        sb_stemmer_delete(_stemmer);
+        _shared->releaseStemmer(_stemmer);
         _stemmer = nullptr;
     }
 }
 
 StringData Stemmer::stem(StringData word) const {
-    if (!_stemmer)
+    if (!_shared)
         return word;
 
+    if (_shared->findStem(word, &_stemmed)) {
+        return _stemmed;
+    }
+
+    if (!_stemmer) {
+        _stemmer = _shared->acquireStemmer();
+    }
+
     const sb_symbol* sb_sym =
         sb_stemmer_stem(_stemmer, (const sb_symbol*)word.rawData(), word.size());
 
@@ -61,7 +216,10 @@ StringData Stemmer::stem(StringData word) const {
         MONGO_UNREACHABLE;
     }
 
-    return StringData((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    const StringData stemmed((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    _shared->addStem(word, stemmed);
+    _stemmed.assign(stemmed.rawData(), stemmed.size());
+    return _stemmed;
 }
 }  // namespace fts
 }  // namespace mongo
@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_language.h"
 #include "third_party/libstemmer_c/include/libstemmer.h"
@@ -38,10 +40,17 @@ namespace mongo {
 
 namespace fts {
 
+class SharedStemmerState;
+
 /**
  * maintains case
  * but works
  * running/Running -> run/Run
+ *
+ * All Stemmers for a language share a bounded cache of the stems of recently seen words, so that
+ * words which recur across documents are only stemmed once, and a small pool of Snowball
+ * stemmers, so that constructing a Stemmer is cheap. A Stemmer checks a Snowball stemmer out of
+ * the pool on its first cache miss and returns it when destroyed.
  */
 class Stemmer {
     Stemmer(const Stemmer&) = delete;
@@ -61,7 +70,13 @@ public:
     StringData stem(StringData word) const;
 
 private:
-    struct sb_stemmer* _stemmer;
+    // Null if the language does not stem words.
+    SharedStemmerState* _shared;
+
+    mutable struct sb_stemmer* _stemmer = nullptr;
+
+    // Holds the result of the last call to stem().
+    mutable std::string _stemmed;
 };
 }  // namespace fts
 }  // namespace mongo
@@ -32,6 +32,7 @@
 
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/fts/stemmer.h"
+#include "mongo/stdx/thread.h"
 
 namespace mongo {
 namespace fts {
@@ -56,5 +57,42 @@ TEST(English, Caps) {
     ASSERT_EQUALS("unit", s.stem("united"));
     ASSERT_EQUALS("Unite", s.stem("United"));
 }
+
+TEST(English, StemmersOnManyThreadsShareCachedStems) {
+    const std::vector<std::string> words = {
+        "running", "Running", "jumped", "happily", "connection", "connections", "connected",
+        "generously", "relational", "conditional", "hopeful", "electricity", "adjustable",
+        "supercalifragilisticexpialidociouslyness"};
+    std::vector<std::string> expected;
+    {
+        Stemmer s(languageEnglishV2());
+        for (const auto& word : words) {
+            expected.push_back(s.stem(word).toString());
+        }
+    }
+
+    std::vector<int> numMismatches(4, 0);
+    std::vector<stdx::thread> threads;
+    for (size_t t = 0; t < numMismatches.size(); ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 100; ++i) {
+                // Like a tokenizer per document, each round checks a Stemmer in and out.
+                Stemmer s(languageEnglishV2());
+                for (size_t w = 0; w < words.size(); ++w) {
+                    if (s.stem(words[w]) != expected[w]) {
+                        ++numMismatches[t];
+                    }
+                }
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    for (int mismatches : numMismatches) {
+        ASSERT_EQUALS(0, mismatches);
+    }
+}
 }  // namespace fts
 }  // namespace mongo
@@ -61,6 +61,52 @@ inline void appendUtf8Codepoint(char32_t codepoint, OutputIterator* outputIt) {
         *(*outputIt)++ = (((codepoint >> (6 * 0)) & 0x3f) | 0x80);
     }
 }
+
+/**
+ * Case folding and diacritic removal results for the codepoints below 0x100, indexed by the
+ * SubstrMatchOptions passed to caseFoldAndStripDiacritics(). Latin-1 text is common enough that
+ * these are worth looking up directly rather than going through the switch statements in
+ * codepointToLower() and codepointRemoveDiacritics(). Turkish case folding only differs from the
+ * normal mode for 'I' and U+0130, neither of which is in the non-ASCII part of this range.
+ */
+class Latin1FoldTable {
+public:
+    Latin1FoldTable() {
+        for (String::SubstrMatchOptions options = 0; options < kNumOptions; ++options) {
+            for (char32_t codepoint = 0x80; codepoint < kSize; ++codepoint) {
+                char32_t folded = codepoint;
+                if (!(options & String::kCaseSensitive)) {
+                    folded = codepointToLower(folded, CaseFoldMode::kNormal);
+                }
+                if (!(options & String::kDiacriticSensitive)) {
+                    folded = codepointRemoveDiacritics(folded);
+                }
+                _table[options][codepoint] = folded;
+            }
+        }
+    }
+
+    static constexpr char32_t kSize = 0x100;
+
+    /**
+     * Returns the folded form of 'codepoint', which must be in [0x80, 0x100), or 0 if it is a pure
+     * diacritic which should be removed.
+     */
+    char32_t fold(char32_t codepoint, String::SubstrMatchOptions options) const {
+        return _table[options][codepoint];
+    }
+
+private:
+    static constexpr String::SubstrMatchOptions kNumOptions =
+        (String::kCaseSensitive | String::kDiacriticSensitive) + 1;
+
+    char32_t _table[kNumOptions][kSize] = {};
+};
+
+const Latin1FoldTable& latin1FoldTable() {
+    static const Latin1FoldTable table;
+    return table;
+}
 }  // namespace
 
 using linenoise_utf8::copyString32to8;
@@ -149,6 +195,22 @@ StringData String::toLowerToBuf(StackBufBuilder* buffer,
 }
 
 
+bool String::isAscii(StringData utf8) {
+    auto it = utf8.rawData();
+    const auto end = it + utf8.size();
+#ifdef MONGO_HAVE_FAST_BYTE_VECTOR
+    for (; size_t(end - it) >= ByteVector::size; it += ByteVector::size) {
+        if (ByteVector::load(it).maskHigh())
+            return false;
+    }
+#endif
+    for (; it != end; ++it) {
+        if (uint8_t(*it) > 0x7f)
+            return false;
+    }
+    return true;
+}
+
 StringData String::caseFoldAndStripDiacritics(StackBufBuilder* buffer,
                                               StringData utf8,
                                               SubstrMatchOptions options,
@@ -242,14 +304,20 @@ StringData String::caseFoldAndStripDiacritics(StackBufBuilder* buffer,
                 codepoint |= subByte & 0x3f;  // mask off continuation bits.
             }
 
-            if (!(options & kCaseSensitive)) {
-                codepoint = codepointToLower(codepoint, mode);
-            }
-
-            if (!(options & kDiacriticSensitive)) {
-                codepoint = codepointRemoveDiacritics(codepoint);
+            if (codepoint < Latin1FoldTable::kSize) {
+                codepoint = latin1FoldTable().fold(codepoint, options);
                 if (!codepoint)
                     continue;  // codepoint is a pure diacritic.
+            } else {
+                if (!(options & kCaseSensitive)) {
+                    codepoint = codepointToLower(codepoint, mode);
+                }
+
+                if (!(options & kDiacriticSensitive)) {
+                    codepoint = codepointRemoveDiacritics(codepoint);
+                    if (!codepoint)
+                        continue;  // codepoint is a pure diacritic.
+                }
             }
         }
 
@@ -143,6 +143,12 @@ public:
                                                  SubstrMatchOptions options,
                                                  CaseFoldMode mode);
 
+    /**
+     * Returns true if 'utf8' contains only ASCII characters, which lets callers tokenize and case
+     * fold it bytewise without converting it to UTF-32.
+     */
+    static bool isAscii(StringData utf8);
+
 private:
     /**
      * Helper method for converting a UTF-8 string to a UTF-32 string.
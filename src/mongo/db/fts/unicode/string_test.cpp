@@ -162,6 +162,50 @@ TEST(UnicodeString, CaseFoldingAndRemoveDiacritics) {
     TEST_CASE_FOLD_AND_STRIP_DIACRITICS(UTF8("cafe"), test3, 0, kNormal);
 }
 
+TEST(UnicodeString, CaseFoldingAndRemoveDiacriticsLatin1) {
+    // Latin-1 codepoints are folded through a lookup table, which must agree with folding each
+    // codepoint individually.
+    const auto toUtf8 = [](char32_t codepoint) {
+        std::u32string utf32(1, codepoint);
+        utf32.push_back(0);
+        std::string utf8(8, '\0');
+        const auto len = copyString32to8(
+            reinterpret_cast<unsigned char*>(&utf8[0]), &utf32[0], utf8.size());
+        utf8.resize(len);
+        return utf8;
+    };
+
+    for (auto mode : {kNormal, kTurkish}) {
+        for (auto options : {0, int(kCaseSensitive), int(kDiacriticSensitive)}) {
+            for (char32_t codepoint = 0x80; codepoint <= 0xFF; ++codepoint) {
+                char32_t expected = codepoint;
+                if (!(options & kCaseSensitive)) {
+                    expected = codepointToLower(expected, mode);
+                }
+                if (!(options & kDiacriticSensitive)) {
+                    expected = codepointRemoveDiacritics(expected);
+                }
+                TEST_CASE_FOLD_AND_STRIP_DIACRITICS(
+                    expected ? toUtf8(expected) : std::string(), toUtf8(codepoint), options, mode);
+            }
+        }
+    }
+}
+
+TEST(UnicodeString, IsAscii) {
+    ASSERT_TRUE(String::isAscii(""));
+    ASSERT_TRUE(String::isAscii("How old are you?"));
+    ASSERT_TRUE(String::isAscii("How old are you?" + filler));
+    ASSERT_FALSE(String::isAscii(UTF8("¿CUÁNTOS AÑOS TIENES TÚ?")));
+
+    // Non-ASCII bytes are found both in full vectors and in the remaining tail.
+    for (size_t pos = 0; pos < filler.size(); ++pos) {
+        std::string str = filler;
+        str[pos] = C(0xC3);
+        ASSERT_FALSE(String::isAscii(str)) << pos;
+    }
+}
+
 TEST(UnicodeString, SubstringMatch) {
     std::string str = UTF8("Одумайся! Престол свой сохрани; И ярость укроти.");
 
@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+
+#include "mongo/db/geo/geo_query_cache.h"
+#include "mongo/db/geo/geometry_container.h"
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Returns {$geometry: <polygon>} for a regular polygon with 'numVertices' vertices approximating
+ * a circle about 20km across, the size of a typical delivery zone.
+ */
+BSONObj makeZoneSpec(int numVertices) {
+    constexpr double kLng = -73.95;
+    constexpr double kLat = 40.75;
+    constexpr double kRadius = 0.1;
+
+    BSONArrayBuilder ring;
+    for (int i = 0; i < numVertices; ++i) {
+        const double angle = 2 * M_PI * i / numVertices;
+        ring.append(
+            BSON_ARRAY(kLng + kRadius * std::cos(angle) << kLat + kRadius * std::sin(angle)));
+    }
+    ring.append(BSON_ARRAY(kLng + kRadius << kLat));
+    return BSON("$geometry" << BSON("type"
+                                    << "Polygon"
+                                    << "coordinates" << BSON_ARRAY(ring.arr())));
+}
+
+/**
+ * Parses and covers the same zone over and over, as planning repeated $geoWithin queries on a
+ * 2dsphere index does. The second argument enables the cache.
+ */
+void BM_CoverZone(benchmark::State& state) {
+    const BSONObj spec = makeZoneSpec(state.range(0));
+    GeoQueryCache cache(state.range(1) ? 1000 : 0, 32 * 1024 * 1024);
+    const GeoQueryCache::CoveringParams params{0, 23, 20};
+
+    for (auto _ : state) {
+        GeometryContainer geometry;
+        invariant(geometry.parseFromQuery(spec.firstElement()));
+        benchmark::DoNotOptimize(cache.getCovering(geometry, params));
+    }
+}
+
+/**
+ * Tests points spread around the zone against it, as matching candidate documents of a
+ * $geoWithin query does. The second argument prepares the zone first, rather than after its
+ * first GeometryContainer::kPointTestsBeforePreparing point tests.
+ */
+void BM_ZoneContainsPoint(benchmark::State& state) {
+    const BSONObj spec = makeZoneSpec(state.range(0));
+    GeometryContainer zone;
+    invariant(zone.parseFromQuery(spec.firstElement()));
+    if (state.range(1)) {
+        zone.prepareForPointTests();
+    }
+
+    std::vector<std::unique_ptr<GeometryContainer>> points;
+    for (double lng = -74.1; lng <= -73.8; lng += 0.01) {
+        for (double lat = 40.6; lat <= 40.9; lat += 0.01) {
+            points.push_back(std::make_unique<GeometryContainer>());
+            invariant(points.back()->parseFromStorage(
+                BSON("" << BSON("type"
+                                << "Point"
+                                << "coordinates" << BSON_ARRAY(lng << lat)))
+                    .firstElement()));
+        }
+    }
+
+    for (auto _ : state) {
+        for (const auto& point : points) {
+            benchmark::DoNotOptimize(zone.contains(*point));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+BENCHMARK(BM_CoverZone)->Args({16, 0})->Args({16, 1})->Args({1000, 0})->Args({1000, 1});
+BENCHMARK(BM_ZoneContainsPoint)->Args({16, 0})->Args({16, 1})->Args({1000, 0})->Args({1000, 1});
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,209 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/geo/geo_query_cache.h"
+
+#include <absl/hash/hash.h>
+#include <absl/strings/string_view.h>
+#include <iterator>
+
+#include "mongo/db/geo/geo_query_cache_gen.h"
+#include "mongo/db/geo/geometry_container.h"
+#include "third_party/s2/s2regioncoverer.h"
+
+namespace mongo {
+
+GeoQueryCache& GeoQueryCache::get() {
+    static auto& cache = *new GeoQueryCache(gInternalQueryGeoCacheSize,
+                                            static_cast<size_t>(gInternalQueryGeoCacheMaxBytes));
+    return cache;
+}
+
+GeoQueryCache::GeoQueryCache(size_t maxSize, size_t maxBytes)
+    : _maxSize(maxSize), _maxBytes(maxBytes), _cache(maxSize) {}
+
+std::vector<S2CellId> GeoQueryCache::computeCovering(const S2Region& region,
+                                                     const CoveringParams& params) {
+    S2RegionCoverer coverer;
+    coverer.set_min_level(params.minLevel);
+    coverer.set_max_level(params.maxLevel);
+    coverer.set_max_cells(params.maxCells);
+
+    std::vector<S2CellId> cover;
+    coverer.GetCovering(region, &cover);
+    return cover;
+}
+
+boost::optional<GeoQueryCache::Key> GeoQueryCache::_makeKey(
+    const GeometryContainer& geometry) const {
+    const BSONObj& spec = geometry.getQuerySpec();
+    if (_maxSize == 0 || spec.isEmpty() || !geometry.hasS2Region() ||
+        static_cast<size_t>(spec.objsize()) > _maxBytes / kMaxEntryFractionOfBudget) {
+        return boost::none;
+    }
+
+    // The same specifier describes a different region once projected into another CRS.
+    const char crs = static_cast<char>(geometry.getNativeCRS());
+    const size_t hash = absl::Hash<std::pair<char, absl::string_view>>{}(
+        {crs, absl::string_view(spec.objdata(), spec.objsize())});
+    return Key{hash, crs, spec};
+}
+
+bool GeoQueryCache::_matches(const Entry& entry, const Key& key) {
+    return entry.crs == key.crs && entry.spec.binaryEqual(key.spec);
+}
+
+GeoQueryCache::Entry* GeoQueryCache::_find(WithLock, const Key& key) {
+    auto it = _cache.find(key.hash);
+    return it != _cache.end() && _matches(it->second, key) ? &it->second : nullptr;
+}
+
+template <typename Update>
+void GeoQueryCache::_update(WithLock, const Key& key, Update update) {
+    auto it = _cache.find(key.hash);
+    if (it != _cache.end() && !_matches(it->second, key)) {
+        // The hash collides with another geometry, which gives up its slot.
+        _totalBytes -= it->second.bytes;
+        _cache.erase(it);
+        it = _cache.end();
+    }
+
+    if (it == _cache.end()) {
+        Entry entry;
+        entry.crs = key.crs;
+        entry.spec = key.spec;
+        if (auto evicted = _cache.add(key.hash, std::move(entry))) {
+            _totalBytes -= evicted->second.bytes;
+        }
+        it = _cache.begin();
+    }
+
+    Entry& entry = it->second;
+    _totalBytes -= entry.bytes;
+    update(entry);
+    entry.bytes = sizeof(Entry) + entry.spec.objsize() +
+        (entry.covering ? entry.covering->size() * sizeof(S2CellId) : 0) +
+        (entry.preparedRegion ? entry.preparedRegion->memUsageBytes() : 0);
+    _totalBytes += entry.bytes;
+
+    // The entry just updated is the most recently used one, so it is never evicted here.
+    while (_totalBytes > _maxBytes && _cache.size() > 1) {
+        auto lru = std::prev(_cache.end());
+        _totalBytes -= lru->second.bytes;
+        _cache.erase(lru);
+    }
+}
+
+std::vector<S2CellId> GeoQueryCache::getCovering(const GeometryContainer& geometry,
+                                                 const CoveringParams& params) {
+    const auto key = _makeKey(geometry);
+    if (!key) {
+        return computeCovering(geometry.getS2Region(), params);
+    }
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto entry = _find(lk, *key);
+        if (entry && entry->coveringParams == params) {
+            return *entry->covering;
+        }
+    }
+
+    // Cover outside the lock, since large polygons can take a while.
+    auto covering = std::make_shared<const std::vector<S2CellId>>(
+        computeCovering(geometry.getS2Region(), params));
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _update(lk, *key, [&](Entry& entry) {
+        entry.coveringParams = params;
+        entry.covering = covering;
+    });
+    return *covering;
+}
+
+std::shared_ptr<const PreparedS2Region> GeoQueryCache::getPreparedRegion(
+    const GeometryContainer& geometry) {
+    const auto key = _makeKey(geometry);
+    if (!key) {
+        return nullptr;
+    }
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto entry = _find(lk, *key);
+        if (entry && entry->preparedRegion) {
+            return entry->preparedRegion;
+        }
+    }
+
+    auto preparedRegion = std::make_shared<const PreparedS2Region>(geometry.getS2Region());
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _update(lk, *key, [&](Entry& entry) {
+        // Another query may have prepared the same region meanwhile.
+        if (!entry.preparedRegion) {
+            entry.preparedRegion = preparedRegion;
+        }
+        preparedRegion = entry.preparedRegion;
+    });
+    return preparedRegion;
+}
+
+std::shared_ptr<const PreparedS2Region> GeoQueryCache::findPreparedRegion(
+    const GeometryContainer& geometry) {
+    const auto key = _makeKey(geometry);
+    if (!key) {
+        return nullptr;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto entry = _find(lk, *key);
+    return entry ? entry->preparedRegion : nullptr;
+}
+
+size_t GeoQueryCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _cache.size();
+}
+
+size_t GeoQueryCache::bytes() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _totalBytes;
+}
+
+void GeoQueryCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _cache.clear();
+    _totalBytes = 0;
+}
+
+}  // namespace mongo
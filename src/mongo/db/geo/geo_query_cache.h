@@ -0,0 +1,159 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/geo/prepared_s2_region.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/lru_cache.h"
+#include "third_party/s2/s2cellid.h"
+
+namespace mongo {
+
+class GeometryContainer;
+
+/**
+ * A process-wide LRU cache of the S2 coverings and prepared regions computed for query
+ * geometries, keyed by a hash of the CRS and the BSON of the geometry specifier. Applications
+ * which query the same geometries over and over, such as fixed delivery zones, then only pay for
+ * covering and preparing each geometry once.
+ *
+ * The cache is bounded both by its number of entries and by the bytes its entries take, counting
+ * the specifier each entry keeps to tell apart geometries whose hashes collide. A geometry which
+ * would take more than 1/kMaxEntryFractionOfBudget of the byte budget is not cached, so that one
+ * huge polygon cannot flush every other entry. Geometries which were not parsed from a query are
+ * never cached.
+ */
+class GeoQueryCache {
+public:
+    /**
+     * The S2RegionCoverer parameters a covering was computed with.
+     */
+    struct CoveringParams {
+        int minLevel;
+        int maxLevel;
+        int maxCells;
+
+        bool operator==(const CoveringParams& other) const {
+            return minLevel == other.minLevel && maxLevel == other.maxLevel &&
+                maxCells == other.maxCells;
+        }
+    };
+
+    static constexpr size_t kMaxEntryFractionOfBudget = 16;
+
+    static GeoQueryCache& get();
+
+    GeoQueryCache(size_t maxSize, size_t maxBytes);
+
+    /**
+     * Returns the covering of the S2 region of 'geometry' computed with 'params'.
+     */
+    std::vector<S2CellId> getCovering(const GeometryContainer& geometry,
+                                      const CoveringParams& params);
+
+    /**
+     * Returns the S2 region of 'geometry' prepared for point tests, or null if 'geometry' cannot
+     * be cached. Preparing a region is only worthwhile when it is reused across queries.
+     */
+    std::shared_ptr<const PreparedS2Region> getPreparedRegion(const GeometryContainer& geometry);
+
+    /**
+     * Returns the prepared S2 region of 'geometry' if an earlier query already prepared it, or
+     * null otherwise. Never prepares the region.
+     */
+    std::shared_ptr<const PreparedS2Region> findPreparedRegion(const GeometryContainer& geometry);
+
+    static std::vector<S2CellId> computeCovering(const S2Region& region,
+                                                 const CoveringParams& params);
+
+    size_t size() const;
+
+    /**
+     * Returns the approximate number of bytes taken by the cached entries.
+     */
+    size_t bytes() const;
+
+    void clear();
+
+private:
+    struct Key {
+        size_t hash;
+        char crs;
+        BSONObj spec;
+    };
+
+    struct Entry {
+        char crs;
+        // Shares the buffer of the specifier the geometry was parsed from.
+        BSONObj spec;
+        boost::optional<CoveringParams> coveringParams;
+        std::shared_ptr<const std::vector<S2CellId>> covering;
+        std::shared_ptr<const PreparedS2Region> preparedRegion;
+        size_t bytes = 0;
+    };
+
+    /**
+     * Returns the cache key for 'geometry', or boost::none if it must not be cached.
+     */
+    boost::optional<Key> _makeKey(const GeometryContainer& geometry) const;
+
+    static bool _matches(const Entry& entry, const Key& key);
+
+    /**
+     * Returns the entry for 'key', or null if there is none, including when another geometry
+     * with the same hash is cached.
+     */
+    Entry* _find(WithLock, const Key& key);
+
+    /**
+     * Applies 'update' to the entry for 'key', creating it first if needed, then evicts the least
+     * recently used entries until the cache is within its byte budget again.
+     */
+    template <typename Update>
+    void _update(WithLock, const Key& key, Update update);
+
+    const size_t _maxSize;
+    const size_t _maxBytes;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("GeoQueryCache::_mutex");
+    LRUCache<size_t, Entry> _cache;
+    size_t _totalBytes = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,253 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <cmath>
+
+#include "mongo/db/geo/geo_query_cache.h"
+#include "mongo/db/geo/geometry_container.h"
+#include "mongo/db/geo/prepared_s2_region.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+#include "third_party/s2/s2latlng.h"
+#include "third_party/s2/s2polygon.h"
+
+namespace mongo {
+namespace {
+
+const size_t kMaxBytes = 1024 * 1024;
+
+/**
+ * Returns {$geometry: <polygon>} for a regular polygon with 'numVertices' vertices around
+ * (lng, lat), which approximates a circle of 'radius' degrees.
+ */
+BSONObj makePolygonSpec(double lng, double lat, double radius, int numVertices) {
+    BSONArrayBuilder ring;
+    for (int i = 0; i < numVertices; ++i) {
+        const double angle = 2 * M_PI * i / numVertices;
+        ring.append(BSON_ARRAY(lng + radius * std::cos(angle) << lat + radius * std::sin(angle)));
+    }
+    ring.append(BSON_ARRAY(lng + radius << lat));
+    return BSON("$geometry" << BSON("type"
+                                    << "Polygon"
+                                    << "coordinates" << BSON_ARRAY(ring.arr())));
+}
+
+std::unique_ptr<GeometryContainer> parseQuery(const BSONObj& spec) {
+    auto geometry = std::make_unique<GeometryContainer>();
+    ASSERT_OK(geometry->parseFromQuery(spec.firstElement()));
+    return geometry;
+}
+
+std::unique_ptr<GeometryContainer> parsePoint(double lng, double lat) {
+    auto point = std::make_unique<GeometryContainer>();
+    ASSERT_OK(point->parseFromStorage(BSON("" << BSON("type"
+                                                      << "Point"
+                                                      << "coordinates" << BSON_ARRAY(lng << lat)))
+                                          .firstElement()));
+    return point;
+}
+
+TEST(PreparedS2Region, AgreesWithExactTest) {
+    auto geometry = parseQuery(makePolygonSpec(10, 20, 1, 100));
+    const S2Region& region = geometry->getS2Region();
+    const S2Polygon& polygon = static_cast<const S2Polygon&>(region);
+    PreparedS2Region prepared(region);
+
+    int numClassified = 0;
+    int numPoints = 0;
+    for (double lng = 8.5; lng <= 11.5; lng += 0.05) {
+        for (double lat = 18.5; lat <= 21.5; lat += 0.05) {
+            const S2Point point = S2LatLng::FromDegrees(lat, lng).ToPoint();
+            const S2Cell cell(point);
+            const bool exact = polygon.Contains(point) || polygon.MayIntersect(cell);
+            switch (prepared.locate(cell)) {
+                case PreparedS2Region::CellLocation::kInside:
+                    ASSERT_TRUE(exact) << lng << ", " << lat;
+                    ++numClassified;
+                    break;
+                case PreparedS2Region::CellLocation::kOutside:
+                    ASSERT_FALSE(exact) << lng << ", " << lat;
+                    ++numClassified;
+                    break;
+                case PreparedS2Region::CellLocation::kUnknown:
+                    break;
+            }
+            ++numPoints;
+        }
+    }
+
+    // Only points close to the boundary should need the exact test.
+    ASSERT_GT(numClassified, numPoints / 2);
+}
+
+TEST(GeometryContainer, PreparedContainsMatchesUnprepared) {
+    const BSONObj spec = makePolygonSpec(-73.9, 40.7, 0.2, 500);
+    auto prepared = parseQuery(spec);
+    prepared->prepareForPointTests();
+    ASSERT_TRUE(prepared->isPreparedForPointTests());
+
+    // Stored geometries are never prepared.
+    auto unprepared = std::make_unique<GeometryContainer>();
+    ASSERT_OK(unprepared->parseFromStorage(spec.firstElement()));
+
+    for (double lng = -74.2; lng <= -73.6; lng += 0.01) {
+        for (double lat = 40.4; lat <= 41.0; lat += 0.01) {
+            auto point = parsePoint(lng, lat);
+            ASSERT_EQ(unprepared->contains(*point), prepared->contains(*point))
+                << lng << ", " << lat;
+            ASSERT_EQ(unprepared->intersects(*point), prepared->intersects(*point))
+                << lng << ", " << lat;
+        }
+    }
+    ASSERT_FALSE(unprepared->isPreparedForPointTests());
+}
+
+TEST(GeoQueryCache, ReusesPreparedRegionForSameGeometry) {
+    GeoQueryCache cache(10, kMaxBytes);
+    const BSONObj spec = makePolygonSpec(0, 0, 1, 20);
+
+    auto first = cache.getPreparedRegion(*parseQuery(spec));
+    ASSERT(first);
+    ASSERT_EQ(first, cache.getPreparedRegion(*parseQuery(spec)));
+    ASSERT_NE(first, cache.getPreparedRegion(*parseQuery(makePolygonSpec(0, 0, 2, 20))));
+    ASSERT_EQ(2U, cache.size());
+}
+
+TEST(GeoQueryCache, CachedCoveringMatchesComputedCovering) {
+    GeoQueryCache cache(10, kMaxBytes);
+    const BSONObj spec = makePolygonSpec(5, 5, 1, 50);
+    const GeoQueryCache::CoveringParams params{0, 23, 20};
+    const GeoQueryCache::CoveringParams finerParams{0, 23, 40};
+
+    auto geometry = parseQuery(spec);
+    const auto expected = GeoQueryCache::computeCovering(geometry->getS2Region(), params);
+    ASSERT(expected == cache.getCovering(*geometry, params));
+    ASSERT(expected == cache.getCovering(*parseQuery(spec), params));
+    ASSERT_EQ(1U, cache.size());
+
+    // A covering computed with other parameters replaces the cached one.
+    const auto expectedFiner = GeoQueryCache::computeCovering(geometry->getS2Region(), finerParams);
+    ASSERT(expectedFiner == cache.getCovering(*geometry, finerParams));
+    ASSERT_EQ(1U, cache.size());
+}
+
+TEST(GeoQueryCache, EvictsLeastRecentlyUsedGeometry) {
+    GeoQueryCache cache(2, kMaxBytes);
+    const BSONObj first = makePolygonSpec(0, 0, 1, 10);
+
+    auto prepared = cache.getPreparedRegion(*parseQuery(first));
+    cache.getPreparedRegion(*parseQuery(makePolygonSpec(0, 0, 2, 10)));
+    cache.getPreparedRegion(*parseQuery(makePolygonSpec(0, 0, 3, 10)));
+    ASSERT_EQ(2U, cache.size());
+    ASSERT_NE(prepared, cache.getPreparedRegion(*parseQuery(first)));
+}
+
+TEST(GeoQueryCache, StaysWithinByteBudget) {
+    const BSONObj spec = makePolygonSpec(0, 0, 1, 200);
+    const size_t maxBytes = spec.objsize() * GeoQueryCache::kMaxEntryFractionOfBudget;
+    GeoQueryCache cache(1000, maxBytes);
+
+    for (int i = 1; i <= 100; ++i) {
+        ASSERT(cache.getPreparedRegion(*parseQuery(makePolygonSpec(0, 0, 0.1 * i, 200))));
+        ASSERT_LTE(cache.bytes(), maxBytes);
+    }
+    ASSERT_LT(cache.size(), 100U);
+    ASSERT_GT(cache.size(), 1U);
+
+    // The most recently used geometry is kept.
+    auto last = parseQuery(makePolygonSpec(0, 0, 0.1 * 100, 200));
+    ASSERT_EQ(cache.findPreparedRegion(*last), cache.getPreparedRegion(*last));
+
+    cache.clear();
+    ASSERT_EQ(0U, cache.bytes());
+}
+
+TEST(GeoQueryCache, DoesNotCacheGeometriesTooLargeForBudget) {
+    const BSONObj small = makePolygonSpec(0, 0, 1, 10);
+    const BSONObj large = makePolygonSpec(0, 0, 1, 1000);
+    GeoQueryCache cache(10, small.objsize() * GeoQueryCache::kMaxEntryFractionOfBudget);
+
+    ASSERT(cache.getPreparedRegion(*parseQuery(small)));
+    ASSERT_FALSE(cache.getPreparedRegion(*parseQuery(large)));
+    ASSERT_EQ(1U, cache.size());
+
+    // Coverings of geometries which are not cached are still computed.
+    const GeoQueryCache::CoveringParams params{0, 23, 20};
+    auto geometry = parseQuery(large);
+    ASSERT(GeoQueryCache::computeCovering(geometry->getS2Region(), params) ==
+           cache.getCovering(*geometry, params));
+    ASSERT_EQ(1U, cache.size());
+}
+
+TEST(GeoQueryCache, FindDoesNotPrepare) {
+    GeoQueryCache cache(10, kMaxBytes);
+    auto geometry = parseQuery(makePolygonSpec(0, 0, 1, 20));
+
+    ASSERT_FALSE(cache.findPreparedRegion(*geometry));
+    ASSERT_EQ(0U, cache.size());
+    auto prepared = cache.getPreparedRegion(*geometry);
+    ASSERT(prepared);
+    ASSERT_EQ(prepared, cache.findPreparedRegion(*parseQuery(makePolygonSpec(0, 0, 1, 20))));
+}
+
+TEST(GeometryContainer, PreparesAfterManyPointTestsOrOnCacheHit) {
+    // A geometry no other test uses, so that the process-wide cache does not have it yet.
+    const BSONObj spec = makePolygonSpec(42, -42, 0.5, 30);
+    auto point = parsePoint(42, -42);
+
+    auto first = parseQuery(spec);
+    for (int i = 1; i < GeometryContainer::kPointTestsBeforePreparing; ++i) {
+        ASSERT_TRUE(first->contains(*point));
+        ASSERT_FALSE(first->isPreparedForPointTests());
+    }
+    ASSERT_TRUE(first->contains(*point));
+    ASSERT_TRUE(first->isPreparedForPointTests());
+
+    // Another query on the same geometry finds it prepared on its first point test.
+    auto second = parseQuery(spec);
+    ASSERT_FALSE(second->isPreparedForPointTests());
+    ASSERT_TRUE(second->intersects(*point));
+    ASSERT_TRUE(second->isPreparedForPointTests());
+}
+
+TEST(GeoQueryCache, DoesNotCacheStoredOrDisabled) {
+    GeoQueryCache disabled(0, kMaxBytes);
+    ASSERT_FALSE(disabled.getPreparedRegion(*parseQuery(makePolygonSpec(0, 0, 1, 10))));
+    ASSERT_EQ(0U, disabled.size());
+
+    GeoQueryCache cache(10, kMaxBytes);
+    ASSERT_FALSE(cache.getPreparedRegion(*parsePoint(1, 1)));
+    ASSERT_EQ(0U, cache.size());
+}
+
+}  // namespace
+}  // namespace mongo
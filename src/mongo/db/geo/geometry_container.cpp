@@ -29,8 +29,10 @@
 
 #include "mongo/db/geo/geometry_container.h"
 
+#include "mongo/db/geo/geo_query_cache.h"
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/geo/geoparser.h"
+#include "mongo/db/geo/prepared_s2_region.h"
 #include "mongo/util/str.h"
 #include "mongo/util/transitional_tools_do_not_use/vector_spooling.h"
 
@@ -373,6 +375,17 @@ bool containsPoint(const S2Polygon& poly, const S2Cell& otherCell, const S2Point
 }
 
 bool GeometryContainer::contains(const S2Cell& otherCell, const S2Point& otherPoint) const {
+    if (auto preparedRegion = _preparedRegionForPointTest()) {
+        switch (preparedRegion->locate(otherCell)) {
+            case PreparedS2Region::CellLocation::kInside:
+                return true;
+            case PreparedS2Region::CellLocation::kOutside:
+                return false;
+            case PreparedS2Region::CellLocation::kUnknown:
+                break;
+        }
+    }
+
     if (nullptr != _polygon && (nullptr != _polygon->s2Polygon)) {
         return containsPoint(*_polygon->s2Polygon, otherCell, otherPoint);
     }
@@ -636,6 +649,17 @@ bool GeometryContainer::intersects(const MultiPolygonWithCRS& otherMultiPolygon)
 
 // Does this (GeometryContainer) intersect the provided data?
 bool GeometryContainer::intersects(const S2Cell& otherPoint) const {
+    if (auto preparedRegion = _preparedRegionForPointTest()) {
+        switch (preparedRegion->locate(otherPoint)) {
+            case PreparedS2Region::CellLocation::kInside:
+                return true;
+            case PreparedS2Region::CellLocation::kOutside:
+                return false;
+            case PreparedS2Region::CellLocation::kUnknown:
+                break;
+        }
+    }
+
     if (nullptr != _point) {
         return _point->cell.MayIntersect(otherPoint);
     } else if (nullptr != _line) {
@@ -1026,9 +1050,35 @@ Status GeometryContainer::parseFromQuery(const BSONElement& elem) {
         _r2Region.reset(new R2BoxRegion(this));
     }
 
+    _querySpec = elem.wrap();
     return status;
 }
 
+bool GeometryContainer::_isWorthPreparing() const {
+    // Only polygons are worth preparing: tests against points, lines and caps are already cheap.
+    return (nullptr != _polygon && nullptr != _polygon->s2Polygon) || nullptr != _multiPolygon;
+}
+
+void GeometryContainer::prepareForPointTests() const {
+    if (_isWorthPreparing()) {
+        _preparedRegion = GeoQueryCache::get().getPreparedRegion(*this);
+    }
+}
+
+const PreparedS2Region* GeometryContainer::_preparedRegionForPointTest() const {
+    if (_preparedRegion || _numPointTests > kPointTestsBeforePreparing) {
+        return _preparedRegion.get();
+    }
+
+    ++_numPointTests;
+    if (_numPointTests == 1 && _isWorthPreparing()) {
+        _preparedRegion = GeoQueryCache::get().findPreparedRegion(*this);
+    } else if (_numPointTests == kPointTestsBeforePreparing) {
+        prepareForPointTests();
+    }
+    return _preparedRegion.get();
+}
+
 // Examples:
 // { location: <GeoJSON> }
 // { location: [1, 2] }
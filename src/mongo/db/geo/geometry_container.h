@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "mongo/db/geo/shapes.h"
@@ -36,11 +37,15 @@
 
 namespace mongo {
 
+class PreparedS2Region;
+
 class GeometryContainer {
     GeometryContainer(const GeometryContainer&) = delete;
     GeometryContainer& operator=(const GeometryContainer&) = delete;
 
 public:
+    static constexpr int kPointTestsBeforePreparing = 64;
+
     /**
      * Creates an empty geometry container which may then be loaded from BSON or directly.
      */
@@ -117,6 +122,30 @@ public:
     bool hasR2Region() const;
     const R2Region& getR2Region() const;
 
+    /**
+     * Returns the owned geo specifier this geometry was parsed from by parseFromQuery(), such as
+     * {$geometry: {...}}, or an empty object otherwise.
+     */
+    const BSONObj& getQuerySpec() const {
+        return _querySpec;
+    }
+
+    /**
+     * Prepares a polygon query geometry for being tested against many points, reusing the
+     * prepared region of earlier queries on the same geometry. Must be called once the geometry
+     * is in its final CRS.
+     *
+     * Point tests call this on their own once a geometry has been tested against
+     * kPointTestsBeforePreparing points, since preparing a region costs about as much as that
+     * many exact tests. A geometry which an earlier query prepared is prepared on the first
+     * point test instead.
+     */
+    void prepareForPointTests() const;
+
+    bool isPreparedForPointTests() const {
+        return _preparedRegion != nullptr;
+    }
+
     // Returns a string related to the type of the geometry (for debugging queries)
     std::string getDebugType() const;
 
@@ -144,6 +173,11 @@ private:
     bool contains(const S2Polyline& otherLine) const;
     bool contains(const S2Polygon& otherPolygon) const;
 
+    bool _isWorthPreparing() const;
+
+    // Counts a point test and returns the prepared region to answer it with, if any.
+    const PreparedS2Region* _preparedRegionForPointTest() const;
+
     // Only one of these shared_ptrs should be non-NULL.  S2Region is a
     // superclass but it only supports testing against S2Cells.  We need
     // the most specific class we can get.
@@ -161,6 +195,14 @@ private:
     // TODO: _s2Region is currently generated immediately - don't necessarily need to do this
     std::unique_ptr<S2RegionUnion> _s2Region;
     std::unique_ptr<R2Region> _r2Region;
+
+    BSONObj _querySpec;
+
+    // Answers most point containment and intersection tests of a polygon query geometry without
+    // the exact test. Shared with other queries on the same geometry. Set lazily by the point
+    // tests, which only one thread runs against a given query geometry.
+    mutable std::shared_ptr<const PreparedS2Region> _preparedRegion;
+    mutable int _numPointTests = 0;
 };
 
 }  // namespace mongo
@@ -0,0 +1,69 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/geo/prepared_s2_region.h"
+
+#include "third_party/s2/s2regioncoverer.h"
+
+namespace mongo {
+
+namespace {
+// Finer coverings leave fewer points to the exact test, but take longer to compute and search.
+// The finest level matches the default finest level used to cover query regions for index bounds.
+constexpr int kMaxLevel = 23;
+constexpr int kMaxCells = 128;
+}  // namespace
+
+PreparedS2Region::PreparedS2Region(const S2Region& region) {
+    S2RegionCoverer coverer;
+    coverer.set_max_level(kMaxLevel);
+    coverer.set_max_cells(kMaxCells);
+    coverer.GetInteriorCellUnion(region, &_interior);
+    coverer.GetCellUnion(region, &_exterior);
+}
+
+PreparedS2Region::CellLocation PreparedS2Region::locate(const S2Cell& cell) const {
+    const S2CellId id = cell.id();
+    if (!_exterior.Intersects(id)) {
+        return CellLocation::kOutside;
+    }
+    if (_interior.Contains(id)) {
+        return CellLocation::kInside;
+    }
+    return CellLocation::kUnknown;
+}
+
+size_t PreparedS2Region::memUsageBytes() const {
+    return sizeof(*this) + (_interior.num_cells() + _exterior.num_cells()) * sizeof(S2CellId);
+}
+
+}  // namespace mongo
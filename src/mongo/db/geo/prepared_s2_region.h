@@ -0,0 +1,72 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "third_party/s2/s2cell.h"
+#include "third_party/s2/s2cellunion.h"
+#include "third_party/s2/s2region.h"
+
+namespace mongo {
+
+/**
+ * A query region prepared for many point tests, such as a $geoWithin polygon matched against
+ * every candidate document. An interior covering answers for cells which lie wholly inside the
+ * region and an exterior covering answers for cells which the region does not touch, both with
+ * a binary search, so that only cells near the boundary of the region need the exact test.
+ *
+ * Immutable once constructed, so one instance may be shared by concurrent queries.
+ */
+class PreparedS2Region {
+public:
+    enum class CellLocation {
+        // The cell lies wholly inside the region.
+        kInside,
+        // The cell does not intersect the region.
+        kOutside,
+        // The cell may straddle the boundary of the region; use the exact test.
+        kUnknown,
+    };
+
+    explicit PreparedS2Region(const S2Region& region);
+
+    CellLocation locate(const S2Cell& cell) const;
+
+    /**
+     * Returns the approximate number of bytes taken by this object.
+     */
+    size_t memUsageBytes() const;
+
+private:
+    S2CellUnion _interior;
+    S2CellUnion _exterior;
+};
+
+}  // namespace mongo
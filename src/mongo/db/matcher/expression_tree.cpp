@@ -35,6 +35,8 @@
 #include "mongo/db/matcher/expression_always_boolean.h"
 #include "mongo/db/matcher/expression_path.h"
 #include "mongo/db/matcher/expression_text_base.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -47,6 +49,7 @@ ListOfMatchExpression::~ListOfMatchExpression() {
 
 void ListOfMatchExpression::add(MatchExpression* e) {
     verify(e);
+    _childrenChanged();
     _expressions.push_back(e);
 }
 
@@ -194,7 +197,328 @@ bool ListOfMatchExpression::equivalent(const MatchExpression* other) const {
 
 // -----
 
+namespace {
+// One in this many matches on each thread records which steps rejected the document.
+constexpr uint32_t kSampleInterval = 16;
+// The steps are reordered after this many sampled matches.
+constexpr uint64_t kReorderInterval = 256;
+// The evaluation order is packed into a single word, four bits per step.
+constexpr size_t kMaxReorderableSteps = 16;
+
+/**
+ * Returns true for leaves which cannot fail to evaluate and whose result only depends on the
+ * elements found at their path, so that they may be evaluated in any order and against the
+ * subdocument at a prefix of their path.
+ */
+bool isReorderableLeaf(const MatchExpression* expr) {
+    switch (expr->matchType()) {
+        case MatchExpression::EQ:
+        case MatchExpression::LTE:
+        case MatchExpression::LT:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+        case MatchExpression::REGEX:
+        case MatchExpression::MOD:
+        case MatchExpression::EXISTS:
+        case MatchExpression::MATCH_IN:
+        case MatchExpression::BITS_ALL_SET:
+        case MatchExpression::BITS_ALL_CLEAR:
+        case MatchExpression::BITS_ANY_SET:
+        case MatchExpression::BITS_ANY_CLEAR:
+        case MatchExpression::TYPE_OPERATOR:
+        case MatchExpression::SIZE:
+            return !expr->path().empty();
+        default:
+            return false;
+    }
+}
+
+uint64_t identityOrder(size_t numSteps) {
+    uint64_t order = 0;
+    for (size_t i = 0; i < std::min(numSteps, kMaxReorderableSteps); ++i) {
+        order |= uint64_t(i) << (4 * i);
+    }
+    return order;
+}
+}  // namespace
+
+/**
+ * How an AndMatchExpression evaluates its children when no MatchDetails are requested, in which
+ * case neither the order of evaluation nor the document each child sees is observable.
+ *
+ * Reorderable leaves (see isReorderableLeaf()) become steps. Leaves with dotted paths that start
+ * with the same field are merged into a single step which looks up the longest prefix they share
+ * once and evaluates copies of the leaves, rewritten to the rest of their paths, against the
+ * subdocument found there. If an array is found along the prefix the original leaves are used
+ * instead, since they would have to traverse it. Steps are periodically reordered so that those
+ * which most often reject a document, relative to the number of leaves they evaluate, run first.
+ * All other children run afterwards in their original order.
+ */
+class AndMatchExpression::MatchPlan {
+public:
+    explicit MatchPlan(const AndMatchExpression& expr) {
+        // Dotted leaves are grouped by their first field. Groups are keyed by the position of
+        // their first leaf so that steps start out in the children's order.
+        std::vector<std::vector<const MatchExpression*>> groups;
+        StringMap<size_t> groupForField;
+        for (size_t i = 0; i < expr.numChildren(); ++i) {
+            const MatchExpression* child = expr.getChild(i);
+            if (!isReorderableLeaf(child)) {
+                _pinned.push_back(child);
+                continue;
+            }
+            FieldRef path(child->path());
+            if (path.numParts() < 2) {
+                groups.push_back({child});
+                continue;
+            }
+            auto [it, inserted] =
+                groupForField.try_emplace(path.getPart(0).toString(), groups.size());
+            if (inserted) {
+                groups.emplace_back();
+            }
+            groups[it->second].push_back(child);
+        }
+
+        for (auto&& group : groups) {
+            if (group.size() < 2) {
+                _steps.push_back(std::make_unique<Step>(group.front()));
+                continue;
+            }
+            _steps.push_back(std::make_unique<Step>(group));
+            _hasSharedPrefix = true;
+        }
+
+        _canReorder = _steps.size() > 1 && _steps.size() <= kMaxReorderableSteps;
+        _order.store(identityOrder(_steps.size()));
+    }
+
+    /**
+     * Whether evaluating through the plan can do better than evaluating the children in order.
+     */
+    bool isUseful() const {
+        return _hasSharedPrefix || _canReorder;
+    }
+
+    bool matches(const MatchableDocument* doc) const {
+        static thread_local uint32_t numMatchesOnThread = 0;
+        const bool sampled = _canReorder && ++numMatchesOnThread % kSampleInterval == 0;
+        const BSONObj* obj = doc->getBSONObj();
+        const uint64_t order = _order.loadRelaxed();
+
+        for (size_t i = 0; i < _steps.size(); ++i) {
+            const Step& step = *_steps[_canReorder ? (order >> (4 * i)) & 0xF : i];
+            const bool matched = step.matches(doc, obj);
+            if (sampled) {
+                step.numEvaluated.fetchAndAddRelaxed(1);
+                if (!matched) {
+                    step.numRejected.fetchAndAddRelaxed(1);
+                }
+            }
+            if (!matched) {
+                if (sampled) {
+                    _recordSample();
+                }
+                return false;
+            }
+        }
+        if (sampled) {
+            _recordSample();
+        }
+
+        for (auto&& child : _pinned) {
+            if (!child->matches(doc, nullptr)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<const MatchExpression*> getEvaluationOrder() const {
+        const uint64_t order = _order.load();
+        std::vector<const MatchExpression*> out;
+        for (size_t i = 0; i < _steps.size(); ++i) {
+            const Step& step = *_steps[_canReorder ? (order >> (4 * i)) & 0xF : i];
+            out.insert(out.end(), step.originals.begin(), step.originals.end());
+        }
+        out.insert(out.end(), _pinned.begin(), _pinned.end());
+        return out;
+    }
+
+    std::vector<const MatchExpression*> getRewrittenLeaves() const {
+        std::vector<const MatchExpression*> out;
+        for (auto&& step : _steps) {
+            for (auto&& leaf : step->rewrittenLeaves) {
+                out.push_back(leaf.get());
+            }
+        }
+        return out;
+    }
+
+private:
+    struct Step {
+        explicit Step(const MatchExpression* leaf) : originals{leaf} {}
+
+        explicit Step(const std::vector<const MatchExpression*>& leaves) : originals(leaves) {
+            // The shared prefix is the longest common prefix of the leaves' paths, excluding the
+            // last field of each so that every rewritten leaf keeps a non-empty path.
+            std::vector<FieldRef> paths;
+            for (auto&& leaf : leaves) {
+                paths.emplace_back(leaf->path());
+            }
+            size_t prefixLength = paths.front().numParts() - 1;
+            for (auto&& path : paths) {
+                prefixLength = std::min(prefixLength, path.numParts() - 1);
+                prefixLength = std::min(prefixLength, paths.front().commonPrefixSize(path));
+            }
+            for (size_t i = 0; i < prefixLength; ++i) {
+                prefix.push_back(paths.front().getPart(i).toString());
+            }
+
+            // The rewritten leaves only refer to their paths, so the step owns them. Reserving
+            // up front keeps the strings from moving as more are added.
+            suffixes.reserve(leaves.size());
+            for (size_t i = 0; i < leaves.size(); ++i) {
+                suffixes.push_back(
+                    paths[i].dottedSubstring(prefixLength, paths[i].numParts()).toString());
+                auto rewritten = leaves[i]->shallowClone();
+                static_cast<PathMatchExpression*>(rewritten.get())->setPath(suffixes.back());
+                rewrittenLeaves.push_back(std::move(rewritten));
+            }
+        }
+
+        bool matches(const MatchableDocument* doc, const BSONObj* obj) const {
+            if (!prefix.empty() && obj) {
+                BSONObj subObj = *obj;
+                bool traversedArray = false;
+                for (auto&& field : prefix) {
+                    BSONElement elem = subObj[field];
+                    if (elem.type() == Array) {
+                        traversedArray = true;
+                        break;
+                    }
+                    // Scalars and missing fields have no subfields, like an empty object.
+                    subObj = elem.type() == Object ? elem.embeddedObject() : BSONObj();
+                    if (subObj.isEmpty()) {
+                        break;
+                    }
+                }
+
+                if (!traversedArray) {
+                    BSONMatchableDocument subDoc(subObj);
+                    for (auto&& leaf : rewrittenLeaves) {
+                        if (!leaf->matches(&subDoc, nullptr)) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+            }
+
+            for (auto&& leaf : originals) {
+                if (!leaf->matches(doc, nullptr)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        const std::vector<const MatchExpression*> originals;
+
+        // Empty unless several leaves were merged.
+        std::vector<std::string> prefix;
+        std::vector<std::string> suffixes;
+        std::vector<std::unique_ptr<MatchExpression>> rewrittenLeaves;
+
+        mutable AtomicWord<uint64_t> numEvaluated{0};
+        mutable AtomicWord<uint64_t> numRejected{0};
+    };
+
+    void _recordSample() const {
+        if (_numSampled.addAndFetch(1) % kReorderInterval == 0) {
+            _reorder();
+        }
+    }
+
+    /**
+     * Ranks the steps by the fraction of documents they rejected per leaf evaluated and halves
+     * the counters so that the ranking follows changes in the data. Concurrent reorders may
+     * interleave; each publishes a valid order.
+     */
+    void _reorder() const {
+        std::vector<double> scores(_steps.size());
+        for (size_t i = 0; i < _steps.size(); ++i) {
+            const Step& step = *_steps[i];
+            const auto evaluated = step.numEvaluated.loadRelaxed();
+            const auto rejected = step.numRejected.loadRelaxed();
+            scores[i] = (rejected + 1.0) / (evaluated + 2.0) / step.originals.size();
+            step.numEvaluated.store(evaluated / 2);
+            step.numRejected.store(rejected / 2);
+        }
+
+        const uint64_t current = _order.loadRelaxed();
+        std::vector<size_t> ranking;
+        for (size_t i = 0; i < _steps.size(); ++i) {
+            ranking.push_back((current >> (4 * i)) & 0xF);
+        }
+        std::stable_sort(ranking.begin(), ranking.end(), [&](size_t lhs, size_t rhs) {
+            return scores[lhs] > scores[rhs];
+        });
+
+        uint64_t order = 0;
+        for (size_t i = 0; i < ranking.size(); ++i) {
+            order |= uint64_t(ranking[i]) << (4 * i);
+        }
+        _order.store(order);
+    }
+
+    std::vector<std::unique_ptr<Step>> _steps;
+    std::vector<const MatchExpression*> _pinned;
+    bool _hasSharedPrefix = false;
+    bool _canReorder = false;
+
+    // The i-th step to evaluate is _steps[(_order >> 4 * i) & 0xF].
+    mutable AtomicWord<uint64_t> _order{0};
+    mutable AtomicWord<uint64_t> _numSampled{0};
+};
+
+AndMatchExpression::~AndMatchExpression() {
+    delete _matchPlan.load();
+}
+
+void AndMatchExpression::_childrenChanged() {
+    delete _matchPlan.swap(nullptr);
+}
+
+const AndMatchExpression::MatchPlan* AndMatchExpression::_getMatchPlan() const {
+    if (auto plan = _matchPlan.load()) {
+        return plan;
+    }
+
+    auto plan = std::make_unique<MatchPlan>(*this);
+    MatchPlan* expected = nullptr;
+    if (_matchPlan.compareAndSwap(&expected, plan.get())) {
+        return plan.release();
+    }
+    // Another thread built the plan first.
+    return expected;
+}
+
+std::vector<const MatchExpression*> AndMatchExpression::getEvaluationOrderForTest() const {
+    return _getMatchPlan()->getEvaluationOrder();
+}
+
+std::vector<const MatchExpression*> AndMatchExpression::getRewrittenLeavesForTest() const {
+    return _getMatchPlan()->getRewrittenLeaves();
+}
+
 bool AndMatchExpression::matches(const MatchableDocument* doc, MatchDetails* details) const {
+    if (!details && numChildren() > 1 && internalQueryEnableAdaptiveAndMatching.load()) {
+        if (auto plan = _getMatchPlan(); plan->isUseful()) {
+            return plan->matches(doc);
+        }
+    }
+
     for (size_t i = 0; i < numChildren(); i++) {
         if (!getChild(i)->matches(doc, details)) {
             if (details)
@@ -32,6 +32,7 @@
 #include <boost/optional.hpp>
 
 #include "mongo/db/matcher/expression.h"
+#include "mongo/platform/atomic_word.h"
 
 /**
  * this contains all Expessions that define the structure of the tree
@@ -54,6 +55,7 @@ public:
      * someone else has taken ownership
      */
     void clearAndRelease() {
+        _childrenChanged();
         _expressions.clear();
     }
 
@@ -69,6 +71,7 @@ public:
      * Replaces the ith child with nullptr, and releases ownership of the child.
      */
     virtual std::unique_ptr<MatchExpression> releaseChild(size_t i) {
+        _childrenChanged();
         auto child = std::unique_ptr<MatchExpression>(_expressions[i]);
         _expressions[i] = nullptr;
         return child;
@@ -78,12 +81,14 @@ public:
      * Removes the ith child, and releases ownership of the child.
      */
     virtual std::unique_ptr<MatchExpression> removeChild(size_t i) {
+        _childrenChanged();
         auto child = std::unique_ptr<MatchExpression>(_expressions[i]);
         _expressions.erase(_expressions.begin() + i);
         return child;
     }
 
     boost::optional<std::vector<MatchExpression*>&> getChildVector() final {
+        _childrenChanged();
         return _expressions;
     }
 
@@ -94,6 +99,12 @@ public:
     }
 
 protected:
+    /**
+     * Called before the list of children is modified, or handed out to be modified, so that
+     * subclasses can drop state derived from the children.
+     */
+    virtual void _childrenChanged() {}
+
     void _debugList(StringBuilder& debug, int indentationLevel) const;
 
     void _listToBSON(BSONArrayBuilder* out, bool includePath) const;
@@ -109,7 +120,7 @@ public:
     static constexpr StringData kName = "$and"_sd;
 
     AndMatchExpression() : ListOfMatchExpression(AND) {}
-    virtual ~AndMatchExpression() {}
+    virtual ~AndMatchExpression();
 
     virtual bool matches(const MatchableDocument* doc, MatchDetails* details = nullptr) const;
 
@@ -131,6 +142,29 @@ public:
     virtual void serialize(BSONObjBuilder* out, bool includePath) const;
 
     bool isTriviallyTrue() const final;
+
+    /**
+     * Returns the children in the order matches() currently evaluates them when no MatchDetails
+     * are requested. Children whose paths were merged into a shared prefix appear consecutively.
+     */
+    std::vector<const MatchExpression*> getEvaluationOrderForTest() const;
+
+    /**
+     * Returns the copies of the children whose paths were merged into a shared prefix, with their
+     * paths relative to that prefix.
+     */
+    std::vector<const MatchExpression*> getRewrittenLeavesForTest() const;
+
+private:
+    class MatchPlan;
+
+    void _childrenChanged() final;
+
+    const MatchPlan* _getMatchPlan() const;
+
+    // Built on the first call to matches() without MatchDetails and dropped whenever the children
+    // change. See MatchPlan.
+    mutable AtomicWord<MatchPlan*> _matchPlan{nullptr};
 };
 
 class OrMatchExpression : public ListOfMatchExpression {
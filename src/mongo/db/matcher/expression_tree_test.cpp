@@ -35,8 +35,12 @@
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/expression_tree.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -179,6 +183,132 @@ TEST(AndOp, ElemMatchKey) {
     ASSERT_EQUALS("1", details.elemMatchKey());
 }
 
+std::unique_ptr<MatchExpression> parseAnd(const BSONObj& query) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    auto expr = uassertStatusOK(MatchExpressionParser::parse(query, expCtx));
+    ASSERT_EQ(MatchExpression::AND, expr->matchType());
+    return expr;
+}
+
+/**
+ * Asserts that 'expr' gives the same result for 'doc' through its shared prefix and selectivity
+ * plan as when evaluated child by child, which happens when MatchDetails are requested.
+ */
+void assertPlanMatchesLikeChildren(const MatchExpression& expr, const BSONObj& doc) {
+    MatchDetails details;
+    ASSERT_EQ(expr.matchesBSON(doc, &details), expr.matchesBSON(doc, nullptr))
+        << "query: " << expr.toString() << " document: " << doc;
+}
+
+const std::vector<BSONObj> kSharedPrefixDocuments = {
+    fromjson("{}"),
+    fromjson("{z: 1}"),
+    fromjson("{a: 1, z: 1}"),
+    fromjson("{a: {b: 1}, z: 1}"),
+    fromjson("{a: {b: null}, z: 1}"),
+    fromjson("{a: {b: {}}, z: 1}"),
+    fromjson("{a: {b: {c: 2, d: 'x'}}, z: 1}"),
+    fromjson("{a: {b: {c: 2, d: 'x'}}, z: 2}"),
+    fromjson("{a: {b: {c: 2, d: 'x', e: 1}}, z: 1}"),
+    fromjson("{a: {b: {c: 0, d: 'x'}}, z: 1}"),
+    fromjson("{a: {b: {c: [0, 5], d: ['y', 'x']}}, z: 1}"),
+    fromjson("{a: [{b: {c: 2, d: 'x'}}], z: 1}"),
+    fromjson("{a: {b: [{c: 2, d: 'x'}]}, z: 1}"),
+    fromjson("{a: {b: [{c: 2}, {d: 'x'}]}, z: 1}"),
+    fromjson("{a: {'0': {b: {c: 2, d: 'x'}}}, z: 1}"),
+};
+
+TEST(AndOp, SharedPathPrefixMatchesLikeSeparateLeaves) {
+    const std::vector<BSONObj> queries = {
+        fromjson("{'a.b.c': {$gt: 1}, 'a.b.d': 'x', 'a.b.e': {$exists: false}, z: 1}"),
+        fromjson("{'a.b.c': null, 'a.b.d': {$exists: false}}"),
+        fromjson("{'a.b.c': {$in: [0, 2]}, 'a.b': {$type: 'object'}, 'a.b.d': {$regex: '^x'}}"),
+        fromjson("{'a.0.b.c': 2, 'a.0.b.d': 'x'}"),
+        fromjson("{'a.b.c': {$size: 2}, 'a.b.d': {$size: 2}, z: {$ne: 2}}"),
+    };
+
+    for (auto&& query : queries) {
+        auto expr = parseAnd(query);
+        for (auto&& doc : kSharedPrefixDocuments) {
+            assertPlanMatchesLikeChildren(*expr, doc);
+        }
+    }
+}
+
+TEST(AndOp, LeavesSharingAPrefixAreEvaluatedTogether) {
+    auto expr = parseAnd(fromjson("{'a.b.c': 1, z: 1, 'a.b.d': 1, 'a.e': 1}"));
+    auto andExpr = static_cast<AndMatchExpression*>(expr.get());
+
+    auto order = andExpr->getEvaluationOrderForTest();
+    ASSERT_EQ(4U, order.size());
+    ASSERT_EQ("a.b.c", order[0]->path());
+    ASSERT_EQ("a.b.d", order[1]->path());
+    ASSERT_EQ("a.e", order[2]->path());
+    ASSERT_EQ("z", order[3]->path());
+}
+
+TEST(AndOp, RewrittenLeavesOwnTheirPaths) {
+    auto expr = parseAnd(fromjson("{'a.b.c': 1, 'a.b.dd': {$gt: 2}, z: 1}"));
+    auto andExpr = static_cast<AndMatchExpression*>(expr.get());
+
+    auto leaves = andExpr->getRewrittenLeavesForTest();
+    ASSERT_EQ(2U, leaves.size());
+    ASSERT_EQ("c", leaves[0]->path());
+    ASSERT_EQ("dd", leaves[1]->path());
+
+    BSONObjBuilder builder;
+    for (auto&& leaf : leaves) {
+        leaf->serialize(&builder, true);
+    }
+    ASSERT_BSONOBJ_EQ(fromjson("{c: {$eq: 1}, dd: {$gt: 2}}"), builder.obj());
+
+    StringBuilder debug;
+    leaves[1]->debugString(debug);
+    ASSERT_STRING_CONTAINS(debug.str(), "dd $gt 2");
+}
+
+TEST(AndOp, MostSelectiveLeavesAreEvaluatedFirst) {
+    auto expr = parseAnd(fromjson("{x: {$gte: 0}, y: 5, $expr: {$eq: ['$y', 5]}}"));
+    auto andExpr = static_cast<AndMatchExpression*>(expr.get());
+    ASSERT_EQ("x", andExpr->getEvaluationOrderForTest()[0]->path());
+
+    // Every document passes the filter on 'x' but almost none passes the one on 'y'.
+    for (int i = 0; i < 10000; ++i) {
+        const bool selected = i % 1000 == 0;
+        const auto doc = BSON("x" << i << "y" << (selected ? 5 : 0));
+        ASSERT_EQ(selected, expr->matchesBSON(doc, nullptr));
+    }
+
+    auto order = andExpr->getEvaluationOrderForTest();
+    ASSERT_EQ("y", order[0]->path());
+    ASSERT_EQ("x", order[1]->path());
+    // Children which may not be reordered always come last.
+    ASSERT_EQ(MatchExpression::EXPRESSION, order[2]->matchType());
+}
+
+TEST(AndOp, ChangingChildrenRebuildsThePlan) {
+    BSONObj operands = BSON("$lt" << 5 << "$gt" << 1);
+    AndMatchExpression andOp;
+    andOp.add(new LTMatchExpression("a.b", operands["$lt"]));
+    andOp.add(new GTMatchExpression("a.c", operands["$gt"]));
+    ASSERT(andOp.matchesBSON(fromjson("{a: {b: 4, c: 2, d: 0}}"), nullptr));
+
+    andOp.add(new LTMatchExpression("a.d", operands["$gt"]));
+    ASSERT_EQ(3U, andOp.getEvaluationOrderForTest().size());
+    ASSERT(andOp.matchesBSON(fromjson("{a: {b: 4, c: 2, d: 0}}"), nullptr));
+    ASSERT_FALSE(andOp.matchesBSON(fromjson("{a: {b: 4, c: 2, d: 1}}"), nullptr));
+}
+
+TEST(AndOp, AdaptiveMatchingCanBeDisabled) {
+    internalQueryEnableAdaptiveAndMatching.store(false);
+    ON_BLOCK_EXIT([] { internalQueryEnableAdaptiveAndMatching.store(true); });
+
+    auto expr = parseAnd(fromjson("{'a.b.c': {$gt: 1}, 'a.b.d': 'x', z: 1}"));
+    for (auto&& doc : kSharedPrefixDocuments) {
+        assertPlanMatchesLikeChildren(*expr, doc);
+    }
+}
+
 TEST(OrOp, NoClauses) {
     OrMatchExpression orOp;
     ASSERT(!orOp.matchesBSON(BSONObj(), nullptr));
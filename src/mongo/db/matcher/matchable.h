@@ -44,6 +44,15 @@ public:
 
     virtual BSONObj toBSON() const = 0;
 
+    /**
+     * Returns the object backing this document if every path of the document is resolved by a
+     * BSONElementIterator over it, or nullptr otherwise. Matchers may then look up shared path
+     * prefixes in the object directly.
+     */
+    virtual const BSONObj* getBSONObj() const {
+        return nullptr;
+    }
+
     /**
      * The neewly returned ElementIterator is allowed to keep a pointer to path.
      * So the caller of this function should make sure path is in scope until
@@ -83,6 +92,10 @@ public:
         return _obj;
     }
 
+    const BSONObj* getBSONObj() const final {
+        return &_obj;
+    }
+
     virtual ElementIterator* allocateIterator(const ElementPath* path) const {
         if (_iteratorUsed)
             return new BSONElementIterator(path, _obj);
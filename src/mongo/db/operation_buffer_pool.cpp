@@ -0,0 +1,85 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/operation_buffer_pool.h"
+
+namespace mongo {
+
+const OperationContext::Decoration<OperationBufferPool> OperationBufferPool::get =
+    OperationContext::declareDecoration<OperationBufferPool>();
+
+OperationBufferPool::ScopedBufBuilder::ScopedBufBuilder(OperationBufferPool* pool) : _pool(pool) {
+    auto buf = _pool->acquire();
+    _acquiredCapacity = buf.capacity();
+    _builder.useSharedBuffer(std::move(buf));
+}
+
+OperationBufferPool::ScopedBufBuilder::~ScopedBufBuilder() {
+    // If the contents were handed off with release(), this returns a null buffer, which the pool
+    // ignores.
+    _pool->release(_builder.release(), _acquiredCapacity);
+}
+
+SharedBuffer OperationBufferPool::acquire() {
+    SharedBuffer buf;
+    if (!_cached.empty()) {
+        buf = std::move(_cached.back());
+        _cached.pop_back();
+        _cachedBytes -= buf.capacity();
+        _numReused++;
+    } else {
+        buf = SharedBuffer::allocate(kMinBufferSize);
+    }
+
+    _inUseBytes += buf.capacity();
+    _updatePeak();
+    return buf;
+}
+
+void OperationBufferPool::release(SharedBuffer buf, size_t acquiredCapacity) {
+    // The buffer may have grown while in use. Account for its final size before deciding whether
+    // to keep it.
+    _inUseBytes -= acquiredCapacity;
+    _inUseBytes += buf.capacity();
+    _updatePeak();
+    _inUseBytes -= buf.capacity();
+
+    if (!buf || buf.isShared() || buf.capacity() > kMaxCachedBufferSize ||
+        _cached.size() >= kMaxCachedBuffers) {
+        return;
+    }
+
+    _cachedBytes += buf.capacity();
+    _cached.push_back(std::move(buf));
+}
+
+}  // namespace mongo
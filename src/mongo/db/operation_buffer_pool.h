@@ -0,0 +1,130 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "mongo/bson/util/builder.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/util/shared_buffer.h"
+
+namespace mongo {
+
+/**
+ * A per-operation cache of the buffers behind temporary BufBuilders. Code which builds a
+ * throwaway BSON object for every document it processes, such as the $match stage serializing its
+ * input for matching, can draw its buffers from here instead of allocating, and growing through
+ * reallocation, a new one each time. The cached buffers are released in bulk when the operation
+ * ends.
+ *
+ * A buffer is only taken back if nothing else references it, so it is always safe to let an
+ * object built in a pooled buffer escape with BufBuilder::release() or BSONObjBuilder::obj(): the
+ * buffer then simply isn't recycled.
+ *
+ * Not thread safe. Must only be used by the thread running the operation.
+ */
+class OperationBufferPool {
+    OperationBufferPool(const OperationBufferPool&) = delete;
+    OperationBufferPool& operator=(const OperationBufferPool&) = delete;
+
+public:
+    // Bounds on what the pool keeps cached, so that an operation which once built a large object
+    // does not pin that memory for the rest of its life.
+    static constexpr size_t kMaxCachedBuffers = 8;
+    static constexpr size_t kMaxCachedBufferSize = 1024 * 1024;
+    static constexpr size_t kMinBufferSize = 512;
+
+    /**
+     * A BufBuilder backed by a buffer from the pool, to which the buffer is returned when this
+     * object goes out of scope.
+     */
+    class ScopedBufBuilder {
+        ScopedBufBuilder(const ScopedBufBuilder&) = delete;
+        ScopedBufBuilder& operator=(const ScopedBufBuilder&) = delete;
+
+    public:
+        explicit ScopedBufBuilder(OperationBufferPool* pool);
+        ~ScopedBufBuilder();
+
+        BufBuilder& get() {
+            return _builder;
+        }
+
+    private:
+        OperationBufferPool* _pool;
+        BufBuilder _builder{0};
+        size_t _acquiredCapacity;
+    };
+
+    static const OperationContext::Decoration<OperationBufferPool> get;
+
+    OperationBufferPool() = default;
+
+    /**
+     * Returns an exclusively owned buffer, reusing a cached one when possible.
+     */
+    SharedBuffer acquire();
+
+    /**
+     * Gives back a buffer obtained from acquire(), which had 'acquiredCapacity' bytes when it was
+     * acquired. It is cached for reuse if nothing else references it and the cache has room.
+     */
+    void release(SharedBuffer buf, size_t acquiredCapacity);
+
+    /**
+     * The largest number of bytes the pool's buffers, whether cached or in use, have held at once
+     * during this operation. Zero if the pool was never used.
+     */
+    size_t peakBytes() const {
+        return _peakBytes;
+    }
+
+    /**
+     * The number of times acquire() was satisfied from the cache.
+     */
+    size_t numReused() const {
+        return _numReused;
+    }
+
+private:
+    void _updatePeak() {
+        _peakBytes = std::max(_peakBytes, _cachedBytes + _inUseBytes);
+    }
+
+    std::vector<SharedBuffer> _cached;
+    size_t _cachedBytes = 0;
+    size_t _inUseBytes = 0;
+    size_t _peakBytes = 0;
+    size_t _numReused = 0;
+};
+
+}  // namespace mongo
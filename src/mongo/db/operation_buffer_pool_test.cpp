@@ -0,0 +1,136 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/operation_buffer_pool.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(OperationBufferPoolTest, ReusesBufferOfScopedBuilder) {
+    OperationBufferPool pool;
+
+    const char* firstBuffer;
+    {
+        OperationBufferPool::ScopedBufBuilder buffer(&pool);
+        BSONObjBuilder builder(buffer.get());
+        builder.append("a", 1);
+        BSONObj obj = builder.done();
+        ASSERT_BSONOBJ_EQ(obj, BSON("a" << 1));
+        firstBuffer = buffer.get().buf();
+    }
+
+    {
+        OperationBufferPool::ScopedBufBuilder buffer(&pool);
+        ASSERT_EQ(0, buffer.get().len());
+        ASSERT_EQ(firstBuffer, buffer.get().buf());
+    }
+
+    ASSERT_EQ(1U, pool.numReused());
+    ASSERT_EQ(OperationBufferPool::kMinBufferSize, pool.peakBytes());
+}
+
+TEST(OperationBufferPoolTest, DoesNotReuseBufferWhichEscaped) {
+    OperationBufferPool pool;
+
+    BSONObj escaped;
+    {
+        OperationBufferPool::ScopedBufBuilder buffer(&pool);
+        BSONObjBuilder builder(buffer.get());
+        builder.append("a", 1);
+        builder.done();
+        escaped = BSONObj(buffer.get().release());
+    }
+
+    {
+        OperationBufferPool::ScopedBufBuilder buffer(&pool);
+        BSONObjBuilder builder(buffer.get());
+        builder.append("b", 2);
+        builder.done();
+    }
+
+    ASSERT_EQ(0U, pool.numReused());
+    ASSERT_BSONOBJ_EQ(escaped, BSON("a" << 1));
+}
+
+TEST(OperationBufferPoolTest, DoesNotReuseBufferStillReferenced) {
+    OperationBufferPool pool;
+
+    auto buf = pool.acquire();
+    SharedBuffer other = buf;
+    pool.release(std::move(buf), OperationBufferPool::kMinBufferSize);
+
+    // The copy still references the buffer, so the pool must hand out a different one.
+    auto next = pool.acquire();
+    ASSERT_NE(other.get(), next.get());
+    ASSERT_EQ(0U, pool.numReused());
+}
+
+TEST(OperationBufferPoolTest, TracksPeakBytesAcrossGrowth) {
+    OperationBufferPool pool;
+
+    {
+        OperationBufferPool::ScopedBufBuilder buffer(&pool);
+        buffer.get().skip(4 * 1024);
+    }
+    const auto peak = pool.peakBytes();
+    ASSERT_GTE(peak, 4U * 1024);
+
+    // The grown buffer is cached and reused without raising the peak.
+    {
+        OperationBufferPool::ScopedBufBuilder buffer(&pool);
+        buffer.get().skip(4 * 1024);
+    }
+    ASSERT_EQ(1U, pool.numReused());
+    ASSERT_EQ(peak, pool.peakBytes());
+}
+
+TEST(OperationBufferPoolTest, BoundsCachedBuffers) {
+    OperationBufferPool pool;
+
+    std::vector<SharedBuffer> buffers;
+    for (size_t i = 0; i < OperationBufferPool::kMaxCachedBuffers + 2; ++i) {
+        buffers.push_back(pool.acquire());
+    }
+    for (auto&& buf : buffers) {
+        pool.release(std::move(buf), OperationBufferPool::kMinBufferSize);
+    }
+
+    for (size_t i = 0; i < OperationBufferPool::kMaxCachedBuffers + 2; ++i) {
+        pool.acquire();
+    }
+    ASSERT_EQ(OperationBufferPool::kMaxCachedBuffers, pool.numReused());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -138,17 +138,22 @@ StatusWith<Value> extractElementAlongNonArrayPath(const Document& doc, const Fie
 
 BSONObj documentToBsonWithPaths(const Document& input, const std::set<std::string>& paths) {
     BSONObjBuilder outputBuilder;
+    documentToBsonWithPaths(input, paths, &outputBuilder);
+    return outputBuilder.obj();
+}
+
+void documentToBsonWithPaths(const Document& input,
+                             const std::set<std::string>& paths,
+                             BSONObjBuilder* builder) {
     for (auto&& path : paths) {
         // getNestedField does not handle dotted paths correctly, so instead of retrieving the
         // entire path, we just extract the first element of the path.
         const auto prefix = FieldPath::extractFirstFieldFromDottedPath(path);
-        if (!outputBuilder.hasField(prefix)) {
+        if (!builder->hasField(prefix)) {
             // Avoid adding the same prefix twice.
-            input.getField(prefix).addToBsonObj(&outputBuilder, prefix);
+            input.getField(prefix).addToBsonObj(builder, prefix);
         }
     }
-
-    return outputBuilder.obj();
 }
 
 }  // namespace document_path_support
@@ -65,6 +65,13 @@ StatusWith<Value> extractElementAlongNonArrayPath(const Document& doc, const Fie
  */
 BSONObj documentToBsonWithPaths(const Document&, const std::set<std::string>& paths);
 
+/**
+ * Same as above, but appends the extracted paths to 'builder'.
+ */
+void documentToBsonWithPaths(const Document&,
+                             const std::set<std::string>& paths,
+                             BSONObjBuilder* builder);
+
 /**
  * Extracts 'paths' from the input document to a flat document.
  *
@@ -42,6 +42,7 @@
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/operation_buffer_pool.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
@@ -86,16 +87,37 @@ DocumentSource::GetNextResult DocumentSourceMatch::doGetNext() {
     // The user facing error should have been generated earlier.
     massert(17309, "Should never call getNext on a $match stage with $text clause", !_isTextQuery);
 
+    // Some tests run pipelines without an OperationContext. Those still reuse buffers within
+    // this call.
+    OperationBufferPool localBufferPool;
+    auto bufferPool =
+        pExpCtx->opCtx ? &OperationBufferPool::get(pExpCtx->opCtx) : &localBufferPool;
     auto nextInput = pSource->getNext();
     for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
+        const Document& doc = nextInput.getDocument();
+
         // MatchExpression only takes BSON documents, so we have to make one. As an optimization,
-        // only serialize the fields we need to do the match.
-        BSONObj toMatch = _dependencies.needWholeDocument
-            ? nextInput.getDocument().toBson()
-            : document_path_support::documentToBsonWithPaths(nextInput.getDocument(),
-                                                             _dependencies.fields);
+        // only serialize the fields we need to do the match. Unless the document is already backed
+        // by unmodified BSON, the object is only needed for this match, so build it in a buffer
+        // reused across documents rather than allocating a new one each time.
+        boost::optional<BSONObj> toMatch;
+        boost::optional<OperationBufferPool::ScopedBufBuilder> buffer;
+        if (_dependencies.needWholeDocument) {
+            toMatch = doc.toBsonIfTriviallyConvertible();
+        }
+        if (!toMatch) {
+            buffer.emplace(bufferPool);
+            BSONObjBuilder builder(buffer->get());
+            if (_dependencies.needWholeDocument) {
+                doc.toBson(&builder);
+            } else {
+                document_path_support::documentToBsonWithPaths(
+                    doc, _dependencies.fields, &builder);
+            }
+            toMatch = builder.done();
+        }
 
-        if (_expression->matchesBSON(toMatch)) {
+        if (_expression->matchesBSON(*toMatch)) {
             return nextInput;
         }
 
@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/expression_compiler.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Arithmetic and date math of the kind $project and $addFields compute per document, indexed by
+ * the benchmark argument.
+ */
+std::vector<BSONObj> benchmarkExpressions() {
+    return {
+        BSON("" << BSON("$add" << BSON_ARRAY("$a"
+                                             << "$b"))),
+        BSON("" << BSON("$multiply" << BSON_ARRAY(BSON("$add" << BSON_ARRAY("$a"
+                                                                            << "$b"))
+                                                  << BSON("$subtract" << BSON_ARRAY("$c" << 1))))),
+        BSON("" << BSON("$divide" << BSON_ARRAY(BSON("$subtract" << BSON_ARRAY("$price"
+                                                                               << "$cost"))
+                                                << "$price"))),
+        BSON("" << BSON("$subtract" << BSON_ARRAY("$ts" << BSON("$multiply" << BSON_ARRAY(
+                                                                    "$a" << 1000))))),
+        BSON("" << BSON("$add" << BSON_ARRAY("$nested.x"
+                                             << "$nested.y"
+                                             << "$a"
+                                             << "$b"
+                                             << 0.5))),
+    };
+}
+
+Document benchmarkDocument() {
+    return Document{{"a", 3},
+                    {"b", 4LL},
+                    {"c", 2.5},
+                    {"price", 19.99},
+                    {"cost", 12.5},
+                    {"ts", Date_t::fromMillisSinceEpoch(1'600'000'000'000LL)},
+                    {"nested", Document{{"x", 1}, {"y", 2}}}};
+}
+
+void runExpressionBenchmark(benchmark::State& state, bool compiled) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    const auto spec = benchmarkExpressions()[state.range(0)];
+    auto expr =
+        Expression::parseOperand(expCtx, spec.firstElement(), expCtx->variablesParseState)
+            ->optimize();
+    auto program = CompiledExpression::compile(expr);
+    invariant(program);
+    const auto doc = benchmarkDocument();
+
+    for (auto _ : state) {
+        if (compiled) {
+            benchmark::DoNotOptimize(program->evaluate(doc, &expCtx->variables));
+        } else {
+            benchmark::DoNotOptimize(expr->evaluate(doc, &expCtx->variables));
+        }
+    }
+}
+
+void BM_interpretExpression(benchmark::State& state) {
+    runExpressionBenchmark(state, false);
+}
+
+void BM_compiledExpression(benchmark::State& state) {
+    runExpressionBenchmark(state, true);
+}
+
+BENCHMARK(BM_interpretExpression)->DenseRange(0, 4);
+BENCHMARK(BM_compiledExpression)->DenseRange(0, 4);
+
+}  // namespace
+}  // namespace mongo
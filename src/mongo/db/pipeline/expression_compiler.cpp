@@ -0,0 +1,375 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/expression_compiler.h"
+
+#include <boost/container/small_vector.hpp>
+#include <cmath>
+#include <limits>
+
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/platform/overflow_arithmetic.h"
+#include "mongo/util/summation.h"
+
+namespace mongo {
+
+namespace {
+// Enough registers for typical $project/$addFields arithmetic without a heap allocation.
+constexpr size_t kInlineRegisters = 16;
+
+bool isNumber(BSONType type) {
+    return type == NumberInt || type == NumberLong || type == NumberDouble;
+}
+}  // namespace
+
+std::unique_ptr<CompiledExpression> CompiledExpression::compile(
+    boost::intrusive_ptr<Expression> expr) {
+    if (!internalQueryEnableExpressionCompilation.load()) {
+        return nullptr;
+    }
+
+    // A lone constant or field path is already as cheap to interpret as it would be to run.
+    auto root = expr.get();
+    if (!dynamic_cast<ExpressionAdd*>(root) && !dynamic_cast<ExpressionSubtract*>(root) &&
+        !dynamic_cast<ExpressionMultiply*>(root) && !dynamic_cast<ExpressionDivide*>(root)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<CompiledExpression> compiled(new CompiledExpression(std::move(expr)));
+    if (!compiled->_compileNode(root)) {
+        return nullptr;
+    }
+    return compiled;
+}
+
+boost::optional<uint32_t> CompiledExpression::_compileNode(const Expression* expr) {
+    if (auto constant = dynamic_cast<const ExpressionConstant*>(expr)) {
+        Register reg;
+        if (!_toRegister(constant->getValue(), &reg)) {
+            return boost::none;
+        }
+        _constants.push_back(reg);
+        _program.push_back(
+            {OpCode::kLoadConstant, static_cast<uint32_t>(_constants.size() - 1), 0});
+        return static_cast<uint32_t>(_program.size() - 1);
+    }
+
+    if (auto fieldPath = dynamic_cast<const ExpressionFieldPath*>(expr)) {
+        // Other variables may be rebound per document, and the whole of ROOT is not a number.
+        if (!fieldPath->isRootFieldPath() || fieldPath->getFieldPath().getPathLength() < 2) {
+            return boost::none;
+        }
+        _paths.push_back(fieldPath->getFieldPath());
+        _program.push_back({OpCode::kLoadField, static_cast<uint32_t>(_paths.size() - 1), 0});
+        return static_cast<uint32_t>(_program.size() - 1);
+    }
+
+    if (dynamic_cast<const ExpressionAdd*>(expr)) {
+        return _compileOperator(OpCode::kAdd, expr->getChildren());
+    } else if (dynamic_cast<const ExpressionSubtract*>(expr)) {
+        return _compileOperator(OpCode::kSubtract, expr->getChildren());
+    } else if (dynamic_cast<const ExpressionMultiply*>(expr)) {
+        return _compileOperator(OpCode::kMultiply, expr->getChildren());
+    } else if (dynamic_cast<const ExpressionDivide*>(expr)) {
+        return _compileOperator(OpCode::kDivide, expr->getChildren());
+    }
+
+    return boost::none;
+}
+
+boost::optional<uint32_t> CompiledExpression::_compileOperator(
+    OpCode op, const std::vector<boost::intrusive_ptr<Expression>>& args) {
+    std::vector<uint32_t> operands;
+    operands.reserve(args.size());
+    for (auto&& arg : args) {
+        auto reg = _compileNode(arg.get());
+        if (!reg) {
+            return boost::none;
+        }
+        operands.push_back(*reg);
+    }
+
+    const auto firstOperand = static_cast<uint32_t>(_operands.size());
+    _operands.insert(_operands.end(), operands.begin(), operands.end());
+    _program.push_back({op, firstOperand, static_cast<uint32_t>(operands.size())});
+    return static_cast<uint32_t>(_program.size() - 1);
+}
+
+Value CompiledExpression::evaluate(const Document& root, Variables* variables) const {
+    if (auto result = evaluateCompiled(root)) {
+        return std::move(*result);
+    }
+    return _expr->evaluate(root, variables);
+}
+
+boost::optional<Value> CompiledExpression::evaluateCompiled(const Document& root) const {
+    boost::container::small_vector<Register, kInlineRegisters> registers(_program.size());
+
+    for (size_t i = 0; i < _program.size(); ++i) {
+        const Instruction& instruction = _program[i];
+        const uint32_t* operands = _operands.data() + instruction.arg;
+        Register* out = &registers[i];
+
+        bool compiled = false;
+        switch (instruction.op) {
+            case OpCode::kLoadConstant:
+                *out = _constants[instruction.arg];
+                compiled = true;
+                break;
+            case OpCode::kLoadField:
+                compiled = _loadField(_paths[instruction.arg], root, out);
+                break;
+            case OpCode::kAdd:
+                compiled = _add(registers.data(), operands, instruction.numArgs, out);
+                break;
+            case OpCode::kSubtract:
+                compiled = _subtract(registers[operands[0]], registers[operands[1]], out);
+                break;
+            case OpCode::kMultiply:
+                compiled = _multiply(registers.data(), operands, instruction.numArgs, out);
+                break;
+            case OpCode::kDivide:
+                compiled = _divide(registers[operands[0]], registers[operands[1]], out);
+                break;
+        }
+
+        if (!compiled) {
+            return boost::none;
+        }
+    }
+
+    return _toValue(registers.back());
+}
+
+bool CompiledExpression::_toRegister(const Value& val, Register* out) {
+    switch (val.getType()) {
+        case NumberInt:
+            out->type = NumberInt;
+            out->integral = val.getInt();
+            return true;
+        case NumberLong:
+            out->type = NumberLong;
+            out->integral = val.getLong();
+            return true;
+        case NumberDouble:
+            out->type = NumberDouble;
+            out->dbl = val.getDouble();
+            return true;
+        case Date:
+            out->type = Date;
+            out->integral = val.getDate().toMillisSinceEpoch();
+            return true;
+        default:
+            return false;
+    }
+}
+
+Value CompiledExpression::_toValue(const Register& reg) {
+    switch (reg.type) {
+        case NumberInt:
+            return Value(static_cast<int>(reg.integral));
+        case NumberLong:
+            return Value(reg.integral);
+        case NumberDouble:
+            return Value(reg.dbl);
+        case Date:
+            return Value(Date_t::fromMillisSinceEpoch(reg.integral));
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+namespace {
+double coerceToDouble(BSONType type, long long integral, double dbl) {
+    return type == NumberDouble ? dbl : static_cast<double>(integral);
+}
+}  // namespace
+
+bool CompiledExpression::_loadField(const FieldPath& path, const Document& root, Register* out) {
+    Value val = root[path.getFieldName(1)];
+    for (size_t i = 2; i < path.getPathLength(); ++i) {
+        // Arrays fan out into an array of results, which is never a number.
+        if (val.getType() != Object) {
+            return false;
+        }
+        val = val.getDocument()[path.getFieldName(i)];
+    }
+    return _toRegister(val, out);
+}
+
+bool CompiledExpression::_add(const Register* registers,
+                              const uint32_t* operands,
+                              size_t numOperands,
+                              Register* out) {
+    DoubleDoubleSummation total;
+    BSONType totalType = NumberInt;
+    bool haveDate = false;
+
+    for (size_t i = 0; i < numOperands; ++i) {
+        const Register& arg = registers[operands[i]];
+        switch (arg.type) {
+            case NumberDouble:
+                total.addDouble(arg.dbl);
+                totalType = NumberDouble;
+                break;
+            case NumberLong:
+                total.addLong(arg.integral);
+                if (totalType == NumberInt)
+                    totalType = NumberLong;
+                break;
+            case NumberInt:
+                // Like the interpreter, which adds ints as doubles.
+                total.addDouble(arg.integral);
+                break;
+            case Date:
+                if (haveDate) {
+                    return false;
+                }
+                haveDate = true;
+                total.addLong(arg.integral);
+                break;
+            default:
+                MONGO_UNREACHABLE;
+        }
+    }
+
+    if (haveDate) {
+        if (!total.fitsLong()) {
+            return false;
+        }
+        out->type = Date;
+        out->integral = total.getLong();
+        return true;
+    }
+
+    if (totalType != NumberDouble && total.fitsLong()) {
+        const long long sum = total.getLong();
+        out->type = (totalType == NumberInt && sum == static_cast<int>(sum)) ? NumberInt
+                                                                             : NumberLong;
+        out->integral = sum;
+        return true;
+    }
+
+    out->type = NumberDouble;
+    out->dbl = total.getDouble();
+    return true;
+}
+
+bool CompiledExpression::_subtract(const Register& lhs, const Register& rhs, Register* out) {
+    if (isNumber(lhs.type) && isNumber(rhs.type)) {
+        if (lhs.type == NumberDouble || rhs.type == NumberDouble) {
+            out->type = NumberDouble;
+            out->dbl = coerceToDouble(lhs.type, lhs.integral, lhs.dbl) -
+                coerceToDouble(rhs.type, rhs.integral, rhs.dbl);
+            return true;
+        }
+
+        long long diff;
+        if (overflow::sub(lhs.integral, rhs.integral, &diff)) {
+            // Only longs can overflow, in which case the interpreter switches to doubles.
+            out->type = NumberDouble;
+            out->dbl = static_cast<double>(lhs.integral) - static_cast<double>(rhs.integral);
+            return true;
+        }
+        const bool bothInts = lhs.type == NumberInt && rhs.type == NumberInt;
+        out->type = (bothInts && diff == static_cast<int>(diff)) ? NumberInt : NumberLong;
+        out->integral = diff;
+        return true;
+    }
+
+    // A date minus a date is a number of milliseconds, a date minus an integral number of
+    // milliseconds is a date. Leave doubles and overflow to the interpreter.
+    if (lhs.type != Date || (rhs.type != Date && rhs.type != NumberInt && rhs.type != NumberLong)) {
+        return false;
+    }
+    long long diff;
+    if (rhs.integral == std::numeric_limits<long long>::min() ||
+        overflow::sub(lhs.integral, rhs.integral, &diff)) {
+        return false;
+    }
+    out->type = rhs.type == Date ? NumberLong : Date;
+    out->integral = diff;
+    return true;
+}
+
+bool CompiledExpression::_multiply(const Register* registers,
+                                   const uint32_t* operands,
+                                   size_t numOperands,
+                                   Register* out) {
+    double doubleProduct = 1;
+    long long longProduct = 1;
+    BSONType productType = NumberInt;
+
+    for (size_t i = 0; i < numOperands; ++i) {
+        const Register& arg = registers[operands[i]];
+        if (!isNumber(arg.type)) {
+            return false;
+        }
+
+        const double argAsDouble = coerceToDouble(arg.type, arg.integral, arg.dbl);
+        productType = Value::getWidestNumeric(productType, arg.type);
+        doubleProduct *= argAsDouble;
+        if (productType != NumberDouble) {
+            if (!std::isfinite(argAsDouble) ||
+                overflow::mul(longProduct, arg.integral, &longProduct)) {
+                productType = NumberDouble;
+            }
+        }
+    }
+
+    if (productType == NumberDouble) {
+        out->type = NumberDouble;
+        out->dbl = doubleProduct;
+    } else {
+        out->type = (productType == NumberInt && longProduct == static_cast<int>(longProduct))
+            ? NumberInt
+            : NumberLong;
+        out->integral = longProduct;
+    }
+    return true;
+}
+
+bool CompiledExpression::_divide(const Register& lhs, const Register& rhs, Register* out) {
+    if (!isNumber(lhs.type) || !isNumber(rhs.type)) {
+        return false;
+    }
+
+    const double denom = coerceToDouble(rhs.type, rhs.integral, rhs.dbl);
+    if (denom == 0.0) {
+        return false;
+    }
+    out->type = NumberDouble;
+    out->dbl = coerceToDouble(lhs.type, lhs.integral, lhs.dbl) / denom;
+    return true;
+}
+
+}  // namespace mongo
@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/intrusive_ptr.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/field_path.h"
+
+namespace mongo {
+
+/**
+ * A flat, register-based program computing the same result as an optimized Expression tree.
+ *
+ * Only arithmetic over constants and field paths of the ROOT document is lowered: $add,
+ * $subtract, $multiply and $divide whose operands are themselves compilable. Each instruction
+ * writes one unboxed numeric or date register, so no intermediate Value is materialized and no
+ * virtual dispatch happens per node. Whenever an operand turns out not to be an int, long, double
+ * or (where the operator accepts one) date, or the operation would raise an error, evaluation
+ * gives up and returns the result of interpreting the original tree. The compiled subset has no
+ * side effects, so evaluating it again is always safe and produces the interpreter's exact
+ * result, including its error.
+ */
+class CompiledExpression {
+public:
+    /**
+     * Returns a compiled program for 'expr' or nullptr if 'expr' is not worth compiling, either
+     * because its root is not an arithmetic operator or because some node of the tree is outside
+     * the compiled subset. Also returns nullptr if compilation is disabled by the
+     * 'internalQueryEnableExpressionCompilation' server parameter.
+     */
+    static std::unique_ptr<CompiledExpression> compile(boost::intrusive_ptr<Expression> expr);
+
+    /**
+     * Evaluates the program against 'root', falling back to the interpreter as described above.
+     */
+    Value evaluate(const Document& root, Variables* variables) const;
+
+    /**
+     * Runs the program without falling back to the interpreter. Returns boost::none if the
+     * interpreter would have to be used. Exposed for testing.
+     */
+    boost::optional<Value> evaluateCompiled(const Document& root) const;
+
+    size_t numInstructions() const {
+        return _program.size();
+    }
+
+    const boost::intrusive_ptr<Expression>& getExpression() const {
+        return _expr;
+    }
+
+private:
+    enum class OpCode : uint8_t { kLoadConstant, kLoadField, kAdd, kSubtract, kMultiply, kDivide };
+
+    /**
+     * The result of instruction i is stored in register i. For loads, 'arg' indexes '_constants'
+     * or '_paths'; for operators, the operand registers are '_operands[arg, arg + numArgs)'.
+     */
+    struct Instruction {
+        OpCode op;
+        uint32_t arg;
+        uint32_t numArgs;
+    };
+
+    /**
+     * An unboxed value. 'type' is one of NumberInt, NumberLong, NumberDouble or Date. Ints, longs
+     * and dates are held in 'integral', dates as milliseconds since the epoch.
+     */
+    struct Register {
+        BSONType type;
+        union {
+            long long integral;
+            double dbl;
+        };
+    };
+
+    explicit CompiledExpression(boost::intrusive_ptr<Expression> expr) : _expr(std::move(expr)) {}
+
+    /**
+     * Appends the instructions computing 'expr' and returns the register holding its result, or
+     * boost::none if 'expr' cannot be compiled.
+     */
+    boost::optional<uint32_t> _compileNode(const Expression* expr);
+    boost::optional<uint32_t> _compileOperator(
+        OpCode op, const std::vector<boost::intrusive_ptr<Expression>>& args);
+
+    static bool _toRegister(const Value& val, Register* out);
+    static Value _toValue(const Register& reg);
+
+    // Each of these mirrors the interpreter's evaluate() for the corresponding operator, returning
+    // false whenever the interpreter would be needed to produce the result or the error.
+    static bool _loadField(const FieldPath& path, const Document& root, Register* out);
+    static bool _add(const Register* registers,
+                     const uint32_t* operands,
+                     size_t numOperands,
+                     Register* out);
+    static bool _subtract(const Register& lhs, const Register& rhs, Register* out);
+    static bool _multiply(const Register* registers,
+                          const uint32_t* operands,
+                          size_t numOperands,
+                          Register* out);
+    static bool _divide(const Register& lhs, const Register& rhs, Register* out);
+
+    boost::intrusive_ptr<Expression> _expr;
+
+    std::vector<Instruction> _program;
+    std::vector<Register> _constants;
+    std::vector<FieldPath> _paths;
+    std::vector<uint32_t> _operands;
+};
+
+}  // namespace mongo
@@ -0,0 +1,226 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <cmath>
+#include <limits>
+
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/exec/document_value/value_comparator.h"
+#include "mongo/db/pipeline/expression_compiler.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<CompiledExpression> compile(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                            const BSONObj& spec) {
+    auto expr = Expression::parseOperand(expCtx, spec.firstElement(), expCtx->variablesParseState);
+    return CompiledExpression::compile(expr->optimize());
+}
+
+/**
+ * The outcome of evaluating an expression: either a value or the code of the error it raised.
+ */
+struct Outcome {
+    boost::optional<Value> value;
+    boost::optional<int> errorCode;
+};
+
+template <typename Fn>
+Outcome outcomeOf(Fn&& fn) {
+    try {
+        return {fn(), boost::none};
+    } catch (const DBException& ex) {
+        return {boost::none, static_cast<int>(ex.code())};
+    }
+}
+
+void assertSameOutcome(const Outcome& expected, const Outcome& actual, const std::string& msg) {
+    ASSERT_EQ(expected.errorCode.value_or(0), actual.errorCode.value_or(0)) << msg;
+    ASSERT_EQ(static_cast<bool>(expected.value), static_cast<bool>(actual.value)) << msg;
+    if (expected.value) {
+        ASSERT_EQ(expected.value->getType(), actual.value->getType()) << msg;
+        ASSERT_EQ(0, ValueComparator().compare(*expected.value, *actual.value)) << msg;
+    }
+}
+
+const std::vector<Value> kOperands = {
+    Value(),
+    Value(BSONNULL),
+    Value(0),
+    Value(1),
+    Value(-7),
+    Value(std::numeric_limits<int>::max()),
+    Value(std::numeric_limits<int>::min()),
+    Value(0LL),
+    Value(5LL),
+    Value(std::numeric_limits<long long>::max()),
+    Value(std::numeric_limits<long long>::min()),
+    Value(0.0),
+    Value(2.5),
+    Value(-1e300),
+    Value(std::numeric_limits<double>::quiet_NaN()),
+    Value(std::numeric_limits<double>::infinity()),
+    Value(Decimal128("1.5")),
+    Value(Date_t::fromMillisSinceEpoch(1'600'000'000'000LL)),
+    Value(Date_t::fromMillisSinceEpoch(std::numeric_limits<long long>::max())),
+    Value("string"_sd),
+};
+
+TEST(CompiledExpressionTest, CompilesArithmeticOverConstantsAndRootFieldPaths) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+
+    auto compiled =
+        compile(expCtx,
+                BSON("" << BSON("$add" << BSON_ARRAY("$a" << BSON("$multiply" << BSON_ARRAY(
+                                                                      "$$ROOT.b.c" << 2))))));
+    ASSERT(compiled);
+    ASSERT_EQ(5U, compiled->numInstructions());
+
+    ASSERT(compile(expCtx, BSON("" << BSON("$divide" << BSON_ARRAY("$a" << 3)))));
+    ASSERT(compile(expCtx, BSON("" << BSON("$subtract" << BSON_ARRAY("$a" << 1)))));
+}
+
+TEST(CompiledExpressionTest, DoesNotCompileOutsideTheSupportedSubset) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+
+    // Loads alone are not worth compiling.
+    ASSERT_FALSE(compile(expCtx, BSON("" << "$a")));
+    // Constant folding leaves nothing to compile.
+    ASSERT_FALSE(compile(expCtx, BSON("" << BSON("$add" << BSON_ARRAY(1 << 2)))));
+    // Unsupported operators, at the root or nested.
+    ASSERT_FALSE(compile(expCtx, BSON("" << BSON("$concat" << BSON_ARRAY("$a" << "b")))));
+    ASSERT_FALSE(
+        compile(expCtx, BSON("" << BSON("$add" << BSON_ARRAY("$a" << BSON("$abs" << "$b"))))));
+    // Non-numeric constants and variables other than ROOT.
+    ASSERT_FALSE(compile(expCtx, BSON("" << BSON("$add" << BSON_ARRAY("$a" << "$$NOW")))));
+    ASSERT_FALSE(compile(expCtx, BSON("" << BSON("$add" << BSON_ARRAY("$a" << "$$ROOT")))));
+}
+
+TEST(CompiledExpressionTest, CompilationCanBeDisabled) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    internalQueryEnableExpressionCompilation.store(false);
+    ON_BLOCK_EXIT([] { internalQueryEnableExpressionCompilation.store(true); });
+
+    ASSERT_FALSE(compile(expCtx, BSON("" << BSON("$add" << BSON_ARRAY("$a" << 1)))));
+}
+
+TEST(CompiledExpressionTest, MatchesInterpreterForEveryPairOfOperandTypes) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+
+    for (auto&& op : {"$add", "$subtract", "$multiply", "$divide"}) {
+        const auto spec = BSON("" << BSON(op << BSON_ARRAY("$a"
+                                                           << "$b")));
+        auto compiled = compile(expCtx, spec);
+        ASSERT(compiled) << op;
+
+        for (auto&& lhs : kOperands) {
+            for (auto&& rhs : kOperands) {
+                MutableDocument md;
+                if (!lhs.missing())
+                    md.addField("a", lhs);
+                if (!rhs.missing())
+                    md.addField("b", rhs);
+                const Document doc = md.freeze();
+
+                const std::string msg = str::stream() << op << " " << doc.toString();
+                auto& variables = expCtx->variables;
+                auto expected = outcomeOf(
+                    [&] { return compiled->getExpression()->evaluate(doc, &variables); });
+                auto actual = outcomeOf([&] { return compiled->evaluate(doc, &variables); });
+                assertSameOutcome(expected, actual, msg);
+            }
+        }
+    }
+}
+
+TEST(CompiledExpressionTest, EvaluatesNumbersAndDatesWithoutTheInterpreter) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    const auto date = Date_t::fromMillisSinceEpoch(1'600'000'000'000LL);
+    const auto doc = Document{{"i", 3}, {"l", 4LL}, {"d", 0.5}, {"date", date}};
+
+    auto sum = compile(expCtx, BSON("" << BSON("$add" << BSON_ARRAY("$i" << "$i" << 1))));
+    ASSERT_VALUE_EQ(Value(7), *sum->evaluateCompiled(doc));
+    ASSERT_EQ(NumberInt, sum->evaluateCompiled(doc)->getType());
+
+    auto longSum = compile(expCtx, BSON("" << BSON("$add" << BSON_ARRAY("$i" << "$l"))));
+    ASSERT_EQ(NumberLong, longSum->evaluateCompiled(doc)->getType());
+
+    auto product = compile(expCtx, BSON("" << BSON("$multiply" << BSON_ARRAY("$l" << "$d"))));
+    ASSERT_VALUE_EQ(Value(2.0), *product->evaluateCompiled(doc));
+
+    auto later = compile(expCtx, BSON("" << BSON("$add" << BSON_ARRAY("$date" << 1000))));
+    ASSERT_VALUE_EQ(Value(date + Seconds(1)), *later->evaluateCompiled(doc));
+
+    auto elapsed = compile(expCtx,
+                           BSON("" << BSON("$subtract" << BSON_ARRAY("$date" << BSON(
+                                                                         "$subtract" << BSON_ARRAY(
+                                                                             "$date" << 60000))))));
+    ASSERT_VALUE_EQ(Value(60000LL), *elapsed->evaluateCompiled(doc));
+}
+
+TEST(CompiledExpressionTest, FallsBackToInterpreterForNonNumericInputs) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    auto compiled = compile(expCtx, BSON("" << BSON("$add" << BSON_ARRAY("$a.b" << 1))));
+    ASSERT(compiled);
+
+    // A nested document is traversed without the interpreter.
+    const auto nested = Document{{"a", Document{{"b", 2}}}};
+    ASSERT_VALUE_EQ(Value(3), *compiled->evaluateCompiled(nested));
+
+    // An array fans the path out, so the interpreter is needed (and fails on the array).
+    const auto array = Document{{"a", std::vector<Value>{Value(Document{{"b", 2}})}}};
+    ASSERT_FALSE(compiled->evaluateCompiled(array));
+    ASSERT_THROWS_CODE(compiled->evaluate(array, &expCtx->variables), AssertionException, 16554);
+
+    // A missing operand makes the result null.
+    const auto missing = Document{{"c", 1}};
+    ASSERT_FALSE(compiled->evaluateCompiled(missing));
+    ASSERT_VALUE_EQ(Value(BSONNULL), compiled->evaluate(missing, &expCtx->variables));
+}
+
+TEST(CompiledExpressionTest, AddKeepsTheInterpretersCompensatedSummation) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    auto compiled = compile(expCtx, BSON("" << BSON("$add" << BSON_ARRAY("$a" << "$b" << "$c"))));
+    ASSERT(compiled);
+
+    const auto doc = Document{{"a", 1e16}, {"b", 1.0}, {"c", 1.0}};
+    ASSERT_VALUE_EQ(compiled->getExpression()->evaluate(doc, &expCtx->variables),
+                    *compiled->evaluateCompiled(doc));
+    ASSERT_VALUE_EQ(Value(1e16 + 2.0), *compiled->evaluateCompiled(doc));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -32,6 +32,7 @@
 #include <iostream>
 #include <unordered_set>
 
+#include "mongo/db/geo/geo_query_cache.h"
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/geo/r2_region_coverer.h"
 #include "mongo/db/hasher.h"
@@ -39,7 +40,6 @@
 #include "mongo/db/query/expression_index_knobs_gen.h"
 #include "third_party/s2/s2cellid.h"
 #include "third_party/s2/s2region.h"
-#include "third_party/s2/s2regioncoverer.h"
 
 namespace mongo {
 
@@ -108,7 +108,8 @@ void ExpressionMapping::cover2d(const R2Region& region,
     GeoHashsToIntervalsWithParents(unorderedCovering, oilOut);
 }
 
-std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region) {
+namespace {
+GeoQueryCache::CoveringParams get2dsphereCoveringParams() {
     auto minLevel = gInternalQueryS2GeoCoarsestLevel.load();
     auto maxLevel = gInternalQueryS2GeoFinestLevel.load();
 
@@ -116,20 +117,19 @@ std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& reg
     uassert(28740, "Geo finest level must be in range [0,30]", 0 <= maxLevel && maxLevel <= 30);
     uassert(28741, "Geo coarsest level must be less than or equal to finest", minLevel <= maxLevel);
 
-    S2RegionCoverer coverer;
-    coverer.set_min_level(minLevel);
-    coverer.set_max_level(maxLevel);
-    coverer.set_max_cells(gInternalQueryS2GeoMaxCells.load());
+    return {minLevel, maxLevel, gInternalQueryS2GeoMaxCells.load()};
+}
+}  // namespace
 
-    std::vector<S2CellId> cover;
-    coverer.GetCovering(region, &cover);
-    return cover;
+std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region) {
+    return GeoQueryCache::computeCovering(region, get2dsphereCoveringParams());
 }
 
-void ExpressionMapping::cover2dsphere(const S2Region& region,
+void ExpressionMapping::cover2dsphere(const GeometryContainer& geometry,
                                       const S2IndexingParams& indexingParams,
                                       OrderedIntervalList* oilOut) {
-    std::vector<S2CellId> cover = get2dsphereCovering(region);
+    std::vector<S2CellId> cover =
+        GeoQueryCache::get().getCovering(geometry, get2dsphereCoveringParams());
     S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
 }
 
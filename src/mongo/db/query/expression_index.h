@@ -31,6 +31,7 @@
 
 #include <vector>
 
+#include "mongo/db/geo/geometry_container.h"
 #include "mongo/db/geo/hash.h"
 #include "mongo/db/geo/shapes.h"
 #include "mongo/db/index/s2_common.h"
@@ -75,7 +76,9 @@ public:
                                                 const S2IndexingParams& indexParams,
                                                 OrderedIntervalList* out);
 
-    static void cover2dsphere(const S2Region& region,
+    // Covers the S2 region of a query geometry, reusing the covering of earlier queries on the
+    // same geometry when possible.
+    static void cover2dsphere(const GeometryContainer& geometry,
                               const S2IndexingParams& indexParams,
                               OrderedIntervalList* oilOut);
 };
@@ -840,6 +840,15 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         sortNodeRaw->limit = 0;
     }
 
+    // A limited sort on nothing but the text score directly above the TEXT node only needs the
+    // 'limit' best-scoring documents, which the TEXT node can find without reading every posting.
+    if (sortNodeRaw->limit > 0 && solnRoot == sortNodeRaw &&
+        sortNodeRaw->children[0]->getType() == STAGE_TEXT && sortObj.nFields() == 1 &&
+        QueryRequest::isTextScoreMeta(sortObj.firstElement()) &&
+        internalQueryEnableTextTopK.load()) {
+        static_cast<TextNode*>(sortNodeRaw->children[0])->topK = sortNodeRaw->limit;
+    }
+
     *blockingSortOut = true;
 
     return solnRoot;
@@ -406,7 +406,8 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
                                          "diacriticSensitive",
                                          "prefix",
                                          "collation",
-                                         "filter"}));
+                                         "filter",
+                                         "topK"}));
 
         BSONElement searchElt = textObj["search"];
         if (!searchElt.eoo()) {
@@ -436,6 +437,14 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
             }
         }
 
+        BSONElement topKElt = textObj["topK"];
+        if (!topKElt.eoo()) {
+            if (!topKElt.isNumber() ||
+                static_cast<size_t>(topKElt.numberLong()) != node->topK) {
+                return false;
+            }
+        }
+
         BSONElement indexPrefix = textObj["prefix"];
         if (!indexPrefix.eoo()) {
             if (!indexPrefix.isABSONObj()) {
@@ -534,4 +534,49 @@ TEST_F(QueryPlannerTest, CantExplodeMetaSort) {
         fromjson("{c: {$meta: 'textScore'}}"));
 }
 
+TEST_F(QueryPlannerTest, LimitedTextScoreSortPushesTopKToTextNode) {
+    addIndex(BSON("_fts"
+                  << "text"
+                  << "_ftsx" << 1));
+
+    runQueryAsCommand(fromjson(
+        "{find: 'testns', filter: {$text: {$search: 'foo bar'}}, sort: {s: {$meta: 'textScore'}}, "
+        "skip: 5, limit: 10}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{skip: {n: 5, node: {sort: {limit: 15, pattern: {s: {$meta: 'textScore'}}, "
+        "type: 'default', node: {text: {search: 'foo bar', topK: 15}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, UnlimitedTextScoreSortDoesNotPushTopK) {
+    addIndex(BSON("_fts"
+                  << "text"
+                  << "_ftsx" << 1));
+
+    runQuerySortProj(fromjson("{$text: {$search: 'foo'}}"),
+                     fromjson("{s: {$meta: 'textScore'}}"),
+                     BSONObj());
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{sort: {limit: 0, pattern: {s: {$meta: 'textScore'}}, type: 'default', node: "
+        "{text: {search: 'foo', topK: 0}}}}");
+}
+
+TEST_F(QueryPlannerTest, LimitedCompoundSortDoesNotPushTopK) {
+    addIndex(BSON("_fts"
+                  << "text"
+                  << "_ftsx" << 1));
+
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {$text: {$search: 'foo'}}, "
+                 "sort: {s: {$meta: 'textScore'}, a: 1}, limit: 10}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{sort: {limit: 10, pattern: {s: {$meta: 'textScore'}, a: 1}, type: 'default', node: "
+        "{text: {search: 'foo', topK: 0}}}}");
+}
+
 }  // namespace
@@ -208,6 +208,10 @@ void TextNode::appendToString(str::stream* ss, int indent) const {
     *ss << "diacriticSensitive= " << ftsQuery->getDiacriticSensitive() << '\n';
     addIndent(ss, indent + 1);
     *ss << "indexPrefix = " << indexPrefix.toString() << '\n';
+    if (topK) {
+        addIndent(ss, indent + 1);
+        *ss << "topK = " << topK << '\n';
+    }
     if (nullptr != filter) {
         addIndent(ss, indent + 1);
         *ss << " filter = " << filter->debugString();
@@ -222,6 +226,7 @@ QuerySolutionNode* TextNode::clone() const {
     copy->_sort = this->_sort;
     copy->ftsQuery = this->ftsQuery->clone();
     copy->indexPrefix = this->indexPrefix;
+    copy->topK = this->topK;
 
     return copy;
 }
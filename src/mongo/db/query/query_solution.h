@@ -309,6 +309,10 @@ struct TextNode : public QuerySolutionNode {
     // text node while creating the text leaf node and convert them into a BSONObj index prefix
     // when we finish the text leaf node.
     BSONObj indexPrefix;
+
+    // If non-zero, the parent only needs the 'topK' documents with the highest text scores, so the
+    // text stage may stop reading postings once no other document can score higher.
+    size_t topK = 0u;
 };
 
 struct CollectionScanNode : public QuerySolutionNode {
@@ -293,6 +293,7 @@ std::unique_ptr<PlanStage> buildStages(OperationContext* opCtx,
             // created by planning a query that contains "no-op" expressions.
             params.query = static_cast<FTSQueryImpl&>(*node->ftsQuery);
             params.wantTextScore = cq.metadataDeps()[DocumentMetadataFields::kTextScore];
+            params.topK = node->topK;
             return std::make_unique<TextStage>(expCtx, params, ws, node->filter.get());
         }
         case STAGE_SHARDING_FILTER: {
@@ -454,11 +454,17 @@ bool ReplicationCoordinatorMock::shouldChangeSyncSource(const HostAndPort& curre
 }
 
 OpTime ReplicationCoordinatorMock::getLastCommittedOpTime() const {
-    return OpTime();
+    return _lastCommittedOpTime;
 }
 
 OpTimeAndWallTime ReplicationCoordinatorMock::getLastCommittedOpTimeAndWallTime() const {
-    return {OpTime(), Date_t()};
+    return {_lastCommittedOpTime, _lastCommittedWallTime};
+}
+
+void ReplicationCoordinatorMock::setLastCommittedOpTimeAndWallTime(
+    const OpTimeAndWallTime& opTimeAndWallTime) {
+    _lastCommittedOpTime = opTimeAndWallTime.opTime;
+    _lastCommittedWallTime = opTimeAndWallTime.wallTime;
 }
 
 Status ReplicationCoordinatorMock::processReplSetRequestVotes(
@@ -297,6 +297,12 @@ public:
     void setAwaitReplicationReturnValueFunction(
         AwaitReplicationReturnValueFunction returnValueFunction);
 
+    /**
+     * Sets the return value for calls to getLastCommittedOpTime and
+     * getLastCommittedOpTimeAndWallTime.
+     */
+    void setLastCommittedOpTimeAndWallTime(const OpTimeAndWallTime& opTimeAndWallTime);
+
     /**
      * Always allow writes even if this node is a writable primary. Used by sharding unit tests.
      */
@@ -362,6 +368,8 @@ private:
     Date_t _myLastDurableWallTime;
     OpTime _myLastAppliedOpTime;
     Date_t _myLastAppliedWallTime;
+    OpTime _lastCommittedOpTime;
+    Date_t _lastCommittedWallTime;
     ReplSetConfig _getConfigReturnValue;
     AwaitReplicationReturnValueFunction _awaitReplicationReturnValueFunction = [](OperationContext*,
                                                                                   const OpTime&) {
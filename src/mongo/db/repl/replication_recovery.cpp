@@ -36,6 +36,7 @@
 #include "mongo/db/repl/replication_recovery.h"
 
 #include "mongo/db/catalog/document_validation.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/namespace_string.h"
@@ -50,6 +51,7 @@
 #include "mongo/db/repl/transaction_oplog_application.h"
 #include "mongo/db/server_recovery.h"
 #include "mongo/db/session.h"
+#include "mongo/db/stats/timer_stats.h"
 #include "mongo/db/storage/control/journal_flusher.h"
 #include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/transaction_history_iterator.h"
@@ -65,13 +67,39 @@ namespace {
 const auto kRecoveryBatchLogLevel = logv2::LogSeverity::Debug(2);
 const auto kRecoveryOperationLogLevel = logv2::LogSeverity::Debug(3);
 
+// How often progress is reported while applying oplog entries during recovery.
+const auto kRecoveryProgressLogInterval = Seconds(10);
+
+// The oplog entries applied during replication recovery.
+Counter64 recoveryOpsAppliedStats;
+ServerStatusMetricField<Counter64> displayRecoveryOpsApplied("repl.recovery.ops",
+                                                             &recoveryOpsAppliedStats);
+
+// Number and time of each batch applied during replication recovery.
+TimerStats recoveryApplyBatchStats;
+ServerStatusMetricField<TimerStats> displayRecoveryBatchesApplied("repl.recovery.batches",
+                                                                  &recoveryApplyBatchStats);
+
+/**
+ * Returns the maximum number of operations in each batch applied during recovery. Recovery has no
+ * concurrent readers waiting on batch boundaries, so it may use larger batches than steady state
+ * replication to amortize the cost of scheduling each batch onto the writer pool.
+ */
+std::size_t getRecoveryBatchLimitOplogEntries() {
+    const auto limit = replRecoveryBatchLimitOperations.load();
+    return limit > 0 ? std::size_t(limit) : getBatchLimitOplogEntries();
+}
+
 /**
  * Tracks and logs operations applied during recovery.
  */
 class RecoveryOplogApplierStats : public OplogApplier::Observer {
 public:
+    explicit RecoveryOplogApplierStats(Timestamp endPoint) : _endPoint(endPoint) {}
+
     void onBatchBegin(const std::vector<OplogEntry>& batch) final {
         _numBatches++;
+        _batchTimer.reset();
         LOGV2_FOR_RECOVERY(24098,
                            kRecoveryBatchLogLevel.toInt(),
                            "Applying operations in batch: {numBatches}({batchSize} operations "
@@ -103,7 +131,28 @@ public:
         }
     }
 
-    void onBatchEnd(const StatusWith<OpTime>&, const std::vector<OplogEntry>&) final {}
+    void onBatchEnd(const StatusWith<OpTime>& lastOpTimeApplied,
+                    const std::vector<OplogEntry>& batch) final {
+        recoveryApplyBatchStats.recordMillis(_batchTimer.millis());
+        if (!lastOpTimeApplied.isOK()) {
+            return;
+        }
+        recoveryOpsAppliedStats.increment(batch.size());
+
+        if (Milliseconds(_progressTimer.millis()) >= kRecoveryProgressLogInterval) {
+            LOGV2(5135200,
+                  "Recovery oplog application progress: applied {numOpsApplied} operations in "
+                  "{numBatches} batches ({opsPerSecond} ops/sec) up to {lastOpTime}, applying "
+                  "through {endPoint}",
+                  "Recovery oplog application progress",
+                  "numOpsApplied"_attr = _numOpsApplied,
+                  "numBatches"_attr = _numBatches,
+                  "opsPerSecond"_attr = _opsPerSecond(),
+                  "lastOpTime"_attr = lastOpTimeApplied.getValue(),
+                  "endPoint"_attr = _endPoint);
+            _progressTimer.reset();
+        }
+    }
 
     void complete(const OpTime& applyThroughOpTime) const {
         LOGV2(21536,
@@ -112,12 +161,23 @@ public:
               "Completed oplog application for recovery",
               "numOpsApplied"_attr = _numOpsApplied,
               "numBatches"_attr = _numBatches,
-              "applyThroughOpTime"_attr = applyThroughOpTime);
+              "applyThroughOpTime"_attr = applyThroughOpTime,
+              "durationMillis"_attr = _totalTimer.millis(),
+              "opsPerSecond"_attr = _opsPerSecond());
     }
 
 private:
+    long long _opsPerSecond() const {
+        const auto micros = _totalTimer.micros();
+        return micros > 0 ? static_cast<long long>(_numOpsApplied * 1000 * 1000 / micros) : 0;
+    }
+
+    const Timestamp _endPoint;
     std::size_t _numBatches = 0;
     std::size_t _numOpsApplied = 0;
+    Timer _totalTimer;
+    Timer _progressTimer;
+    Timer _batchTimer;
 };
 
 /**
@@ -649,7 +709,7 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
     OplogBufferLocalOplog oplogBuffer(startPoint, endPoint);
     oplogBuffer.startup(opCtx);
 
-    RecoveryOplogApplierStats stats;
+    RecoveryOplogApplierStats stats(endPoint);
 
     auto writerPool = makeReplWriterPool();
     auto* replCoord = ReplicationCoordinator::get(opCtx);
@@ -664,7 +724,7 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
 
     OplogApplier::BatchLimits batchLimits;
     batchLimits.bytes = getBatchLimitOplogBytes(opCtx, _storageInterface);
-    batchLimits.ops = getBatchLimitOplogEntries();
+    batchLimits.ops = getRecoveryBatchLimitOplogEntries();
 
     // If we're doing unstable checkpoints during the recovery process (as we do during the special
     // startupRecoveryForRestore mode), we need to advance the consistency marker for each batch so
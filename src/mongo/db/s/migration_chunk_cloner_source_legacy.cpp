@@ -736,38 +736,74 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
                            internalQueryExecYieldIterations.load(),
                            Milliseconds(internalQueryExecYieldPeriodMS.load()));
 
-    stdx::unique_lock<Latch> lk(_mutex);
-    auto iter = _cloneLocs.begin();
+    while (true) {
+        // Take ownership of enough record ids to fill the rest of the batch, so that concurrent
+        // _migrateClone requests for the same session never return the same document twice.
+        std::vector<RecordId> claimedLocs;
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            uassert(ErrorCodes::Error(4900601),
+                    "The migration was cancelled while cloning documents",
+                    _state != kDone);
 
-    for (; iter != _cloneLocs.end(); ++iter) {
-        // We must always make progress in this method by at least one document because empty
-        // return indicates there is no more initial clone data.
-        if (arrBuilder->arrSize() && tracker.intervalHasElapsed()) {
-            break;
+            const uint64_t bytesLeft = std::max(BSONObjMaxUserSize - arrBuilder->len(), 0);
+            const uint64_t numToClaim = std::max(
+                bytesLeft / std::max(_averageObjectSizeForCloneLocs, uint64_t(1)), uint64_t(1));
+
+            auto end = _cloneLocs.begin();
+            while (end != _cloneLocs.end() && claimedLocs.size() < numToClaim) {
+                claimedLocs.push_back(*end++);
+            }
+            _cloneLocs.erase(_cloneLocs.begin(), end);
         }
 
-        auto nextRecordId = *iter;
+        if (claimedLocs.empty()) {
+            return;
+        }
 
-        lk.unlock();
+        // Give back the record ids which did not make it into this batch, including when reading
+        // them fails. The caller always asks for another batch after a non-empty one, so they are
+        // not lost and still count as remaining to be cloned.
+        auto iter = claimedLocs.begin();
+        ON_BLOCK_EXIT([&] {
+            if (iter == claimedLocs.end()) {
+                return;
+            }
 
-        Snapshotted<BSONObj> doc;
-        if (collection->findDoc(opCtx, nextRecordId, &doc)) {
-            // Use the builder size instead of accumulating the document sizes directly so
-            // that we take into consideration the overhead of BSONArray indices.
-            if (arrBuilder->arrSize() &&
-                (arrBuilder->len() + doc.value().objsize() + 1024) > BSONObjMaxUserSize) {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (_state != kDone) {
+                _cloneLocs.insert(iter, claimedLocs.end());
+            }
+        });
 
+        for (; iter != claimedLocs.end(); ++iter) {
+            // We must always make progress in this method by at least one document because empty
+            // return indicates there is no more initial clone data.
+            if (arrBuilder->arrSize() && tracker.intervalHasElapsed()) {
                 break;
             }
 
-            arrBuilder->append(doc.value());
-            ShardingStatistics::get(opCtx).countDocsClonedOnDonor.addAndFetch(1);
+            opCtx->checkForInterrupt();
+
+            Snapshotted<BSONObj> doc;
+            if (collection->findDoc(opCtx, *iter, &doc)) {
+                // Use the builder size instead of accumulating the document sizes directly so
+                // that we take into consideration the overhead of BSONArray indices.
+                if (arrBuilder->arrSize() &&
+                    (arrBuilder->len() + doc.value().objsize() + 1024) > BSONObjMaxUserSize) {
+
+                    break;
+                }
+
+                arrBuilder->append(doc.value());
+                ShardingStatistics::get(opCtx).countDocsClonedOnDonor.addAndFetch(1);
+            }
         }
 
-        lk.lock();
+        if (iter != claimedLocs.end()) {
+            return;
+        }
     }
-
-    _cloneLocs.erase(_cloneLocs.begin(), iter);
 }
 
 uint64_t MigrationChunkClonerSourceLegacy::getCloneBatchBufferAllocationSize() {
@@ -779,6 +815,11 @@ uint64_t MigrationChunkClonerSourceLegacy::getCloneBatchBufferAllocationSize() {
                     _averageObjectSizeForCloneLocs * _cloneLocs.size());
 }
 
+bool MigrationChunkClonerSourceLegacy::supportsConcurrentCloneBatches() {
+    stdx::lock_guard<Latch> sl(_mutex);
+    return !(_jumboChunkCloneState && _forceJumbo);
+}
+
 Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
                                                         Collection* collection,
                                                         BSONArrayBuilder* arrBuilder) {
@@ -795,8 +836,12 @@ Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
         }
     }
 
-    _nextCloneBatchFromCloneLocs(opCtx, collection, arrBuilder);
-    return Status::OK();
+    try {
+        _nextCloneBatchFromCloneLocs(opCtx, collection, arrBuilder);
+        return Status::OK();
+    } catch (const DBException& ex) {
+        return ex.toStatus();
+    }
 }
 
 Status MigrationChunkClonerSourceLegacy::nextModsBatch(OperationContext* opCtx,
@@ -843,6 +888,7 @@ void MigrationChunkClonerSourceLegacy::_cleanup(OperationContext* opCtx) {
 
     _drainAllOutstandingOperationTrackRequests(lk);
 
+    _cloneLocs.clear();
     _reload.clear();
     _untransferredUpsertsCounter = 0;
     _deleted.clear();
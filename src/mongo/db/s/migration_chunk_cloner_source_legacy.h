@@ -146,14 +146,24 @@ public:
      */
     uint64_t getCloneBatchBufferAllocationSize();
 
+    /**
+     * Returns whether nextCloneBatch may be called by several _migrateClone requests at the same
+     * time. This is the case unless the chunk is too large for its record ids to be buffered and is
+     * being cloned through a single index scan.
+     */
+    bool supportsConcurrentCloneBatches();
+
     /**
      * Called by the recipient shard. Populates the passed BSONArrayBuilder with a set of documents,
-     * which are part of the initial clone sequence. Assumes that there is only one active caller
-     * to this method at a time (otherwise, it can cause corruption/crash).
+     * which are part of the initial clone sequence. Unless supportsConcurrentCloneBatches() returns
+     * true, assumes that there is only one active caller to this method at a time (otherwise, it
+     * can cause corruption/crash).
      *
      * Returns OK status on success. If there were documents returned in the result argument, this
      * method should be called more times until the result is empty. If it returns failure, it is
-     * not safe to call more methods on this class other than cancelClone.
+     * not safe to call more methods on this class other than nextCloneBatch and cancelClone. The
+     * record ids claimed by a failed call which it did not return are given back for later calls.
+     * Once the clone has been cancelled or committed, returns an error instead of more documents.
      *
      * This method will return early if too much time is spent fetching the documents in order to
      * give a chance to the caller to perform some form of yielding. It does not free or acquire any
@@ -162,6 +162,7 @@ public:
             uassertStatusOK(MigrationSessionId::extractFromBSON(cmdObj)));
 
         boost::optional<BSONArrayBuilder> arrBuilder;
+        bool supportsConcurrentCloneBatches = false;
 
         // Try to maximize on the size of the buffer, which we are returning in order to have less
         // round-trips
@@ -172,6 +173,8 @@ public:
 
             if (!arrBuilder) {
                 arrBuilder.emplace(autoCloner.getCloner()->getCloneBatchBufferAllocationSize());
+                supportsConcurrentCloneBatches =
+                    autoCloner.getCloner()->supportsConcurrentCloneBatches();
             }
 
             arrSizeAtPrevIteration = arrBuilder->arrSize();
@@ -182,6 +185,9 @@ public:
 
         invariant(arrBuilder);
         result.appendArray("objects", arrBuilder->arr());
+        // Lets the recipient know that it may issue several _migrateClone requests at a time.
+        // Recipients which do not understand this field only ever send one.
+        result.append("supportsConcurrentFetches", supportsConcurrentCloneBatches);
 
         return true;
     }
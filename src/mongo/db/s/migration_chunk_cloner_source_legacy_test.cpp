@@ -31,16 +31,20 @@
 
 #include "mongo/client/remote_command_targeter_mock.h"
 #include "mongo/db/catalog_raii.h"
+#include "mongo/db/client.h"
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/logical_session_id_helpers.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/s/migration_chunk_cloner_source_legacy.h"
 #include "mongo/s/catalog/sharding_catalog_client_mock.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/shard_server_test_fixture.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -170,6 +174,30 @@ protected:
         return BSON("_id" << value << "X" << value);
     }
 
+    /**
+     * Starts cloning through the specified cloner, against a recipient which accepts the request.
+     */
+    void startClone(MigrationChunkClonerSourceLegacy* cloner) {
+        auto futureStartClone = launchAsync([&]() {
+            onCommand([&](const RemoteCommandRequest& request) { return BSON("ok" << true); });
+        });
+
+        ASSERT_OK(cloner->startClone(operationContext(), UUID::gen(), _lsid, _txnNumber));
+        futureStartClone.default_timed_get();
+    }
+
+    /**
+     * Cancels the clone started through startClone, against a recipient which accepts the abort.
+     */
+    void cancelClone(MigrationChunkClonerSourceLegacy* cloner) {
+        auto futureCancelClone = launchAsync([&]() {
+            onCommand([&](const RemoteCommandRequest& request) { return BSON("ok" << true); });
+        });
+
+        cloner->cancelClone(operationContext());
+        futureCancelClone.default_timed_get();
+    }
+
 protected:
     LogicalSessionId _lsid;
     TxnNumber _txnNumber{0};
@@ -312,6 +340,169 @@ TEST_F(MigrationChunkClonerSourceLegacyTest, CorrectDocumentsFetched) {
     futureCommit.default_timed_get();
 }
 
+TEST_F(MigrationChunkClonerSourceLegacyTest, ConcurrentCloneBatchesReturnEachDocumentOnce) {
+    const int kNumDocs = 200;
+    const int kNumFetchers = 4;
+
+    std::vector<BSONObj> contents;
+    for (int i = 0; i < kNumDocs; ++i) {
+        contents.push_back(createCollectionDocument(100 + i));
+    }
+
+    createShardedCollection(contents);
+
+    // Cut every batch short after a couple of documents, so that each batch gives back most of the
+    // record ids it claimed and the fetchers keep claiming from under each other.
+    const auto originalYieldIterations = internalQueryExecYieldIterations.load();
+    internalQueryExecYieldIterations.store(2);
+    ON_BLOCK_EXIT([&] { internalQueryExecYieldIterations.store(originalYieldIterations); });
+
+    MigrationChunkClonerSourceLegacy cloner(
+        createMoveChunkRequest(ChunkRange(BSON("X" << 100), BSON("X" << 100 + kNumDocs))),
+        kShardKeyPattern,
+        kDonorConnStr,
+        kRecipientConnStr.getServers()[0]);
+
+    startClone(&cloner);
+    ASSERT(cloner.supportsConcurrentCloneBatches());
+
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<int> clonedValues;
+    Status fetchStatus = Status::OK();
+
+    std::vector<stdx::thread> fetchers;
+    for (int i = 0; i < kNumFetchers; ++i) {
+        fetchers.emplace_back([&] {
+            ThreadClient tc("cloneBatchFetcher", getServiceContext());
+            auto opCtx = cc().makeOperationContext();
+
+            while (true) {
+                AutoGetCollection autoColl(opCtx.get(), kNss, MODE_IS);
+
+                BSONArrayBuilder arrBuilder;
+                auto status =
+                    cloner.nextCloneBatch(opCtx.get(), autoColl.getCollection(), &arrBuilder);
+
+                stdx::lock_guard<Latch> lk(mutex);
+                if (!status.isOK()) {
+                    fetchStatus = status;
+                    return;
+                }
+                if (arrBuilder.arrSize() == 0) {
+                    return;
+                }
+                for (auto&& doc : arrBuilder.arr()) {
+                    clonedValues.push_back(doc.Obj()["X"].numberInt());
+                }
+            }
+        });
+    }
+
+    for (auto& fetcher : fetchers) {
+        fetcher.join();
+    }
+
+    ASSERT_OK(fetchStatus);
+
+    std::sort(clonedValues.begin(), clonedValues.end());
+    ASSERT_EQ(static_cast<size_t>(kNumDocs), clonedValues.size());
+    for (int i = 0; i < kNumDocs; ++i) {
+        ASSERT_EQ(100 + i, clonedValues[i]);
+    }
+
+    cancelClone(&cloner);
+}
+
+TEST_F(MigrationChunkClonerSourceLegacyTest, FailedCloneBatchGivesBackItsDocuments) {
+    const std::vector<BSONObj> contents = {createCollectionDocument(99),
+                                           createCollectionDocument(100),
+                                           createCollectionDocument(199),
+                                           createCollectionDocument(200)};
+
+    createShardedCollection(contents);
+
+    MigrationChunkClonerSourceLegacy cloner(
+        createMoveChunkRequest(ChunkRange(BSON("X" << 100), BSON("X" << 200))),
+        kShardKeyPattern,
+        kDonorConnStr,
+        kRecipientConnStr.getServers()[0]);
+
+    startClone(&cloner);
+
+    // The batch is interrupted after it has claimed the record ids of both documents, but before
+    // it read either of them.
+    {
+        auto client = getServiceContext()->makeClient("interruptedCloneBatch");
+        AlternativeClientRegion acr(client);
+        auto opCtx = cc().makeOperationContext();
+
+        AutoGetCollection autoColl(opCtx.get(), kNss, MODE_IS);
+        {
+            stdx::lock_guard<Client> lk(*opCtx->getClient());
+            opCtx->markKilled(ErrorCodes::Interrupted);
+        }
+
+        BSONArrayBuilder arrBuilder;
+        ASSERT_EQ(
+            ErrorCodes::Interrupted,
+            cloner.nextCloneBatch(opCtx.get(), autoColl.getCollection(), &arrBuilder).code());
+        ASSERT_EQ(0, arrBuilder.arrSize());
+    }
+
+    {
+        AutoGetCollection autoColl(operationContext(), kNss, MODE_IS);
+
+        {
+            BSONArrayBuilder arrBuilder;
+            ASSERT_OK(
+                cloner.nextCloneBatch(operationContext(), autoColl.getCollection(), &arrBuilder));
+            ASSERT_EQ(2, arrBuilder.arrSize());
+
+            const auto arr = arrBuilder.arr();
+            ASSERT_BSONOBJ_EQ(contents[1], arr[0].Obj());
+            ASSERT_BSONOBJ_EQ(contents[2], arr[1].Obj());
+        }
+
+        {
+            BSONArrayBuilder arrBuilder;
+            ASSERT_OK(
+                cloner.nextCloneBatch(operationContext(), autoColl.getCollection(), &arrBuilder));
+            ASSERT_EQ(0, arrBuilder.arrSize());
+        }
+    }
+
+    cancelClone(&cloner);
+}
+
+TEST_F(MigrationChunkClonerSourceLegacyTest, NoCloneBatchesAfterCancel) {
+    const std::vector<BSONObj> contents = {createCollectionDocument(99),
+                                           createCollectionDocument(100),
+                                           createCollectionDocument(199),
+                                           createCollectionDocument(200)};
+
+    createShardedCollection(contents);
+
+    MigrationChunkClonerSourceLegacy cloner(
+        createMoveChunkRequest(ChunkRange(BSON("X" << 100), BSON("X" << 200))),
+        kShardKeyPattern,
+        kDonorConnStr,
+        kRecipientConnStr.getServers()[0]);
+
+    startClone(&cloner);
+    cancelClone(&cloner);
+
+    // A _migrateClone request which was already running when the migration was aborted must not
+    // go on to return documents.
+    AutoGetCollection autoColl(operationContext(), kNss, MODE_IS);
+
+    BSONArrayBuilder arrBuilder;
+    ASSERT_EQ(
+        4900601,
+        cloner.nextCloneBatch(operationContext(), autoColl.getCollection(), &arrBuilder).code());
+    ASSERT_EQ(0, arrBuilder.arrSize());
+    ASSERT_EQ(0U, cloner.getCloneBatchBufferAllocationSize());
+}
+
 TEST_F(MigrationChunkClonerSourceLegacyTest, CollectionNotFound) {
     MigrationChunkClonerSourceLegacy cloner(
         createMoveChunkRequest(ChunkRange(BSON("X" << 100), BSON("X" << 200))),
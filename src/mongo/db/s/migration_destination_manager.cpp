@@ -33,6 +33,7 @@
 
 #include "mongo/db/s/migration_destination_manager.h"
 
+#include <algorithm>
 #include <list>
 #include <vector>
 
@@ -474,12 +475,14 @@ Status MigrationDestinationManager::start(OperationContext* opCtx,
 repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
     OperationContext* opCtx,
     std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-    std::function<BSONObj(OperationContext*)> fetchBatchFn) {
+    std::function<BSONObj(OperationContext*)> fetchBatchFn,
+    int maxConcurrentFetches) {
+    maxConcurrentFetches = std::max(maxConcurrentFetches, 1);
 
-    SingleProducerSingleConsumerQueue<BSONObj>::Options options;
-    options.maxQueueDepth = 1;
+    MultiProducerSingleConsumerQueue<BSONObj>::Options options;
+    options.maxQueueDepth = maxConcurrentFetches;
 
-    SingleProducerSingleConsumerQueue<BSONObj> batches(options);
+    MultiProducerSingleConsumerQueue<BSONObj> batches(options);
     repl::OpTime lastOpApplied;
 
     stdx::thread inserterThread{[&] {
@@ -504,12 +507,14 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
             }
 
             while (true) {
-                auto nextBatch = batches.pop(inserterOpCtx.get());
-                auto arr = nextBatch["objects"].Obj();
-                if (arr.isEmpty()) {
+                BSONObj nextBatch;
+                try {
+                    nextBatch = batches.pop(inserterOpCtx.get());
+                } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+                    // All fetchers are done and every batch they produced has been inserted.
                     return;
                 }
-                insertBatchFn(inserterOpCtx.get(), arr);
+                insertBatchFn(inserterOpCtx.get(), nextBatch["objects"].Obj());
             }
         } catch (...) {
             stdx::lock_guard<Client> lk(*opCtx->getClient());
@@ -521,27 +526,120 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
         }
     }};
 
+    // The first error hit by one of the additional fetcher threads. It closes the producer end of
+    // the queue, which makes every other fetcher stop at its next push.
+    auto fetchErrorMutex = MONGO_MAKE_LATCH("MigrationDestinationManager::cloneDocumentsFromDonor");
+    Status fetchError = Status::OK();
+
+    // The operation contexts of the additional fetcher threads, so that a failure of any fetcher
+    // or of the migration itself can interrupt the _migrateClone requests the others are waiting
+    // on. Protected by fetchErrorMutex.
+    std::vector<OperationContext*> fetcherOpCtxs;
+    bool fetchersCancelled = false;
+
+    auto cancelFetchers = [&] {
+        stdx::lock_guard<Latch> lk(fetchErrorMutex);
+        fetchersCancelled = true;
+        for (auto fetcherOpCtx : fetcherOpCtxs) {
+            stdx::lock_guard<Client> clientLock(*fetcherOpCtx->getClient());
+            fetcherOpCtx->getServiceContext()->killOperation(
+                clientLock, fetcherOpCtx, ErrorCodes::Error(4900600));
+        }
+    };
+
+    auto fetchUntilExhausted = [&](OperationContext* fetcherOpCtx) {
+        while (true) {
+            auto res = fetchBatchFn(fetcherOpCtx);
+            if (res["objects"].Obj().isEmpty()) {
+                return;
+            }
+            batches.push(res.getOwned(), fetcherOpCtx);
+        }
+    };
 
     {
-        auto inserterThreadJoinGuard = makeGuard([&] {
+        std::vector<stdx::thread> fetcherThreads;
+        auto threadsJoinGuard = makeGuard([&] {
             batches.closeProducerEnd();
+            for (auto& fetcherThread : fetcherThreads) {
+                fetcherThread.join();
+            }
             inserterThread.join();
         });
 
-        while (true) {
-            auto res = fetchBatchFn(opCtx);
-            try {
-                batches.push(res.getOwned(), opCtx);
-                auto arr = res["objects"].Obj();
-                if (arr.isEmpty()) {
-                    break;
+        try {
+            auto firstBatch = fetchBatchFn(opCtx);
+            if (!firstBatch["objects"].Obj().isEmpty()) {
+                batches.push(firstBatch.getOwned(), opCtx);
+
+                // Donors which predate concurrent _migrateClone requests would hand out the same
+                // documents to each of them, so only fan out when the donor says it is safe.
+                const int numFetchers =
+                    firstBatch["supportsConcurrentFetches"].trueValue() ? maxConcurrentFetches : 1;
+                for (int i = 1; i < numFetchers; ++i) {
+                    fetcherThreads.emplace_back([&] {
+                        Client::initThread(
+                            "chunkCloneFetcher", opCtx->getServiceContext(), nullptr);
+                        auto newClient = Client::getCurrent();
+                        {
+                            stdx::lock_guard lk(*newClient);
+                            newClient->setSystemOperationKillable(lk);
+                        }
+                        auto fetcherOpCtx = cc().makeOperationContext();
+                        fetcherOpCtx->setAlwaysInterruptAtStepDownOrUp();
+
+                        {
+                            stdx::lock_guard<Latch> lk(fetchErrorMutex);
+                            if (fetchersCancelled) {
+                                return;
+                            }
+                            fetcherOpCtxs.push_back(fetcherOpCtx.get());
+                        }
+                        ON_BLOCK_EXIT([&] {
+                            stdx::lock_guard<Latch> lk(fetchErrorMutex);
+                            fetcherOpCtxs.erase(std::find(
+                                fetcherOpCtxs.begin(), fetcherOpCtxs.end(), fetcherOpCtx.get()));
+                        });
+
+                        try {
+                            fetchUntilExhausted(fetcherOpCtx.get());
+                        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+                        } catch (...) {
+                            {
+                                stdx::lock_guard<Latch> lk(fetchErrorMutex);
+                                if (fetchError.isOK()) {
+                                    fetchError = exceptionToStatus();
+                                }
+                            }
+                            batches.closeProducerEnd();
+                            cancelFetchers();
+                        }
+                    });
                 }
-            } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
-                break;
+
+                fetchUntilExhausted(opCtx);
             }
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+        } catch (...) {
+            // The migration was aborted or interrupted, or the inserter failed. Don't wait for the
+            // other fetchers to notice on their own, since each may be blocked on a request to the
+            // donor until it returns a whole batch.
+            cancelFetchers();
+            throw;
         }
+
+        // Let the other fetchers run until the donor is exhausted before closing the queue.
+        for (auto& fetcherThread : fetcherThreads) {
+            fetcherThread.join();
+        }
+        fetcherThreads.clear();
     }  // This scope ensures that the guard is destroyed
 
+    {
+        stdx::lock_guard<Latch> lk(fetchErrorMutex);
+        uassertStatusOK(fetchError);
+    }
+
     // This check is necessary because the consumer thread uses killOp to propagate errors to the
     // producer thread (this thread)
     opCtx->checkForInterrupt();
@@ -1208,7 +1306,8 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
 
         // If running on a replicated system, we'll need to flush the docs we cloned to the
         // secondaries
-        lastOpApplied = cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn);
+        lastOpApplied = cloneDocumentsFromDonor(
+            opCtx, insertBatchFn, fetchBatchFn, migrateCloneMaxConcurrentFetches.load());
 
         timing.done(4);
         migrateThreadHangAtStep4.pauseWhileSet();
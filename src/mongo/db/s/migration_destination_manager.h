@@ -113,12 +113,16 @@ public:
                  const WriteConcernOptions& writeConcern);
 
     /**
-     * Clones documents from a donor shard.
+     * Clones documents from a donor shard. Batches are fetched with 'fetchBatchFn' until it returns
+     * an empty one and are handed to 'insertBatchFn' on a separate thread. If the first batch says
+     * that the donor supports it, up to 'maxConcurrentFetches' threads call 'fetchBatchFn' at the
+     * same time, so it must then be safe to call concurrently.
      */
     static repl::OpTime cloneDocumentsFromDonor(
         OperationContext* opCtx,
         std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-        std::function<BSONObj(OperationContext*)> fetchBatchFn);
+        std::function<BSONObj(OperationContext*)> fetchBatchFn,
+        int maxConcurrentFetches = 1);
 
     /**
      * Idempotent method, which causes the current ongoing migration to abort only if it has the
@@ -30,6 +30,8 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/s/migration_destination_manager.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/s/shard_server_test_fixture.h"
 #include "mongo/unittest/unittest.h"
 
@@ -105,6 +107,80 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWorksCorrectly) {
     }
 }
 
+// Tests that a donor which supports concurrent fetches is drained by several fetchers, each of
+// which stops only once it has seen an empty batch, and that no batch is lost on the way.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorFetchesConcurrently) {
+    const int kNumBatches = 20;
+    const int kMaxConcurrentFetches = 3;
+
+    auto mutex = MONGO_MAKE_LATCH();
+    int numBatchesFetched = 0;
+    int numEmptyBatchesFetched = 0;
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        stdx::lock_guard<Latch> lk(mutex);
+        BSONObjBuilder fetchBatchResultBuilder;
+        if (numBatchesFetched == kNumBatches) {
+            ++numEmptyBatchesFetched;
+            fetchBatchResultBuilder.append("objects", BSONObj());
+        } else {
+            const int value = numBatchesFetched++;
+            fetchBatchResultBuilder.append("objects", BSON_ARRAY(createDocument(value)));
+        }
+        fetchBatchResultBuilder.append("supportsConcurrentFetches", true);
+        return fetchBatchResultBuilder.obj();
+    };
+
+    std::vector<int> insertedValues;
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        for (auto&& docToClone : docs) {
+            insertedValues.push_back(docToClone.Obj()["_id"].numberInt());
+        }
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn, kMaxConcurrentFetches);
+
+    ASSERT_EQ(kMaxConcurrentFetches, numEmptyBatchesFetched);
+
+    std::sort(insertedValues.begin(), insertedValues.end());
+    ASSERT_EQ(static_cast<size_t>(kNumBatches), insertedValues.size());
+    for (int i = 0; i < kNumBatches; ++i) {
+        ASSERT_EQ(i, insertedValues[i]);
+    }
+}
+
+// Tests that a donor which does not advertise support for concurrent fetches is only ever sent one
+// request at a time.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorFetchesSeriallyFromOlderDonors) {
+    int numCalls = 0;
+    int numEmptyBatchesFetched = 0;
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        BSONObjBuilder fetchBatchResultBuilder;
+        if (++numCalls > 2) {
+            ++numEmptyBatchesFetched;
+            fetchBatchResultBuilder.append("objects", BSONObj());
+        } else {
+            fetchBatchResultBuilder.append("objects", createDocumentsToCloneArray());
+        }
+        return fetchBatchResultBuilder.obj();
+    };
+
+    int numDocsInserted = 0;
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        numDocsInserted += docs.nFields();
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn, 4);
+
+    ASSERT_EQ(1, numEmptyBatchesFetched);
+    ASSERT_EQ(static_cast<int>(2 * createDocumentsToClone().size()), numDocsInserted);
+}
+
 // Tests that an exception in the fetch logic will successfully throw an exception on the main
 // thread.
 TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsFetchErrors) {
@@ -132,6 +208,55 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsFetchErrors) {
                                 "network error");
 }
 
+// Tests that a failure on the main thread interrupts the additional fetchers while they are still
+// waiting on the donor, rather than leaving them to run until their request returns.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsInterruptsFetchersOnFetchError) {
+    const int kMaxConcurrentFetches = 3;
+
+    auto mutex = MONGO_MAKE_LATCH();
+    stdx::condition_variable cv;
+    bool ranOnce = false;
+    int numFetchersWaiting = 0;
+    std::vector<int> fetcherErrorCodes;
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        stdx::unique_lock<Latch> lk(mutex);
+        if (!ranOnce) {
+            ranOnce = true;
+            BSONObjBuilder fetchBatchResultBuilder;
+            fetchBatchResultBuilder.append("objects", createDocumentsToCloneArray());
+            fetchBatchResultBuilder.append("supportsConcurrentFetches", true);
+            return fetchBatchResultBuilder.obj();
+        }
+
+        if (opCtx != operationContext()) {
+            ++numFetchersWaiting;
+            cv.notify_all();
+            try {
+                opCtx->waitForConditionOrInterrupt(cv, lk, [] { return false; });
+            } catch (const DBException& ex) {
+                fetcherErrorCodes.push_back(ex.code());
+                throw;
+            }
+        }
+
+        cv.wait(lk, [&] { return numFetchersWaiting == kMaxConcurrentFetches - 1; });
+        uasserted(ErrorCodes::NetworkTimeout, "network error");
+    };
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {};
+
+    ASSERT_THROWS_CODE(MigrationDestinationManager::cloneDocumentsFromDonor(
+                           operationContext(), insertBatchFn, fetchBatchFn, kMaxConcurrentFetches),
+                       DBException,
+                       ErrorCodes::NetworkTimeout);
+
+    ASSERT_EQ(static_cast<size_t>(kMaxConcurrentFetches - 1), fetcherErrorCodes.size());
+    for (auto code : fetcherErrorCodes) {
+        ASSERT_EQ(4900600, code);
+    }
+}
+
 // Tests that an exception in the insertion logic will successfully throw an exception on the
 // main thread.
 TEST_F(MigrationDestinationManagerTest, CloneDocumentsCatchesInsertErrors) {
@@ -53,9 +53,11 @@
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/migration_util.h"
 #include "mongo/db/s/persistent_task_store.h"
 #include "mongo/db/s/range_deletion_task_gen.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/wait_for_majority_service.h"
 #include "mongo/db/service_context.h"
@@ -64,6 +66,7 @@
 #include "mongo/executor/task_executor.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/future_util.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -298,6 +301,34 @@ void ensureRangeDeletionTaskStillExists(OperationContext* opCtx, const UUID& mig
     // holding any locks.
 }
 
+/**
+ * Returns the opTime which must be majority committed before the range deleter starts its next
+ * batch, or boost::none if it may go ahead right away. The deleter is only held back while the
+ * majority commit point trails this node by more than rangeDeleterMaxMajorityLagMS, so that
+ * secondaries which fall behind are not buried under more deletions.
+ */
+boost::optional<repl::OpTime> getOpTimeToThrottleRangeDeletionOn(OperationContext* opCtx) {
+    const Milliseconds maxMajorityLag(rangeDeleterMaxMajorityLagMS.load());
+    auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+    if (maxMajorityLag <= Milliseconds(0) ||
+        replCoord->getReplicationMode() != repl::ReplicationCoordinator::modeReplSet) {
+        return boost::none;
+    }
+
+    const auto lastOp = repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
+    const auto lastCommitted = replCoord->getLastCommittedOpTimeAndWallTime();
+    if (lastOp.isNull() || lastCommitted.opTime.isNull()) {
+        return boost::none;
+    }
+
+    const auto lastApplied = replCoord->getMyLastAppliedOpTimeAndWallTime();
+    if (lastApplied.wallTime - lastCommitted.wallTime <= maxMajorityLag) {
+        return boost::none;
+    }
+
+    return lastOp;
+}
+
 /**
  * Delete the range in a sequence of batches until there are no more documents to
  * delete or deletion returns an error.
@@ -310,9 +341,15 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                                           const boost::optional<UUID>& migrationId,
                                           int numDocsToRemovePerBatch,
                                           Milliseconds delayBetweenBatches) {
+    auto numDeletedInRange = std::make_shared<long long>(0);
+    const Timer rangeDeletionTimer;
+
     return AsyncTry([=] {
-               return withTemporaryOperationContext(
-                   [=](OperationContext* opCtx) {
+               int numDeleted = 0;
+               boost::optional<repl::OpTime> throttleOpTime;
+
+               withTemporaryOperationContext(
+                   [&](OperationContext* opCtx) {
                        LOGV2_DEBUG(5346200,
                                    1,
                                    "Starting batch deletion",
@@ -336,7 +373,7 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                            "deletion task. No need to delete documents.",
                            !collectionUuidHasChanged(nss, collection, collectionUuid));
 
-                       auto numDeleted = uassertStatusOK(deleteNextBatch(
+                       numDeleted = uassertStatusOK(deleteNextBatch(
                            opCtx, collection, keyPattern, range, numDocsToRemovePerBatch));
 
                        LOGV2_DEBUG(
@@ -350,9 +387,28 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                            "collectionUUID"_attr = collectionUuid,
                            "range"_attr = range.toString());
 
-                       return numDeleted;
+                       throttleOpTime = getOpTimeToThrottleRangeDeletionOn(opCtx);
                    },
                    nss);
+
+               *numDeletedInRange += numDeleted;
+
+               if (!throttleOpTime) {
+                   return ExecutorFuture<int>(executor, numDeleted);
+               }
+
+               auto& stats = ShardingStatistics::get(getGlobalServiceContext());
+               stats.countRangeDeletionBatchesThrottled.addAndFetch(1);
+
+               const Timer throttleTimer;
+               return WaitForMajorityService::get(getGlobalServiceContext())
+                   .waitUntilMajority(*throttleOpTime)
+                   .thenRunOn(executor)
+                   .then([&stats, throttleTimer, numDeleted] {
+                       stats.totalRangeDeletionThrottleTimeMillis.addAndFetch(
+                           throttleTimer.millis());
+                       return numDeleted;
+                   });
            })
         .until([](StatusWith<int> swNumDeleted) {
             // Continue iterating until there are no more documents to delete, retrying on
@@ -367,7 +423,16 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
         })
         .withDelayBetweenIterations(delayBetweenBatches)
         .on(executor)
-        .ignoreValue();
+        .then([=](int) {
+            const long long durationMillis = rangeDeletionTimer.millis();
+            LOGV2(5135230,
+                  "Finished deleting documents in range",
+                  "namespace"_attr = nss,
+                  "range"_attr = redact(range.toString()),
+                  "numDeleted"_attr = *numDeletedInRange,
+                  "durationMillis"_attr = durationMillis,
+                  "docsPerSecond"_attr = *numDeletedInRange * 1000 / std::max(durationMillis, 1LL));
+        });
 }
 
 /**
@@ -39,6 +39,7 @@
 #include "mongo/db/s/range_deletion_task_gen.h"
 #include "mongo/db/s/range_deletion_util.h"
 #include "mongo/db/s/sharding_runtime_d_params_gen.h"
+#include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/wait_for_majority_service.h"
 #include "mongo/s/shard_server_test_fixture.h"
 #include "mongo/unittest/death_test.h"
@@ -522,6 +523,65 @@ TEST_F(RangeDeleterTest, RemoveDocumentsInRangeWaitsForReplicationOnlyOnceAfterS
     ASSERT_EQ(numTimesWaitedForReplication, expectedNumTimesWaitedForReplication);
 }
 
+TEST_F(RangeDeleterTest, RemoveDocumentsInRangeWaitsForReplicationAfterEachBatchWhenLagging) {
+    auto replCoord = checked_cast<repl::ReplicationCoordinatorMock*>(
+        repl::ReplicationCoordinator::get(getServiceContext()));
+
+    const auto numDocsToInsert = 3;
+    const auto numDocsToRemovePerBatch = 1;
+
+    // The majority commit point is far behind the writes done by this node, so every batch which
+    // deletes something waits for majority replication. On top of that, we wait once after deleting
+    // the documents in the range and once after deleting the range deletion task.
+    replCoord->setLastCommittedOpTimeAndWallTime({repl::OpTime(Timestamp(1, 1), 1), Date_t()});
+    const auto expectedNumTimesWaitedForReplication = numDocsToInsert + 2;
+
+    DBDirectClient dbclient(operationContext());
+    for (auto i = 0; i < numDocsToInsert; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+
+    setFilteringMetadataWithUUID(uuid());
+    PersistentTaskStore<RangeDeletionTask> store(operationContext(),
+                                                 NamespaceString::kRangeDeletionNamespace);
+    const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
+    RangeDeletionTask t(
+        UUID::gen(), kNss, uuid(), ShardId("donor"), range, CleanWhenEnum::kDelayed);
+    const auto clusterTime = LogicalClock::get(operationContext())->getClusterTime();
+    t.setTimestamp(clusterTime.asTimestamp());
+    store.add(operationContext(), t);
+
+    int numTimesWaitedForReplication = 0;
+    replCoord->setAwaitReplicationReturnValueFunction(
+        [&](OperationContext* opCtx, const repl::OpTime& opTime) {
+            ++numTimesWaitedForReplication;
+            return repl::ReplicationCoordinator::StatusAndDuration(Status::OK(), Milliseconds(0));
+        });
+
+    auto& stats = ShardingStatistics::get(getServiceContext());
+    const auto batchesThrottledBefore = stats.countRangeDeletionBatchesThrottled.load();
+
+    auto queriesComplete = SemiFuture<void>::makeReady();
+    auto cleanupComplete =
+        removeDocumentsInRange(executor(),
+                               std::move(queriesComplete),
+                               kNss,
+                               uuid(),
+                               kShardKeyPattern,
+                               range,
+                               t.getId(),
+                               numDocsToRemovePerBatch,
+                               Seconds(0) /* delayForActiveQueriesOnSecondariesToComplete */,
+                               Milliseconds(0) /* delayBetweenBatches */);
+
+    cleanupComplete.get();
+
+    ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
+    ASSERT_EQ(numTimesWaitedForReplication, expectedNumTimesWaitedForReplication);
+    ASSERT_EQ(stats.countRangeDeletionBatchesThrottled.load() - batchesThrottledBefore,
+              numDocsToInsert);
+}
+
 TEST_F(RangeDeleterTest, RemoveDocumentsInRangeDoesNotWaitForReplicationIfErrorDuringDeletion) {
     auto replCoord = checked_cast<repl::ReplicationCoordinatorMock*>(
         repl::ReplicationCoordinator::get(getServiceContext()));
@@ -69,6 +69,15 @@ struct ShardingStatistics {
     // node by the rangeDeleter.
     AtomicWord<long long> countDocsDeletedOnDonor{0};
 
+    // Cumulative, always-increasing counter of how many batches of range deletions had to wait for
+    // majority replication before the next batch could start, because the majority commit point was
+    // lagging by more than rangeDeleterMaxMajorityLagMS.
+    AtomicWord<long long> countRangeDeletionBatchesThrottled{0};
+
+    // Cumulative, always-increasing counter of how much time the range deleter spent waiting for
+    // its batches to be majority committed because of replication lag.
+    AtomicWord<long long> totalRangeDeletionThrottleTimeMillis{0};
+
     // Cumulative, always-increasing counter of how many chunks this node started to receive
     // (whether the receiving succeeded or not)
     AtomicWord<long long> countRecipientMoveChunkStarted{0};
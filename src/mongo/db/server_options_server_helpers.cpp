@@ -307,7 +307,7 @@ Status storeServerOptions(const moe::Environment& params) {
 
     if (params.count("net.serviceExecutor")) {
         auto value = params["net.serviceExecutor"].as<std::string>();
-        const auto valid = {"synchronous"_sd, "adaptive"_sd};
+        const auto valid = {"synchronous"_sd, "adaptive"_sd, "workStealing"_sd};
         if (std::find(valid.begin(), valid.end(), value) == valid.end()) {
             return {ErrorCodes::BadValue, "Unsupported value for serviceExecutor"};
         }
@@ -31,6 +31,7 @@
 
 #include <valarray>
 
+#include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/concurrency/lock_stats.h"
@@ -127,5 +128,55 @@ public:
 
 } lockStatsServerStatusSection;
 
+
+class LockContentionServerStatusSection : public ServerStatusSection {
+public:
+    // Number of most waited on database and collection resources to report.
+    static constexpr size_t kNumTopWaitedResources = 10;
+
+    LockContentionServerStatusSection() : ServerStatusSection("lockContention") {}
+
+    // The histograms always have the same shape and are collected by FTDC. The most waited on
+    // resources change over time, so they are only reported with {includeTopWaitedResources: 1}.
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder ret;
+
+        {
+            SingleThreadedLockWaitTimeHistograms histograms;
+            reportGlobalLockWaitTimeHistograms(&histograms);
+
+            BSONObjBuilder histogramsBuilder(ret.subobjStart("waitTimeHistogramMicros"));
+            histograms.report(&histogramsBuilder);
+        }
+
+        if (configElement.type() == BSONType::Object &&
+            configElement.Obj()["includeTopWaitedResources"].trueValue()) {
+            auto& catalog = CollectionCatalog::get(opCtx);
+
+            BSONArrayBuilder topBuilder(ret.subarrayStart("topWaitedResources"));
+            for (const auto& entry : getGlobalTopContendedResources(kNumTopWaitedResources)) {
+                BSONObjBuilder entryBuilder(topBuilder.subobjStart());
+
+                // Several namespaces may map to the same ResourceId, in which case the name is
+                // ambiguous and the ResourceId is reported instead.
+                auto name = catalog.lookupResourceName(entry.resId);
+                entryBuilder.append("resource", name ? *name : entry.resId.toString());
+                entryBuilder.append("type", resourceTypeName(entry.resId.getType()));
+                entryBuilder.append("waitCount", entry.waitCount);
+                entryBuilder.append("waitTimeMicros", entry.waitTimeMicros);
+                entryBuilder.append("errorMicros", entry.errorMicros);
+            }
+        }
+
+        return ret.obj();
+    }
+
+} lockContentionServerStatusSection;
+
 }  // namespace
 }  // namespace mongo
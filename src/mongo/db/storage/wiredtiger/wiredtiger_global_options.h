@@ -58,6 +58,7 @@ public:
     std::string engineConfig;
 
     std::string collectionBlockCompressor;
+    std::string oplogBlockCompressor;
     std::string indexBlockCompressor;
     bool useCollectionPrefixCompression;
     bool useIndexPrefixCompression;
@@ -758,7 +758,13 @@ StatusWith<std::string> WiredTigerRecordStore::generateCreateString(
         ss << "prefix_compression,";
     }
 
-    ss << "block_compressor=" << wiredTigerGlobalOptions.collectionBlockCompressor << ",";
+    // The oplog repeats the same field names and namespaces in every entry, so it may be
+    // configured with a stronger block compressor than the rest of the collections.
+    if (NamespaceString::oplog(ns) && !wiredTigerGlobalOptions.oplogBlockCompressor.empty()) {
+        ss << "block_compressor=" << wiredTigerGlobalOptions.oplogBlockCompressor << ",";
+    } else {
+        ss << "block_compressor=" << wiredTigerGlobalOptions.collectionBlockCompressor << ",";
+    }
 
     ss << WiredTigerCustomizationHooks::get(getGlobalServiceContext())->getTableCreateConfig(ns);
 
@@ -0,0 +1,218 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * Measures the throughput of applying oplog entries from a stable timestamp through
+ * ReplicationRecoveryImpl, which is the code path used by startup recovery and by rollback.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kTest
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/client.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/global_settings.h"
+#include "mongo/db/logical_clock.h"
+#include "mongo/db/op_observer_registry.h"
+#include "mongo/db/repl/oplog.h"
+#include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/replication_consistency_markers_mock.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/repl/replication_recovery.h"
+#include "mongo/db/repl/storage_interface_impl.h"
+#include "mongo/db/s/op_observer_sharding_impl.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/dbtests/dbtests.h"
+#include "mongo/logv2/log.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * StorageInterfaceImpl that reports a recovery timestamp chosen by the test, so recovery can be
+ * driven from a "stable checkpoint" without restarting the storage engine.
+ */
+class StorageInterfaceRecovery : public repl::StorageInterfaceImpl {
+public:
+    bool supportsRecoveryTimestamp(ServiceContext* serviceCtx) const override {
+        return true;
+    }
+
+    boost::optional<Timestamp> getRecoveryTimestamp(ServiceContext* serviceCtx) const override {
+        return _recoveryTimestamp;
+    }
+
+    void setRecoveryTimestamp(Timestamp recoveryTimestamp) {
+        _recoveryTimestamp = recoveryTimestamp;
+    }
+
+private:
+    Timestamp _recoveryTimestamp;
+};
+
+/**
+ * Writes 'NumOps' insert oplog entries after a no-op entry at the stable timestamp, then replays
+ * them with ReplicationRecoveryImpl::recoverFromOplog() and logs the observed throughput.
+ */
+template <int NumOps>
+class RecoveryThroughput {
+public:
+    RecoveryThroughput() {
+        repl::ReplSettings replSettings;
+        replSettings.setOplogSizeBytes(512 * 1024 * 1024);
+        replSettings.setReplSetString("rs0");
+        setGlobalReplSettings(replSettings);
+        auto coordinatorMock =
+            new repl::ReplicationCoordinatorMock(_opCtx->getServiceContext(), replSettings);
+        coordinatorMock->alwaysAllowWrites(true);
+        repl::ReplicationCoordinator::set(
+            _opCtx->getServiceContext(),
+            std::unique_ptr<repl::ReplicationCoordinator>(coordinatorMock));
+        repl::StorageInterface::set(_opCtx->getServiceContext(),
+                                    std::make_unique<repl::StorageInterfaceImpl>());
+        repl::ReplClientInfo::forClient(_opCtx->getClient()).clearLastOp_forTest();
+
+        auto registry = std::make_unique<OpObserverRegistry>();
+        registry->addObserver(std::make_unique<OpObserverShardingImpl>());
+        _opCtx->getServiceContext()->setOpObserver(std::move(registry));
+
+        repl::setOplogCollectionName(getGlobalServiceContext());
+        repl::createOplog(_opCtx);
+    }
+
+    ~RecoveryThroughput() {
+        repl::UnreplicatedWritesBlock uwb(_opCtx);
+        _storageInterface.dropCollection(_opCtx, _nss).transitional_ignore();
+        _storageInterface.truncateCollection(_opCtx, NamespaceString::kRsOplogNamespace)
+            .transitional_ignore();
+    }
+
+    void run() {
+        const auto clock = LogicalClock::get(_opCtx);
+        const Timestamp stableTimestamp = clock->reserveTicks(1).asTimestamp();
+        const long long term = 1;
+
+        UUID uuid = _createCollection();
+
+        std::vector<InsertStatement> oplogEntries;
+        oplogEntries.reserve(NumOps + 1);
+        oplogEntries.emplace_back(BSON("ts" << stableTimestamp << "t" << term << "v" << 2 << "op"
+                                            << "n"
+                                            << "ns"
+                                            << ""
+                                            << "wall" << Date_t() << "o"
+                                            << BSON("msg"
+                                                    << "stable timestamp")),
+                                  stableTimestamp,
+                                  term);
+        for (int i = 0; i < NumOps; ++i) {
+            const Timestamp ts = clock->reserveTicks(1).asTimestamp();
+            oplogEntries.emplace_back(
+                BSON("ts" << ts << "t" << term << "v" << 2 << "op"
+                          << "i"
+                          << "ns" << _nss.ns() << "ui" << uuid << "wall" << Date_t() << "o"
+                          << BSON("_id" << i << "x" << i)),
+                ts,
+                term);
+        }
+        ASSERT_OK(_storageInterface.insertDocuments(
+            _opCtx, NamespaceString::kRsOplogNamespace, oplogEntries));
+
+        _storageInterface.setRecoveryTimestamp(stableTimestamp);
+        repl::ReplicationConsistencyMarkersMock consistencyMarkers;
+        repl::ReplicationRecoveryImpl recovery(&_storageInterface, &consistencyMarkers);
+
+        Timer timer;
+        recovery.recoverFromOplog(_opCtx, stableTimestamp);
+        const auto micros = timer.micros();
+
+        DBDirectClient client(_opCtx);
+        ASSERT_EQ(static_cast<unsigned long long>(NumOps), client.count(_nss));
+
+        LOGV2(5135201,
+              "Replication recovery throughput",
+              "numOps"_attr = NumOps,
+              "writerThreads"_attr = repl::replWriterThreadCount,
+              "durationMillis"_attr = micros / 1000,
+              "opsPerSecond"_attr = micros > 0 ? NumOps * 1000LL * 1000LL / micros : 0);
+    }
+
+private:
+    UUID _createCollection() {
+        repl::UnreplicatedWritesBlock uwb(_opCtx);
+        ASSERT_OK(_storageInterface.createCollection(_opCtx, _nss, CollectionOptions()));
+        AutoGetCollectionForRead autoColl(_opCtx, _nss);
+        return autoColl.getCollection()->uuid();
+    }
+
+    ServiceContext::UniqueOperationContext _opCtxRaii = cc().makeOperationContext();
+    OperationContext* _opCtx = _opCtxRaii.get();
+    const NamespaceString _nss{"unittests.replication_recovery_throughput"};
+    StorageInterfaceRecovery _storageInterface;
+};
+
+class ReplicationRecoveryThroughputSuite : public unittest::OldStyleSuiteSpecification {
+public:
+    ReplicationRecoveryThroughputSuite()
+        : unittest::OldStyleSuiteSpecification("replication_recovery_throughput") {}
+
+    // Must be evaluated at test run() time, not static-init time.
+    static bool shouldSkip() {
+        // Recovery from a stable timestamp requires timestamped writes.
+        auto storageEngine = cc().getServiceContext()->getStorageEngine();
+        return !storageEngine->supportsReadConcernSnapshot() ||
+            !serverGlobalParams.enableMajorityReadConcern;
+    }
+
+    template <typename T>
+    void addIf() {
+        addNameCallback(nameForTestClass<T>(), [] {
+            if (!shouldSkip())
+                T().run();
+        });
+    }
+
+    void setupTests() {
+        addIf<RecoveryThroughput<1000>>();
+        addIf<RecoveryThroughput<10000>>();
+    }
+};
+
+unittest::OldStyleSuiteInitializer<ReplicationRecoveryThroughputSuite>
+    replicationRecoveryThroughputSuite;
+
+}  // namespace
+}  // namespace mongo
@@ -275,6 +275,22 @@ public:
      */
     Future<ConnectionHandle> getConnection(Milliseconds timeout);
 
+    /**
+     * Checks out the most recently used idle connection without checking its health, or returns
+     * nullptr if there are no idle connections or if earlier requests are still waiting. This lets
+     * ConnectionPool::get() run the health check, which polls the socket, without holding the
+     * pool-wide mutex. The caller must either hand the connection out with makeHandle() or give it
+     * back with dropUnhealthyConnection().
+     */
+    ConnectionInterface* checkOutIdleConnection();
+
+    /**
+     * Destroys a connection from checkOutIdleConnection() that failed its health check.
+     */
+    void dropUnhealthyConnection(ConnectionInterface* connPtr);
+
+    ConnectionHandle makeHandle(ConnectionInterface* connection);
+
     /**
      * Triggers the shutdown procedure. This function sets isShutdown to true
      * and calls processFailure below with the status provided. This immediately removes this pool
@@ -361,8 +377,6 @@ private:
         }
     };
 
-    ConnectionHandle makeHandle(ConnectionInterface* connection);
-
     /**
      * Establishes connections until the ControllerInterface's target is met.
      */
@@ -550,21 +564,42 @@ void ConnectionPool::get_forTest(const HostAndPort& hostAndPort,
 SemiFuture<ConnectionPool::ConnectionHandle> ConnectionPool::get(const HostAndPort& hostAndPort,
                                                                  transport::ConnectSSLMode sslMode,
                                                                  Milliseconds timeout) {
-    stdx::lock_guard lk(_mutex);
+    stdx::unique_lock lk(_mutex);
+
+    while (true) {
+        auto& pool = _pools[hostAndPort];
+        if (!pool) {
+            pool = SpecificPool::make(shared_from_this(), hostAndPort, sslMode);
+        } else {
+            pool->fassertSSLModeIs(sslMode);
+        }
 
-    auto& pool = _pools[hostAndPort];
-    if (!pool) {
-        pool = SpecificPool::make(shared_from_this(), hostAndPort, sslMode);
-    } else {
-        pool->fassertSSLModeIs(sslMode);
-    }
+        invariant(pool);
 
-    invariant(pool);
+        auto connPtr = pool->checkOutIdleConnection();
+        if (!connPtr) {
+            auto connFuture = pool->getConnection(timeout);
+            pool->updateState();
+
+            return std::move(connFuture).semi();
+        }
+        pool->updateState();
+
+        // Checking the health of an idle connection polls its socket, so do it without blocking
+        // every other host behind the pool-wide mutex. The connection is already checked out, so
+        // nothing else can touch it in the meantime.
+        auto anchor = pool;
+        lk.unlock();
 
-    auto connFuture = pool->getConnection(timeout);
-    pool->updateState();
+        if (connPtr->isHealthy()) {
+            connPtr->resetToUnknown();
+            return SemiFuture<ConnectionHandle>::makeReady(anchor->makeHandle(connPtr));
+        }
 
-    return std::move(connFuture).semi();
+        lk.lock();
+        anchor->dropUnhealthyConnection(connPtr);
+        anchor->updateState();
+    }
 }
 
 void ConnectionPool::appendConnectionStats(ConnectionPoolStats* stats) const {
@@ -645,19 +680,8 @@ Future<ConnectionPool::ConnectionHandle> ConnectionPool::SpecificPool::getConnec
     auto now = _parent->_factory->now();
     _lastActiveTime = now;
 
-    // If we do not have requests, then we can fulfill immediately
-    if (_requests.size() == 0) {
-        auto conn = tryGetConnection();
-
-        if (conn) {
-            LOGV2_DEBUG(22559,
-                        kDiagnosticLogLevel,
-                        "Using existing idle connection to {hostAndPort}",
-                        "Using existing idle connection",
-                        "hostAndPort"_attr = _hostAndPort);
-            return Future<ConnectionPool::ConnectionHandle>::makeReady(std::move(conn));
-        }
-    }
+    // Idle connections are handed out by checkOutIdleConnection() before we get here, so this
+    // request has to wait for a connection to be returned or established.
 
     auto pendingTimeout = _parent->_controller->pendingTimeout();
     if (timeout < Milliseconds(0) || timeout > pendingTimeout) {
@@ -679,6 +703,42 @@ Future<ConnectionPool::ConnectionHandle> ConnectionPool::SpecificPool::getConnec
     return std::move(pf.future);
 }
 
+auto ConnectionPool::SpecificPool::checkOutIdleConnection() -> ConnectionInterface* {
+    if (!_requests.empty() || _readyPool.empty()) {
+        return nullptr;
+    }
+
+    _lastActiveTime = _parent->_factory->now();
+
+    // _readyPool is an LRUCache, so its begin() object is the MRU item.
+    auto iter = _readyPool.begin();
+
+    // Grab the connection and cancel its timeout
+    auto conn = std::move(iter->second);
+    _readyPool.erase(iter);
+    conn->cancelTimeout();
+
+    auto connPtr = conn.get();
+    _checkedOutPool[connPtr] = std::move(conn);
+
+    LOGV2_DEBUG(22559,
+                kDiagnosticLogLevel,
+                "Using existing idle connection to {hostAndPort}",
+                "Using existing idle connection",
+                "hostAndPort"_attr = _hostAndPort);
+    return connPtr;
+}
+
+void ConnectionPool::SpecificPool::dropUnhealthyConnection(ConnectionInterface* connPtr) {
+    LOGV2(5135220,
+          "Dropping unhealthy pooled connection",
+          "hostAndPort"_attr = connPtr->getHostAndPort());
+
+    // Drop the bad connection via scoped destruction
+    auto conn = takeFromPool(_checkedOutPool, connPtr);
+    invariant(conn);
+}
+
 auto ConnectionPool::SpecificPool::makeHandle(ConnectionInterface* connection) -> ConnectionHandle {
     auto deleter = [this, anchor = shared_from_this()](ConnectionInterface* connection) {
         stdx::lock_guard lk(_parent->_mutex);
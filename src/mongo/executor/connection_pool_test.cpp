@@ -142,6 +142,39 @@ TEST_F(ConnectionPoolTest, SameConn) {
     ASSERT_EQ(conn1Id, conn2Id);
 }
 
+/**
+ * Verify that an idle connection which fails its health check on checkout is dropped and replaced
+ * by a new connection.
+ */
+TEST_F(ConnectionPoolTest, UnhealthyIdleConnectionIsReplaced) {
+    auto pool = makePool();
+
+    size_t conn1Id = 0;
+    ConnectionImpl::pushSetup(Status::OK());
+    pool->get_forTest(HostAndPort(),
+                      Milliseconds(5000),
+                      [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                          conn1Id = verifyAndGetId(swConn);
+                          dynamic_cast<ConnectionImpl*>(swConn.getValue().get())
+                              ->setHealthy(false);
+                          doneWith(swConn.getValue());
+                      });
+    ASSERT(conn1Id);
+    ASSERT_EQ(pool->getNumConnectionsPerHost(HostAndPort()), 1U);
+
+    size_t conn2Id = 0;
+    ConnectionImpl::pushSetup(Status::OK());
+    pool->get_forTest(HostAndPort(),
+                      Milliseconds(5000),
+                      [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                          conn2Id = verifyAndGetId(swConn);
+                          doneWith(swConn.getValue());
+                      });
+    ASSERT(conn2Id);
+    ASSERT_NE(conn1Id, conn2Id);
+    ASSERT_EQ(pool->getNumConnectionsPerHost(HostAndPort()), 1U);
+}
+
 /**
  * Verify that connections are obtained in MRU order.
  */
@@ -104,7 +104,7 @@ const HostAndPort& ConnectionImpl::getHostAndPort() const {
 }
 
 bool ConnectionImpl::isHealthy() {
-    return true;
+    return _healthy;
 }
 
 void ConnectionImpl::clear() {
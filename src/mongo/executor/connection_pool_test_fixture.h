@@ -93,6 +93,11 @@ public:
 
     bool isHealthy() override;
 
+    // Controls what isHealthy() reports for this connection
+    void setHealthy(bool healthy) {
+        _healthy = healthy;
+    }
+
     // Dump all connection callbacks
     static void clear();
 
@@ -126,6 +131,7 @@ private:
     TimerImpl _timer;
     PoolImpl* _global;
     size_t _id;
+    bool _healthy = true;
 
     // Answer queues
     static std::deque<PushSetupCallback> _pushSetupQueue;
@@ -71,6 +71,32 @@ void NetworkTestEnv::onCommands(std::vector<OnCommandFunction> funcs) {
     _mockNetwork->runReadyNetworkOperations();
 }
 
+void NetworkTestEnv::onConcurrentCommands(std::vector<OnCommandFunction> funcs) {
+    executor::NetworkInterfaceMock::InNetworkGuard guard(_mockNetwork);
+
+    std::vector<NetworkInterfaceMock::NetworkOperationIterator> nois;
+    for (size_t i = 0; i < funcs.size(); ++i) {
+        nois.push_back(_mockNetwork->getNextReadyRequest());
+    }
+
+    for (size_t i = funcs.size(); i-- > 0;) {
+        auto resultStatus = funcs[i](nois[i]->getRequest());
+
+        if (resultStatus.isOK()) {
+            BSONObjBuilder result(std::move(resultStatus.getValue()));
+            CommandHelpers::appendCommandStatusNoThrow(result, resultStatus.getStatus());
+            const RemoteCommandResponse response(result.obj(), Milliseconds(1));
+
+            _mockNetwork->scheduleResponse(nois[i], _mockNetwork->now(), response);
+        } else {
+            _mockNetwork->scheduleResponse(
+                nois[i], _mockNetwork->now(), {resultStatus.getStatus(), Milliseconds(0)});
+        }
+    }
+
+    _mockNetwork->runReadyNetworkOperations();
+}
+
 void NetworkTestEnv::onCommandWithMetadata(OnCommandWithMetadataFunction func) {
     executor::NetworkInterfaceMock::InNetworkGuard guard(_mockNetwork);
 
@@ -181,6 +181,13 @@ public:
      */
     void onCommand(OnCommandFunction func);
     void onCommands(std::vector<OnCommandFunction> funcs);
+
+    /**
+     * Receives funcs.size() messages before responding to any of them, then responds to them in
+     * reverse order of arrival, each using the response of the function at the same position.
+     * Blocks forever unless all of the requests are outstanding at the same time.
+     */
+    void onConcurrentCommands(std::vector<OnCommandFunction> funcs);
     void onCommandWithMetadata(OnCommandWithMetadataFunction func);
     void onFindCommand(OnFindCommandFunction func);
     void onFindWithMetadataCommand(OnFindCommandWithMetadataFunction func);
@@ -912,6 +912,40 @@ TEST(OpMsgRequest, FromDbAndBodyDoesNotCopy) {
     ASSERT_EQ(static_cast<const void*>(msg.body.objdata()), bodyPtr);
 }
 
+TEST(OpMsgRequest, ParseOwnedDoesNotCopySequences) {
+    auto message = OpMsgBytes{
+        kNoFlags,  //
+        kBodySection,
+        fromjson("{insert: 'coll', $db: 'db'}"),
+
+        kDocSequenceSection,
+        Sized{
+            "documents",  //
+            fromjson("{a: 1}"),
+            fromjson("{a: 2}"),
+        },
+    }
+                       .done();
+    const char* const begin = message.buf();
+    const char* const end = begin + message.size();
+
+    // Both the body and the sequence documents are views into the received message and keep it
+    // alive, rather than owned copies.
+    auto msg = OpMsgRequest::parseOwned(message);
+    message.reset();
+
+    ASSERT(msg.body.isOwned());
+    ASSERT_GTE(msg.body.objdata(), begin);
+    ASSERT_LT(msg.body.objdata(), end);
+    ASSERT_EQ(msg.sequences.size(), 1u);
+    for (auto&& obj : msg.sequences[0].objs) {
+        ASSERT(obj.isOwned());
+        ASSERT_GTE(obj.objdata(), begin);
+        ASSERT_LT(obj.objdata(), end);
+    }
+    ASSERT_BSONOBJ_EQ(msg.sequences[0].objs[1], fromjson("{a: 2}"));
+}
+
 TEST(OpMsgTest, ChecksumResizesMessage) {
     auto msg = OpMsgBytes{kNoFlags,  //
                           kBodySection,
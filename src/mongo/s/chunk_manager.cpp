@@ -45,6 +45,7 @@
 #include "mongo/s/chunk_writes_tracker.h"
 #include "mongo/s/mongos_server_parameters_gen.h"
 #include "mongo/s/shard_invalidated_for_targeting_exception.h"
+#include "mongo/stdx/unordered_set.h"
 
 namespace mongo {
 namespace {
@@ -52,6 +53,18 @@ namespace {
 // Used to generate sequence numbers to assign to each newly created RoutingTableHistory
 AtomicWord<unsigned> nextCMSequenceNumber(0);
 
+// Number of chunks per ChunkInfoMap block when a map is built from scratch. Blocks are split in two
+// when changes grow them to twice this size.
+constexpr size_t kChunkInfoMapBlockSize = 256;
+
+// Upper bound on the number of buckets in the hashed lookup table of a ChunkInfoMap, in bits
+constexpr int kMaxHashedIndexBits = 16;
+
+// Maps a signed hash value onto an unsigned value with the same ordering
+uint64_t biasHashedValue(long long value) {
+    return static_cast<uint64_t>(value) ^ (uint64_t(1) << 63);
+}
+
 bool allElementsAreOfType(BSONType type, const BSONObj& obj) {
     for (auto&& elem : obj) {
         if (elem.type() != type) {
@@ -88,7 +101,8 @@ RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
                                          std::unique_ptr<CollatorInterface> defaultCollator,
                                          bool unique,
                                          ChunkInfoMap chunkMap,
-                                         ChunkVersion collectionVersion)
+                                         ChunkVersion collectionVersion,
+                                         boost::optional<ShardVersionMap> shardVersions)
     : _sequenceNumber(nextCMSequenceNumber.addAndFetch(1)),
       _nss(std::move(nss)),
       _uuid(uuid),
@@ -98,7 +112,213 @@ RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
       _unique(unique),
       _chunkMap(std::move(chunkMap)),
       _collectionVersion(collectionVersion),
-      _shardVersions(_constructShardVersionMap()) {}
+      _shardVersions(shardVersions ? std::move(*shardVersions) : _constructShardVersionMap()) {}
+
+ChunkInfoMap::ChunkInfoMap(std::vector<value_type> chunks, bool indexHashedMaxes)
+    : _size(chunks.size()), _indexHashedMaxes(indexHashedMaxes) {
+    _blocks.reserve((chunks.size() + kChunkInfoMapBlockSize - 1) / kChunkInfoMapBlockSize);
+    for (size_t i = 0; i < chunks.size(); i += kChunkInfoMapBlockSize) {
+        const auto first = chunks.begin() + i;
+        const auto last = chunks.begin() + std::min(i + kChunkInfoMapBlockSize, chunks.size());
+        _blocks.push_back(_makeBlock(std::vector<value_type>(std::make_move_iterator(first),
+                                                             std::make_move_iterator(last))));
+    }
+    rebuildHashedIndex();
+}
+
+ChunkInfoMap::const_iterator ChunkInfoMap::lower_bound(StringData key) const {
+    // The first block whose last key is not less than "key" contains the result
+    const auto blockIt = std::lower_bound(
+        _blocks.begin(), _blocks.end(), key, [](const BlockPtr& block, StringData key) {
+            return StringData(block->chunks.back().first) < key;
+        });
+    if (blockIt == _blocks.end()) {
+        return end();
+    }
+
+    const auto& chunks = (*blockIt)->chunks;
+    const auto it = std::lower_bound(
+        chunks.begin(), chunks.end(), key, [](const value_type& entry, StringData key) {
+            return StringData(entry.first) < key;
+        });
+    return {_blocks.data(), size_t(blockIt - _blocks.begin()), size_t(it - chunks.begin())};
+}
+
+ChunkInfoMap::const_iterator ChunkInfoMap::upper_bound(StringData key) const {
+    // The first block whose last key is greater than "key" contains the result
+    const auto blockIt = std::upper_bound(
+        _blocks.begin(), _blocks.end(), key, [](StringData key, const BlockPtr& block) {
+            return key < StringData(block->chunks.back().first);
+        });
+    if (blockIt == _blocks.end()) {
+        return end();
+    }
+
+    const auto& chunks = (*blockIt)->chunks;
+    const auto it = std::upper_bound(
+        chunks.begin(), chunks.end(), key, [](StringData key, const value_type& entry) {
+            return key < StringData(entry.first);
+        });
+    return {_blocks.data(), size_t(blockIt - _blocks.begin()), size_t(it - chunks.begin())};
+}
+
+const std::shared_ptr<ChunkInfo>& ChunkInfoMap::at(StringData key) const {
+    const auto it = lower_bound(key);
+    invariant(it != end() && StringData(it->first) == key);
+    return it->second;
+}
+
+boost::optional<ChunkInfoMap::const_iterator> ChunkInfoMap::findHashed(long long value) const {
+    if (_hashedBucketStarts.empty()) {
+        return boost::none;
+    }
+
+    // The bucket points at the first block which can contain the smallest value in the bucket, so
+    // the block containing "value" is usually that one or the next.
+    const auto bucket = biasHashedValue(value) >> _hashedBucketShift;
+    for (size_t blockIdx = _hashedBucketStarts[bucket]; blockIdx < _blocks.size(); ++blockIdx) {
+        const auto& block = *_blocks[blockIdx];
+        if (!block.endsWithMaxKey && block.hashedMaxes.back() <= value) {
+            continue;
+        }
+
+        const auto it = std::upper_bound(block.hashedMaxes.begin(), block.hashedMaxes.end(), value);
+        return const_iterator{_blocks.data(), blockIdx, size_t(it - block.hashedMaxes.begin())};
+    }
+
+    return end();
+}
+
+void ChunkInfoMap::replaceRange(const_iterator first, const_iterator last, value_type entry) {
+    _hashedBucketStarts.clear();
+
+    if (_blocks.empty()) {
+        std::vector<value_type> chunks;
+        chunks.push_back(std::move(entry));
+        _blocks.push_back(_makeBlock(std::move(chunks)));
+        _size = 1;
+        return;
+    }
+
+    // Express both ends of the range as positions within the blocks that they touch, so that
+    // everything from 'startBlock' to 'endBlock' is rewritten.
+    size_t startBlock = first._block;
+    size_t startPos = first._pos;
+    if (startBlock == _blocks.size()) {
+        startBlock = _blocks.size() - 1;
+        startPos = _blocks[startBlock]->chunks.size();
+    }
+
+    size_t endBlock = last._block;
+    size_t endPos = last._pos;
+    if (endBlock == _blocks.size() || (endPos == 0 && endBlock > startBlock)) {
+        endBlock = endBlock - 1;
+        endPos = _blocks[endBlock]->chunks.size();
+    }
+
+    size_t numErased = 0;
+    for (size_t blockIdx = startBlock; blockIdx <= endBlock; ++blockIdx) {
+        numErased += _blocks[blockIdx]->chunks.size();
+    }
+    numErased -= startPos + (_blocks[endBlock]->chunks.size() - endPos);
+
+    // Entries can be moved out of blocks which no other map shares, but must be copied otherwise
+    std::vector<value_type> chunks;
+    chunks.reserve(startPos + 1 + _blocks[endBlock]->chunks.size() - endPos);
+    const auto appendFromBlock = [&](size_t blockIdx, size_t from, size_t to) {
+        auto& block = _blocks[blockIdx];
+        const auto first = block->chunks.begin() + from;
+        const auto last = block->chunks.begin() + to;
+        if (block.use_count() == 1) {
+            chunks.insert(
+                chunks.end(), std::make_move_iterator(first), std::make_move_iterator(last));
+        } else {
+            chunks.insert(chunks.end(), first, last);
+        }
+    };
+    appendFromBlock(startBlock, 0, startPos);
+    chunks.push_back(std::move(entry));
+    appendFromBlock(endBlock, endPos, _blocks[endBlock]->chunks.size());
+
+    std::vector<BlockPtr> newBlocks;
+    if (chunks.size() >= 2 * kChunkInfoMapBlockSize) {
+        const auto middle = chunks.begin() + chunks.size() / 2;
+        newBlocks.push_back(_makeBlock(std::vector<value_type>(
+            std::make_move_iterator(chunks.begin()), std::make_move_iterator(middle))));
+        newBlocks.push_back(_makeBlock(std::vector<value_type>(
+            std::make_move_iterator(middle), std::make_move_iterator(chunks.end()))));
+    } else {
+        newBlocks.push_back(_makeBlock(std::move(chunks)));
+    }
+
+    _blocks.erase(_blocks.begin() + startBlock, _blocks.begin() + endBlock + 1);
+    _blocks.insert(_blocks.begin() + startBlock, newBlocks.begin(), newBlocks.end());
+    _size = _size - numErased + 1;
+}
+
+void ChunkInfoMap::rebuildHashedIndex() {
+    _hashedBucketStarts.clear();
+    if (!_indexHashedMaxes || _blocks.empty()) {
+        return;
+    }
+
+    // Chunk bounds on a hashed field are hash values, but chunks can also be split at arbitrary
+    // points, in which case lookups have to use KeyStrings.
+    for (const auto& block : _blocks) {
+        if (!block->hasHashedMaxes) {
+            return;
+        }
+    }
+
+    // Hashed values are spread uniformly, so about one bucket per block makes the first block a
+    // bucket points at almost always the right one.
+    int bits = 1;
+    while (bits < kMaxHashedIndexBits && (size_t(1) << bits) < _blocks.size()) {
+        ++bits;
+    }
+    _hashedBucketShift = 64 - bits;
+
+    const size_t numBuckets = size_t(1) << bits;
+    _hashedBucketStarts.resize(numBuckets);
+    size_t blockIdx = 0;
+    for (size_t bucket = 0; bucket < numBuckets; ++bucket) {
+        // Biasing is its own inverse, so this is the smallest hash value in the bucket
+        const auto bucketMin = static_cast<long long>(
+            biasHashedValue(static_cast<long long>(uint64_t(bucket) << _hashedBucketShift)));
+        while (blockIdx < _blocks.size() && !_blocks[blockIdx]->endsWithMaxKey &&
+               _blocks[blockIdx]->hashedMaxes.back() <= bucketMin) {
+            ++blockIdx;
+        }
+        _hashedBucketStarts[bucket] = blockIdx;
+    }
+}
+
+ChunkInfoMap::BlockPtr ChunkInfoMap::_makeBlock(std::vector<value_type> chunks) const {
+    invariant(!chunks.empty());
+
+    auto block = std::make_shared<Block>();
+    block->chunks = std::move(chunks);
+
+    if (_indexHashedMaxes) {
+        const auto& blockChunks = block->chunks;
+        block->hasHashedMaxes = true;
+        block->hashedMaxes.reserve(blockChunks.size());
+        for (size_t i = 0; i < blockChunks.size(); ++i) {
+            const auto maxElem = blockChunks[i].second->getMax().firstElement();
+            if (maxElem.type() == NumberLong) {
+                block->hashedMaxes.push_back(maxElem._numberLong());
+            } else if (maxElem.type() == MaxKey && i + 1 == blockChunks.size()) {
+                block->endsWithMaxKey = true;
+            } else {
+                block->hasHashedMaxes = false;
+                block->hashedMaxes.clear();
+                break;
+            }
+        }
+    }
+
+    return block;
+}
 
 void RoutingTableHistory::setShardStale(const ShardId& shardId) {
     if (gEnableFinerGrainedCatalogCacheRefresh) {
@@ -142,7 +362,7 @@ Chunk ChunkManager::findIntersectingChunk(const BSONObj& shardKey,
         }
     }
 
-    const auto it = _rt->getChunkMap().upper_bound(_rt->_extractKeyString(shardKey));
+    const auto it = _rt->_findIntersectingChunk(shardKey);
     uassert(ErrorCodes::ShardKeyNotFound,
             str::stream() << "Cannot target single shard using key " << shardKey
                           << " for namespace " << getns(),
@@ -155,7 +375,7 @@ bool ChunkManager::keyBelongsToShard(const BSONObj& shardKey, const ShardId& sha
     if (shardKey.isEmpty())
         return false;
 
-    const auto it = _rt->getChunkMap().upper_bound(_rt->_extractKeyString(shardKey));
+    const auto it = _rt->_findIntersectingChunk(shardKey);
     if (it == _rt->getChunkMap().end())
         return false;
 
@@ -272,8 +492,7 @@ bool ChunkManager::rangeOverlapsShard(const ChunkRange& range, const ShardId& sh
 
 ChunkManager::ConstRangeOfChunks ChunkManager::getNextChunkOnShard(const BSONObj& shardKey,
                                                                    const ShardId& shardId) const {
-    for (auto it = _rt->getChunkMap().upper_bound(_rt->_extractKeyString(shardKey));
-         it != _rt->getChunkMap().end();
+    for (auto it = _rt->_findIntersectingChunk(shardKey); it != _rt->getChunkMap().end();
          ++it) {
         const auto& chunk = it->second;
         if (chunk->getShardIdAt(_clusterTime) == shardId) {
@@ -588,6 +807,18 @@ std::string RoutingTableHistory::_extractKeyString(const BSONObj& shardKeyValue)
     return extractKeyStringInternal(shardKeyValue, _shardKeyOrdering);
 }
 
+ChunkInfoMap::const_iterator RoutingTableHistory::_findIntersectingChunk(
+    const BSONObj& shardKey) const {
+    const auto elem = shardKey.firstElement();
+    if (elem.type() == NumberLong) {
+        if (auto it = _chunkMap.findHashed(elem._numberLong())) {
+            return *it;
+        }
+    }
+
+    return _chunkMap.upper_bound(_extractKeyString(shardKey));
+}
+
 std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeNew(
     NamespaceString nss,
     boost::optional<UUID> uuid,
@@ -601,7 +832,7 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeNew(
                                std::move(shardKeyPattern),
                                std::move(defaultCollator),
                                std::move(unique),
-                               {},
+                               ChunkInfoMap(),
                                {0, 0, epoch})
         .makeUpdated(chunks);
 }
@@ -610,10 +841,21 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
     const std::vector<ChunkType>& changedChunks) {
 
     const auto startingCollectionVersion = getVersion();
-    auto chunkMap = _chunkMap;
+    const bool indexHashedMaxes =
+        _shardKeyPattern.isHashedPattern() && _shardKeyPattern.toBSON().nFields() == 1;
+
+    // A handful of changes, such as those made by a migration, are applied to a copy of the
+    // current chunk map which shares all of the blocks they do not touch. Larger changes, and the
+    // initial load in particular, are applied to a tree which is then flattened into a new map.
+    const bool applyIncrementally = !_chunkMap.empty() &&
+        changedChunks.size() <= _chunkMap.size() / kChunkInfoMapBlockSize;
 
     ChunkVersion collectionVersion = startingCollectionVersion;
-    for (const auto& chunk : changedChunks) {
+
+    // Applies "chunk" to "chunkMap" by replacing every chunk whose max falls within the new chunk's
+    // range with the new chunk. "chunkMap" is either a ChunkInfoMap or a std::map of the same
+    // entries, and "replaceRange" does the actual replacement.
+    const auto applyChange = [&](auto& chunkMap, const ChunkType& chunk, auto&& replaceRange) {
         const auto& chunkVersion = chunk.getVersion();
 
         uassert(ErrorCodes::ConflictingOperationInProgress,
@@ -644,13 +886,13 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
         // for the current chunk being split, low will point to the chunk that
         // we're splitting, and high will point to the next chunk past the one
         // we're splitting (which could be chunkMap.end()). In this case,
-        // std::distance(low, high) == 1. Lastly, this does not apply during
+        // std::next(low) == high. Lastly, this does not apply during
         // the creation of the original routing table, in which case the map is
         // empty and the first chunk that is inserted will find that low ==
         // high, but low == chunkMap.end(), and we aren't doing a split in that
         // case.
         auto foundSingleChunk =
-            ((low == high || std::distance(low, high) == 1) && low != chunkMap.end());
+            (low != chunkMap.end() && (low == high || std::next(low) == high));
 
         auto newChunk = std::make_shared<ChunkInfo>(chunk);
         if (foundSingleChunk) {
@@ -660,11 +902,69 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
             newChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
         }
 
-        // Erase all chunks from the map, which overlap the chunk we got from the persistent store
-        chunkMap.erase(low, high);
+        // Replace all chunks in the map, which overlap the chunk we got from the persistent store,
+        // with only the chunk itself
+        replaceRange(low, high, std::make_pair(chunkMaxKeyString, newChunk));
+        return newChunk;
+    };
+
+    boost::optional<ChunkInfoMap> newChunkMap;
+    boost::optional<ShardVersionMap> newShardVersions;
+
+    if (applyIncrementally) {
+        ChunkInfoMap chunkMap = _chunkMap;
+        std::vector<std::shared_ptr<ChunkInfo>> removedChunks;
+        std::vector<std::shared_ptr<ChunkInfo>> addedChunks;
+
+        for (const auto& chunk : changedChunks) {
+            addedChunks.push_back(
+                applyChange(chunkMap, chunk, [&](auto low, auto high, auto entry) {
+                    for (auto it = low; it != high; ++it) {
+                        removedChunks.push_back(it->second);
+                    }
+                    chunkMap.replaceRange(low, high, std::move(entry));
+                }));
+        }
 
-        // Insert only the chunk itself
-        chunkMap.insert(std::make_pair(chunkMaxKeyString, newChunk));
+        // A chunk can be both added and removed by the same batch of changes, in which case it
+        // never affected the previous routing table or the new one.
+        stdx::unordered_set<const ChunkInfo*> addedSet, removedSet;
+        for (const auto& chunk : addedChunks) {
+            addedSet.insert(chunk.get());
+        }
+        for (const auto& chunk : removedChunks) {
+            removedSet.insert(chunk.get());
+        }
+        const auto eraseIf = [](auto& chunks, const auto& set) {
+            chunks.erase(std::remove_if(chunks.begin(),
+                                        chunks.end(),
+                                        [&](const auto& chunk) { return set.count(chunk.get()); }),
+                         chunks.end());
+        };
+        eraseIf(addedChunks, removedSet);
+        eraseIf(removedChunks, addedSet);
+
+        chunkMap.rebuildHashedIndex();
+        _checkContiguous(chunkMap, addedChunks);
+        newShardVersions = _updateShardVersionMap(removedChunks, addedChunks);
+        newChunkMap.emplace(std::move(chunkMap));
+    } else {
+        std::map<std::string, std::shared_ptr<ChunkInfo>> chunkMap(_chunkMap.begin(),
+                                                                   _chunkMap.end());
+        for (const auto& chunk : changedChunks) {
+            applyChange(chunkMap, chunk, [&](auto low, auto high, auto entry) {
+                chunkMap.erase(low, high);
+                chunkMap.insert(std::move(entry));
+            });
+        }
+
+        std::vector<ChunkInfoMap::value_type> flattenedChunks;
+        flattenedChunks.reserve(chunkMap.size());
+        while (!chunkMap.empty()) {
+            auto node = chunkMap.extract(chunkMap.begin());
+            flattenedChunks.emplace_back(std::move(node.key()), std::move(node.mapped()));
+        }
+        newChunkMap.emplace(std::move(flattenedChunks), indexHashedMaxes);
     }
 
     // If at least one diff was applied, the metadata is correct, but it might not have changed so
@@ -684,8 +984,92 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
                                 KeyPattern(getShardKeyPattern().getKeyPattern()),
                                 CollatorInterface::cloneCollator(getDefaultCollator()),
                                 isUnique(),
-                                std::move(chunkMap),
-                                collectionVersion));
+                                std::move(*newChunkMap),
+                                collectionVersion,
+                                std::move(newShardVersions)));
+}
+
+boost::optional<ShardVersionMap> RoutingTableHistory::_updateShardVersionMap(
+    const std::vector<std::shared_ptr<ChunkInfo>>& removedChunks,
+    const std::vector<std::shared_ptr<ChunkInfo>>& addedChunks) const {
+    std::map<ShardId, ChunkVersion> shardVersions;
+    for (const auto& [shardId, targetingInfo] : _shardVersions) {
+        shardVersions.emplace(shardId, targetingInfo.shardVersion);
+    }
+
+    // A shard's version is the max version of its chunks, so it can only go down if the shard
+    // loses the chunk which has that version. Migrations bump the version of a chunk left on the
+    // donor, so this normally only happens when a shard loses its last chunk.
+    std::map<ShardId, ChunkVersion> lostMaxVersions;
+    for (const auto& chunk : removedChunks) {
+        const auto& shardId = chunk->getShardIdAt(boost::none);
+        const auto it = shardVersions.find(shardId);
+        invariant(it != shardVersions.end());
+        if (chunk->getLastmod() == it->second) {
+            lostMaxVersions.emplace(shardId, it->second);
+        }
+    }
+
+    for (const auto& chunk : addedChunks) {
+        const auto& shardId = chunk->getShardIdAt(boost::none);
+        auto it = shardVersions.find(shardId);
+        if (it == shardVersions.end()) {
+            shardVersions.emplace(shardId, chunk->getLastmod());
+        } else if (chunk->getLastmod() > it->second) {
+            it->second = chunk->getLastmod();
+        }
+    }
+
+    for (const auto& [shardId, lostVersion] : lostMaxVersions) {
+        if (shardVersions[shardId] == lostVersion) {
+            return boost::none;
+        }
+    }
+
+    ShardVersionMap newShardVersions;
+    for (const auto& [shardId, shardVersion] : shardVersions) {
+        newShardVersions.emplace(shardId, shardVersion.epoch())
+            .first->second.shardVersion = shardVersion;
+    }
+    return newShardVersions;
+}
+
+void RoutingTableHistory::_checkContiguous(
+    const ChunkInfoMap& chunkMap,
+    const std::vector<std::shared_ptr<ChunkInfo>>& addedChunks) const {
+    const auto checkAdjacent = [](const ChunkInfo& left, const ChunkInfo& right) {
+        if (SimpleBSONObjComparator::kInstance.evaluate(left.getMax() == right.getMin())) {
+            return;
+        }
+
+        if (SimpleBSONObjComparator::kInstance.evaluate(left.getMax() < right.getMin()))
+            uasserted(ErrorCodes::ConflictingOperationInProgress,
+                      str::stream() << "Gap exists in the routing table between chunks "
+                                    << left.getRange().toString() << " and "
+                                    << right.getRange().toString());
+        else
+            uasserted(ErrorCodes::ConflictingOperationInProgress,
+                      str::stream() << "Overlap exists in the routing table between chunks "
+                                    << left.getRange().toString() << " and "
+                                    << right.getRange().toString());
+    };
+
+    for (const auto& chunk : addedChunks) {
+        const auto it = chunkMap.lower_bound(_extractKeyString(chunk->getMax()));
+        invariant(it != chunkMap.end() && it->second == chunk);
+
+        if (it == chunkMap.begin()) {
+            checkAllElementsAreOfType(MinKey, chunk->getMin());
+        } else {
+            checkAdjacent(*std::prev(it)->second, *chunk);
+        }
+
+        if (std::next(it) == chunkMap.end()) {
+            checkAllElementsAreOfType(MaxKey, chunk->getMax());
+        } else {
+            checkAdjacent(*chunk, *std::next(it)->second);
+        }
+    }
 }
 
 }  // namespace mongo
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <map>
 #include <set>
 #include <string>
@@ -49,8 +50,183 @@ struct QuerySolutionNode;
 class OperationContext;
 class ChunkManager;
 
-// Ordered map from the max for each chunk to an entry describing the chunk
-using ChunkInfoMap = std::map<std::string, std::shared_ptr<ChunkInfo>>;
+/**
+ * Ordered map from the max for each chunk (as a KeyString) to an entry describing the chunk.
+ *
+ * The entries are kept in sorted blocks of a few hundred chunks each, so that lookups are binary
+ * searches over mostly contiguous memory. Blocks are immutable once shared, and copies of the map
+ * share them. RoutingTableHistory::makeUpdated() can therefore copy the previous routing table and
+ * apply a handful of chunk changes at a cost proportional to the number of blocks and the size of
+ * the blocks it changes, rather than the number of chunks, while readers of the old version are
+ * unaffected.
+ */
+class ChunkInfoMap {
+public:
+    using value_type = std::pair<std::string, std::shared_ptr<ChunkInfo>>;
+
+private:
+    struct Block {
+        std::vector<value_type> chunks;
+
+        // When indexing hashed maxes, the max of each chunk as a hash value, excluding a final
+        // chunk whose max is MaxKey. Only valid if 'hasHashedMaxes' is true.
+        std::vector<long long> hashedMaxes;
+        bool hasHashedMaxes = false;
+        bool endsWithMaxKey = false;
+    };
+
+    using BlockPtr = std::shared_ptr<Block>;
+
+public:
+    /**
+     * Bidirectional iterator over the entries of a ChunkInfoMap, in key order. Invalidated by any
+     * modification of the map.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = ChunkInfoMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() = default;
+
+        reference operator*() const {
+            return _blocks[_block]->chunks[_pos];
+        }
+        pointer operator->() const {
+            return &_blocks[_block]->chunks[_pos];
+        }
+
+        const_iterator& operator++() {
+            if (++_pos == _blocks[_block]->chunks.size()) {
+                ++_block;
+                _pos = 0;
+            }
+            return *this;
+        }
+        const_iterator operator++(int) {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        const_iterator& operator--() {
+            if (_pos == 0) {
+                --_block;
+                _pos = _blocks[_block]->chunks.size();
+            }
+            --_pos;
+            return *this;
+        }
+        const_iterator operator--(int) {
+            auto result = *this;
+            --*this;
+            return result;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return _block == other._block && _pos == other._pos;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        friend class ChunkInfoMap;
+
+        const_iterator(const BlockPtr* blocks, size_t block, size_t pos)
+            : _blocks(blocks), _block(block), _pos(pos) {}
+
+        const BlockPtr* _blocks = nullptr;
+        size_t _block = 0;
+        size_t _pos = 0;
+    };
+
+    /**
+     * "indexHashedMaxes" enables findHashed(), and should be set for collections sharded on a
+     * single hashed field.
+     */
+    explicit ChunkInfoMap(bool indexHashedMaxes = false) : _indexHashedMaxes(indexHashedMaxes) {}
+
+    /**
+     * The entries in "chunks" must be sorted by key and have no duplicate keys.
+     */
+    ChunkInfoMap(std::vector<value_type> chunks, bool indexHashedMaxes);
+
+    const_iterator begin() const {
+        return {_blocks.data(), 0, 0};
+    }
+    const_iterator cbegin() const {
+        return begin();
+    }
+    const_iterator end() const {
+        return {_blocks.data(), _blocks.size(), 0};
+    }
+    const_iterator cend() const {
+        return end();
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+     * Returns the first entry whose key is not less than "key".
+     */
+    const_iterator lower_bound(StringData key) const;
+
+    /**
+     * Returns the first entry whose key is greater than "key".
+     */
+    const_iterator upper_bound(StringData key) const;
+
+    /**
+     * Returns the chunk whose key is exactly "key", which must exist.
+     */
+    const std::shared_ptr<ChunkInfo>& at(StringData key) const;
+
+    /**
+     * Returns the first entry whose max is greater than the hashed shard key value "value", which
+     * is the chunk containing it. This is equivalent to upper_bound() on the KeyString of the
+     * value, but uses a direct lookup table from the high bits of the value to the block which
+     * contains it and then compares plain integers. Returns boost::none if the index is not in
+     * use, either because it was not requested or because some chunk max is not a NumberLong.
+     */
+    boost::optional<const_iterator> findHashed(long long value) const;
+
+    /**
+     * Erases the entries in [first, last) and inserts "entry" in their place. The key of "entry"
+     * must sort between the entries on either side of the erased range. Blocks shared with copies
+     * of this map are copied rather than modified. Invalidates all iterators, and disables
+     * findHashed() until the next call to rebuildHashedIndex().
+     */
+    void replaceRange(const_iterator first, const_iterator last, value_type entry);
+
+    /**
+     * Rebuilds the lookup table used by findHashed() after the map has been modified. Its cost is
+     * proportional to the number of blocks rather than the number of chunks.
+     */
+    void rebuildHashedIndex();
+
+private:
+    BlockPtr _makeBlock(std::vector<value_type> chunks) const;
+
+    std::vector<BlockPtr> _blocks;
+    size_t _size = 0;
+
+    bool _indexHashedMaxes;
+
+    // For each bucket of hash values, the index of the first block which can contain a value from
+    // that bucket. Empty if findHashed() is disabled.
+    std::vector<uint32_t> _hashedBucketStarts;
+    int _hashedBucketShift = 0;
+};
 
 struct ShardVersionTargetingInfo {
     // Indicates whether the shard is stale and thus needs a catalog cache refresh. Is false by
@@ -197,7 +373,8 @@ private:
                         std::unique_ptr<CollatorInterface> defaultCollator,
                         bool unique,
                         ChunkInfoMap chunkMap,
-                        ChunkVersion collectionVersion);
+                        ChunkVersion collectionVersion,
+                        boost::optional<ShardVersionMap> shardVersions = boost::none);
 
     /**
      * Does a single pass over the chunkMap and constructs the ShardVersionMap object.
@@ -208,6 +385,29 @@ private:
 
     std::string _extractKeyString(const BSONObj& shardKeyValue) const;
 
+    /**
+     * Returns the entry of the chunk which contains "shardKey", or _chunkMap.end() if the key is
+     * past the last chunk. Equivalent to _chunkMap.upper_bound(_extractKeyString(shardKey)).
+     */
+    ChunkInfoMap::const_iterator _findIntersectingChunk(const BSONObj& shardKey) const;
+
+    /**
+     * Returns the shard versions of this routing table after "removedChunks" were replaced by
+     * "addedChunks", without looking at any other chunks. Returns boost::none if a shard lost the
+     * chunk which determined its version, in which case it has to be recomputed from all chunks.
+     */
+    boost::optional<ShardVersionMap> _updateShardVersionMap(
+        const std::vector<std::shared_ptr<ChunkInfo>>& removedChunks,
+        const std::vector<std::shared_ptr<ChunkInfo>>& addedChunks) const;
+
+    /**
+     * Checks that each of "addedChunks" is adjacent to its neighbours in "chunkMap". Together with
+     * the checks made when the previous routing table was built, this ensures that the chunks
+     * still cover the whole shard key space without gaps or overlaps.
+     */
+    void _checkContiguous(const ChunkInfoMap& chunkMap,
+                          const std::vector<std::shared_ptr<ChunkInfo>>& addedChunks) const;
+
     // The shard versioning mechanism hinges on keeping track of the number of times we reload
     // ChunkManagers.
     const unsigned long long _sequenceNumber;
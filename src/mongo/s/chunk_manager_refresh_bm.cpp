@@ -54,6 +54,25 @@ ChunkRange getRangeForChunk(int i, int nChunks) {
     return {BSON("_id" << (i - 1) * 100), BSON("_id" << i * 100)};
 }
 
+// Splits the hashed key space evenly, the way chunks are created for a hashed shard key
+ChunkRange getHashedRangeForChunk(int i, int nChunks) {
+    invariant(i >= 0);
+    invariant(nChunks > 1);
+    invariant(i < nChunks);
+    const uint64_t step = std::numeric_limits<uint64_t>::max() / nChunks;
+    const auto bound = [&](int j) {
+        return BSON("_id" << static_cast<long long>(
+                        static_cast<uint64_t>(std::numeric_limits<long long>::min()) + j * step));
+    };
+    if (i == 0) {
+        return {BSON("_id" << MINKEY), bound(1)};
+    }
+    if (i + 1 == nChunks) {
+        return {bound(i), BSON("_id" << MAXKEY)};
+    }
+    return {bound(i), bound(i + 1)};
+}
+
 template <typename ShardSelectorFn>
 auto makeChunkManagerWithShardSelector(int nShards, uint32_t nChunks, ShardSelectorFn selectShard) {
     const auto collEpoch = OID::gen();
@@ -95,6 +114,27 @@ MONGO_COMPILER_NOINLINE auto makeChunkManagerWithOptimalBalancedDistribution(int
     return makeChunkManagerWithShardSelector(nShards, nChunks, optimalShardSelector);
 }
 
+MONGO_COMPILER_NOINLINE auto makeChunkManagerWithHashedShardKey(int nShards, uint32_t nChunks) {
+    const auto collEpoch = OID::gen();
+    const auto collName = NamespaceString("test.foo");
+    const auto shardKeyPattern = KeyPattern(BSON("_id"
+                                                 << "hashed"));
+
+    std::vector<ChunkType> chunks;
+    chunks.reserve(nChunks);
+    for (uint32_t i = 0; i < nChunks; ++i) {
+        chunks.emplace_back(collName,
+                            getHashedRangeForChunk(i, nChunks),
+                            ChunkVersion{i + 1, 0, collEpoch},
+                            optimalShardSelector(i, nShards, nChunks));
+    }
+
+    auto routingTableHistory = RoutingTableHistory::makeNew(
+        collName, UUID::gen(), shardKeyPattern, nullptr, true, collEpoch, chunks);
+    auto chunkManager = std::make_shared<ChunkManager>(routingTableHistory, boost::none);
+    return std::make_unique<CollectionMetadata>(std::move(chunkManager), ShardId("shard0"));
+}
+
 MONGO_COMPILER_NOINLINE auto runIncrementalUpdate(const CollectionMetadata& cm,
                                                   const std::vector<ChunkType>& newChunks) {
     auto rt = cm.getChunkManager()->getRoutingHistory()->makeUpdated(newChunks);
@@ -204,6 +244,20 @@ std::vector<BSONObj> makeKeys(int nChunks) {
     return keys;
 }
 
+std::vector<BSONObj> makeHashedKeys() {
+    constexpr int nFinds = 200000;
+
+    PseudoRandom rand(12345);
+    std::vector<BSONObj> keys;
+    keys.reserve(nFinds);
+
+    for (int i = 0; i < nFinds; ++i) {
+        keys.emplace_back(BSON("_id" << rand.nextInt64()));
+    }
+
+    return keys;
+}
+
 std::vector<std::pair<BSONObj, BSONObj>> makeRanges(const std::vector<BSONObj>& keys) {
     std::vector<std::pair<BSONObj, BSONObj>> ranges;
     ranges.reserve(keys.size() / 2);
@@ -286,6 +340,29 @@ void BM_FindIntersectingChunk(benchmark::State& state,
     state.SetItemsProcessed(state.iterations());
 }
 
+void BM_FindIntersectingChunkHashed(benchmark::State& state) {
+    const int nShards = state.range(0);
+    const int nChunks = state.range(1);
+
+    auto cm = makeChunkManagerWithHashedShardKey(nShards, nChunks);
+    auto keys = makeHashedKeys();
+    auto keysIter = makeCircularIterator(keys);
+
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(
+            cm->getChunkManager()->findIntersectingChunkWithSimpleCollation(*keysIter));
+        ++keysIter;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_FindIntersectingChunkHashed)
+    ->Args({2, 2})
+    ->Args({10, 50000})
+    ->Args({100, 500000})
+    ->Args({1000, 500000});
+
 template <typename CollectionMetadataBuilderFn>
 void BM_GetShardIdsForRange(benchmark::State& state,
                             CollectionMetadataBuilderFn makeCollectionMetadata) {
@@ -83,6 +83,17 @@ int compareSortKeys(BSONObj leftSortKey, BSONObj rightSortKey, BSONObj sortKeyPa
     return leftSortKey.woCompare(rightSortKey, sortKeyPattern, rules);
 }
 
+/**
+ * Returns the ordering with which sort keys are encoded as KeyStrings for the merge, or boost::none
+ * if there is no sort or the sort pattern has more fields than an Ordering can describe.
+ */
+boost::optional<Ordering> makeSortKeyOrdering(const boost::optional<BSONObj>& sort) {
+    if (!sort || sort->nFields() > static_cast<int>(Ordering::kMaxCompoundIndexKeys)) {
+        return boost::none;
+    }
+    return Ordering::make(*sort);
+}
+
 }  // namespace
 
 AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
@@ -95,6 +106,7 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       // since that is not supported we treat boost::none (unspecified) to mean 'kNormal'.
       _tailableMode(params.getTailableMode().value_or(TailableModeEnum::kNormal)),
       _params(std::move(params)),
+      _sortKeyOrdering(makeSortKeyOrdering(_params.getSort())),
       _mergeQueue(MergingComparator(
           _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey())),
       _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))) {
@@ -302,7 +314,7 @@ bool AsyncResultsMerger::_readySortedTailable(WithLock lk) {
     }
 
     auto smallestRemote = _mergeQueue.top();
-    auto smallestResult = _remotes[smallestRemote].docBuffer.front();
+    const auto& smallestResult = _remotes[smallestRemote].docBuffer.front();
     auto keyWeWantToReturn =
         extractSortKey(*smallestResult.getResult(), _params.getCompareWholeSortKey());
     // We should always have a minPromisedSortKey from every shard in the sorted tailable case.
@@ -354,20 +366,21 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     }
 
     size_t smallestRemote = _mergeQueue.top();
-    _mergeQueue.pop();
 
     invariant(!_remotes[smallestRemote].docBuffer.empty());
     invariant(_remotes[smallestRemote].status.isOK());
 
-    ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
+    ClusterQueryResult front = std::move(_remotes[smallestRemote].docBuffer.front());
     _remotes[smallestRemote].docBuffer.pop();
-
-    // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
-    // next result.
-    if (!_remotes[smallestRemote].docBuffer.empty()) {
-        _mergeQueue.push(smallestRemote);
+    if (_sortKeyOrdering) {
+        _remotes[smallestRemote].sortKeyBuffer.pop();
     }
 
+    // Let the merge tree compare the next result from 'smallestRemote', if it has one, against the
+    // other remotes. This only takes a single comparison while 'smallestRemote' keeps returning the
+    // smallest result.
+    _mergeQueue.update(smallestRemote);
+
     // For sorted tailable awaitData cursors, update the high water mark to the document's sort key.
     if (_tailableMode == TailableModeEnum::kTailableAndAwaitData) {
         if (_remotes[smallestRemote].eligibleForHighWaterMark) {
@@ -698,8 +711,13 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
         remote.partialResultsReturned = (remote.status != ErrorCodes::ExchangePassthrough);
         std::queue<ClusterQueryResult> emptyBuffer;
         std::swap(remote.docBuffer, emptyBuffer);
+        std::queue<KeyString::Value> emptySortKeyBuffer;
+        std::swap(remote.sortKeyBuffer, emptySortKeyBuffer);
         remote.status = Status::OK();
         remote.cursorId = 0;
+        if (_params.getSort()) {
+            _mergeQueue.update(remoteIndex);
+        }
     }
 }
 
@@ -772,15 +790,23 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
             }
         }
 
+        if (_sortKeyOrdering) {
+            remote.sortKeyBuffer.push(
+                KeyString::Builder(KeyString::Version::kLatestVersion,
+                                   extractSortKey(obj, _params.getCompareWholeSortKey()),
+                                   *_sortKeyOrdering)
+                    .getValueCopy());
+        }
+
         ClusterQueryResult result(obj);
         remote.docBuffer.push(result);
         ++remote.fetchedCount;
     }
 
-    // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
-    // queue.
+    // If we're doing a sorted merge, then we have to make sure the merge tree accounts for the
+    // results of this remote.
     if (_params.getSort() && !response.getBatch().empty()) {
-        _mergeQueue.push(remoteIndex);
+        _mergeQueue.update(remoteIndex);
     }
     return true;
 }
@@ -896,13 +922,20 @@ bool AsyncResultsMerger::RemoteCursorData::exhausted() const {
 // AsyncResultsMerger::MergingComparator
 //
 
-bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
-    const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
-    const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
+int AsyncResultsMerger::MergingComparator::compare(size_t lhs, size_t rhs) const {
+    const auto& leftRemote = _remotes[lhs];
+    const auto& rightRemote = _remotes[rhs];
+
+    // The KeyStrings already account for the direction of each field in the sort pattern.
+    if (!leftRemote.sortKeyBuffer.empty()) {
+        return leftRemote.sortKeyBuffer.front().compare(rightRemote.sortKeyBuffer.front());
+    }
 
+    const ClusterQueryResult& leftDoc = leftRemote.docBuffer.front();
+    const ClusterQueryResult& rightDoc = rightRemote.docBuffer.front();
     return compareSortKeys(extractSortKey(*leftDoc.getResult(), _compareWholeSortKey),
                            extractSortKey(*rightDoc.getResult(), _compareWholeSortKey),
-                           _sort) > 0;
+                           _sort);
 }
 
 bool AsyncResultsMerger::PromisedMinSortKeyComparator::operator()(
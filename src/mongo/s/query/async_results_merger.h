@@ -36,10 +36,12 @@
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/cursor_id.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/s/query/async_results_merger_params_gen.h"
 #include "mongo/s/query/cluster_query_result.h"
+#include "mongo/s/query/loser_tree.h"
 #include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/net/hostandport.h"
 #include "mongo/util/time_support.h"
@@ -308,6 +310,11 @@ private:
         // The buffer of results that have been retrieved but not yet returned to the caller.
         std::queue<ClusterQueryResult> docBuffer;
 
+        // For sorted merges, the sort key of each result in 'docBuffer' encoded as a KeyString, so
+        // that merging compares flat byte strings rather than walking the BSON of both sort keys.
+        // Empty if the sort pattern has too many fields to be encoded with a KeyString Ordering.
+        std::queue<KeyString::Value> sortKeyBuffer;
+
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -320,6 +327,9 @@ private:
         long long fetchedCount = 0;
     };
 
+    /**
+     * Exposes the front of each remote's buffer to the LoserTree which merges them.
+     */
     class MergingComparator {
     public:
         MergingComparator(const std::vector<RemoteCursorData>& remotes,
@@ -327,7 +337,15 @@ private:
                           bool compareWholeSortKey)
             : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {}
 
-        bool operator()(const size_t& lhs, const size_t& rhs);
+        size_t size() const {
+            return _remotes.size();
+        }
+
+        bool hasNext(size_t remoteIndex) const {
+            return _remotes[remoteIndex].hasNext();
+        }
+
+        int compare(size_t lhs, size_t rhs) const;
 
     private:
         const std::vector<RemoteCursorData>& _remotes;
@@ -486,9 +504,14 @@ private:
     // Data tracking the state of our communication with each of the remote nodes.
     std::vector<RemoteCursorData> _remotes;
 
-    // The top of this priority queue is the index into '_remotes' for the remote host that has the
-    // next document to return, according to the sort order. Used only if there is a sort.
-    std::priority_queue<size_t, std::vector<size_t>, MergingComparator> _mergeQueue;
+    // The ordering used to encode the sort keys of buffered results as KeyStrings. Not set if
+    // there is no sort, or if the sort pattern has too many fields, in which case the merge
+    // compares the BSON sort keys.
+    boost::optional<Ordering> _sortKeyOrdering;
+
+    // The top of this tree is the index into '_remotes' for the remote host that has the next
+    // document to return, according to the sort order. Used only if there is a sort.
+    LoserTree<MergingComparator> _mergeQueue;
 
     // The index into '_remotes' for the remote from which we are currently retrieving results.
     // Used only if there is *not* a sort.
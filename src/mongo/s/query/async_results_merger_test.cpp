@@ -444,6 +444,36 @@ TEST_F(AsyncResultsMergerTest, CompoundSortKey) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, SortedMergeComparesNumericSortKeysByValue) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: 1}}");
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> batch1 = {BSON("$sortKey" << BSON("" << 1)),
+                                   BSON("$sortKey" << BSON("" << 2.5)),
+                                   BSON("$sortKey" << BSON("" << 10LL))};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, CursorId(0), batch1)));
+    std::vector<BSONObj> batch2 = {BSON("$sortKey" << BSON("" << -1LL)),
+                                   BSON("$sortKey" << BSON("" << 2.0)),
+                                   BSON("$sortKey" << BSON("" << 9))};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, CursorId(0), batch2)));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // The sort keys of the different numeric types are merged by their value.
+    for (auto&& expected : {BSON("$sortKey" << BSON("" << -1LL)),
+                            BSON("$sortKey" << BSON("" << 1)),
+                            BSON("$sortKey" << BSON("" << 2.0)),
+                            BSON("$sortKey" << BSON("" << 2.5)),
+                            BSON("$sortKey" << BSON("" << 9)),
+                            BSON("$sortKey" << BSON("" << 10LL))}) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(expected, *unittest::assertGet(arm->nextReady()).getResult());
+    }
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, SortedButNoSortKey) {
     BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1, b: 1}}");
     std::vector<RemoteCursor> cursors;
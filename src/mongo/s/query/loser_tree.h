@@ -0,0 +1,189 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+/**
+ * A tournament tree of losers used to merge a number of sorted streams, identified by their index.
+ *
+ * Each internal node of the tree stores the stream which lost the match played at that node, and
+ * the root stores the overall winner, so when the current item of the winning stream changes only
+ * the matches along its path to the root need to be replayed. This takes one comparison per level
+ * of the tree, where sifting down a binary heap takes two.
+ *
+ * When the winning stream keeps winning, which is the case when the streams contain runs of
+ * consecutive items, the tree remembers the best stream among the losers along the winner's path
+ * and checks the next item against that stream alone.
+ *
+ * 'Streams' must provide:
+ *     size_t size() const; -- the number of streams
+ *     bool hasNext(size_t stream) const; -- whether the stream has a current item
+ *     int compare(size_t lhs, size_t rhs) const; -- three-way comparison of the current items
+ *
+ * Streams without a current item lose against all others. Ties are broken by the stream index, so
+ * the merge is stable with respect to the order of the streams.
+ */
+template <typename Streams>
+class LoserTree {
+public:
+    explicit LoserTree(Streams streams) : _streams(std::move(streams)) {}
+
+    /**
+     * Returns true if no stream has a current item.
+     */
+    bool empty() {
+        _rebuildIfNeeded();
+        return _nodes.empty() || !_streams.hasNext(_nodes[0]);
+    }
+
+    /**
+     * Returns the index of the stream with the smallest current item. Illegal to call if empty().
+     */
+    size_t top() {
+        invariant(!empty());
+        return _nodes[0];
+    }
+
+    /**
+     * Must be called whenever the current item of 'stream' changes, including when the stream runs
+     * out of items or receives new ones, and when streams are added.
+     *
+     * Advancing the winning stream costs at most log(n) comparisons. Any other change makes the
+     * next call to empty() or top() rebuild the tree with n comparisons, which only happens after
+     * streams receive new batches of items.
+     */
+    void update(size_t stream) {
+        if (_needsRebuild || _nodes.size() != _streams.size() || _nodes.empty() ||
+            stream != _nodes[0]) {
+            _needsRebuild = true;
+            return;
+        }
+
+        if (_runnerUp != kNone && _beats(stream, _runnerUp)) {
+            return;
+        }
+
+        _replay(stream);
+        _runnerUp = kNone;
+        if (_nodes[0] == stream) {
+            _runnerUp = _findRunnerUp();
+        }
+    }
+
+private:
+    static constexpr size_t kNone = std::numeric_limits<size_t>::max();
+
+    bool _beats(size_t lhs, size_t rhs) const {
+        if (!_streams.hasNext(lhs)) {
+            return false;
+        }
+        if (!_streams.hasNext(rhs)) {
+            return true;
+        }
+        const int cmp = _streams.compare(lhs, rhs);
+        return cmp < 0 || (cmp == 0 && lhs < rhs);
+    }
+
+    /**
+     * The leaf of stream 'i' is at position 'i + n' of an implicit binary tree whose internal nodes
+     * are at positions [1, n), which works for any number of streams.
+     */
+    void _rebuildIfNeeded() {
+        if (!_needsRebuild && _nodes.size() == _streams.size()) {
+            return;
+        }
+        _needsRebuild = false;
+
+        const size_t n = _streams.size();
+        _nodes.assign(n, kNone);
+        _runnerUp = kNone;
+        if (n == 0) {
+            return;
+        }
+
+        _winners.assign(n, kNone);
+        const auto winnerAt = [&](size_t pos) { return pos >= n ? pos - n : _winners[pos]; };
+        for (size_t pos = n - 1; pos > 0; --pos) {
+            auto left = winnerAt(2 * pos);
+            auto right = winnerAt(2 * pos + 1);
+            if (!_beats(left, right)) {
+                std::swap(left, right);
+            }
+            _winners[pos] = left;
+            _nodes[pos] = right;
+        }
+        _nodes[0] = n == 1 ? 0 : _winners[1];
+    }
+
+    void _replay(size_t stream) {
+        auto winner = stream;
+        for (size_t pos = (stream + _nodes.size()) / 2; pos > 0; pos /= 2) {
+            if (_beats(_nodes[pos], winner)) {
+                std::swap(_nodes[pos], winner);
+            }
+        }
+        _nodes[0] = winner;
+    }
+
+    size_t _findRunnerUp() const {
+        auto runnerUp = kNone;
+        for (size_t pos = (_nodes[0] + _nodes.size()) / 2; pos > 0; pos /= 2) {
+            if (runnerUp == kNone || _beats(_nodes[pos], runnerUp)) {
+                runnerUp = _nodes[pos];
+            }
+        }
+        return runnerUp;
+    }
+
+    Streams _streams;
+
+    // Position 0 holds the overall winner and positions [1, n) the loser of each match.
+    std::vector<size_t> _nodes;
+
+    // Scratch space for the winners of each match while rebuilding.
+    std::vector<size_t> _winners;
+
+    // Set when a change other than advancing the winner has not been applied to the tree yet.
+    bool _needsRebuild = false;
+
+    // The best of the losers along the winner's path, or kNone if it has not been computed since
+    // the tree last changed.
+    size_t _runnerUp = kNone;
+};
+
+}  // namespace mongo
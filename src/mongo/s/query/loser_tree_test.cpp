@@ -0,0 +1,194 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/loser_tree.h"
+
+#include <algorithm>
+#include <deque>
+
+#include "mongo/platform/random.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Stream = std::deque<std::pair<int, int>>;
+
+/**
+ * Streams of (key, payload) pairs which are ordered by key only.
+ */
+class TestStreams {
+public:
+    explicit TestStreams(const std::vector<Stream>& streams) : _streams(streams) {}
+
+    size_t size() const {
+        return _streams.size();
+    }
+
+    bool hasNext(size_t stream) const {
+        return !_streams[stream].empty();
+    }
+
+    int compare(size_t lhs, size_t rhs) const {
+        const auto left = _streams[lhs].front().first;
+        const auto right = _streams[rhs].front().first;
+        return left < right ? -1 : (left > right ? 1 : 0);
+    }
+
+private:
+    const std::vector<Stream>& _streams;
+};
+
+/**
+ * Merges 'streams' and returns the (key, stream) pairs in the order they were produced.
+ */
+std::vector<std::pair<int, size_t>> merge(std::vector<Stream>& streams) {
+    LoserTree<TestStreams> tree{TestStreams(streams)};
+    for (size_t i = 0; i < streams.size(); ++i) {
+        tree.update(i);
+    }
+
+    std::vector<std::pair<int, size_t>> merged;
+    while (!tree.empty()) {
+        const auto stream = tree.top();
+        merged.emplace_back(streams[stream].front().first, stream);
+        streams[stream].pop_front();
+        tree.update(stream);
+    }
+    return merged;
+}
+
+void assertMergedInOrder(const std::vector<std::pair<int, size_t>>& merged, size_t expectedSize) {
+    ASSERT_EQ(merged.size(), expectedSize);
+    ASSERT(std::is_sorted(merged.begin(), merged.end()));
+}
+
+TEST(LoserTreeTest, Empty) {
+    std::vector<Stream> streams;
+    ASSERT(merge(streams).empty());
+
+    streams.resize(3);
+    ASSERT(merge(streams).empty());
+}
+
+TEST(LoserTreeTest, SingleStream) {
+    std::vector<Stream> streams{{{1, 0}, {2, 0}, {3, 0}}};
+    assertMergedInOrder(merge(streams), 3);
+}
+
+TEST(LoserTreeTest, TiesAreBrokenByStreamIndex) {
+    std::vector<Stream> streams(5, Stream{{1, 0}, {1, 0}, {2, 0}});
+    const auto merged = merge(streams);
+    assertMergedInOrder(merged, 15);
+    ASSERT_EQ(merged.front().second, 0U);
+    ASSERT_EQ(merged.back().second, 4U);
+}
+
+TEST(LoserTreeTest, RandomStreams) {
+    PseudoRandom random(1234);
+    for (size_t numStreams = 1; numStreams <= 70; ++numStreams) {
+        std::vector<Stream> streams(numStreams);
+        size_t total = 0;
+        for (auto& stream : streams) {
+            int key = random.nextInt32(100);
+            const auto length = random.nextInt32(50);
+            for (int i = 0; i < length; ++i) {
+                stream.emplace_back(key, 0);
+                key += random.nextInt32(10);
+            }
+            total += length;
+        }
+        assertMergedInOrder(merge(streams), total);
+    }
+}
+
+TEST(LoserTreeTest, Runs) {
+    // Each stream holds a contiguous range of keys, so the winner only changes between ranges
+    std::vector<Stream> streams(17);
+    for (int i = 0; i < 17 * 100; ++i) {
+        streams[(i / 100 * 7) % 17].emplace_back(i, 0);
+    }
+    assertMergedInOrder(merge(streams), 17 * 100);
+}
+
+TEST(LoserTreeTest, StreamsReceiveNewItems) {
+    // Streams run out of items and are refilled while merging, the way remotes receive batches
+    std::vector<Stream> streams(9);
+    LoserTree<TestStreams> tree{TestStreams(streams)};
+
+    PseudoRandom random(4321);
+    std::vector<int> nextKey(streams.size(), 0);
+    const auto refill = [&](size_t stream) {
+        for (int i = 0; i < 3; ++i) {
+            nextKey[stream] += random.nextInt32(20);
+            streams[stream].emplace_back(nextKey[stream], 0);
+        }
+        tree.update(stream);
+    };
+    for (size_t i = 0; i < streams.size(); ++i) {
+        refill(i);
+    }
+
+    int lastKey = -1;
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_FALSE(tree.empty());
+        const auto stream = tree.top();
+        const auto key = streams[stream].front().first;
+        ASSERT_GTE(key, lastKey);
+        lastKey = key;
+
+        streams[stream].pop_front();
+        tree.update(stream);
+        if (streams[stream].empty()) {
+            // A sorted merge waits for the remote's next batch, which sorts after its last result
+            refill(stream);
+        }
+    }
+}
+
+TEST(LoserTreeTest, StreamsAreAdded) {
+    std::vector<Stream> streams{{{5, 0}, {10, 0}}};
+    LoserTree<TestStreams> tree{TestStreams(streams)};
+    tree.update(0);
+    ASSERT_EQ(tree.top(), 0U);
+
+    streams.push_back({{1, 0}});
+    tree.update(1);
+    ASSERT_EQ(tree.top(), 1U);
+
+    streams[1].pop_front();
+    tree.update(1);
+    ASSERT_EQ(tree.top(), 0U);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/s/query/async_results_merger.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+
+/**
+ * Builds the parameters of a sorted merge of 'numRemotes' exhausted cursors, each of which has
+ * returned 'docsPerRemote' results with a compound sort key {a: 1, b: -1}. When 'runLength' is 1
+ * the sort keys of consecutive results come from different remotes, and larger values give each
+ * remote runs of consecutive results.
+ */
+AsyncResultsMergerParams makeSortedMergeParams(int numRemotes, int docsPerRemote, int runLength) {
+    std::vector<std::vector<BSONObj>> batches(numRemotes);
+    for (int i = 0; i < numRemotes * docsPerRemote; ++i) {
+        const auto sortKey = BSON_ARRAY(i << "shard key value");
+        batches[(i / runLength) % numRemotes].push_back(
+            BSON("_id" << i << "a" << i << "b"
+                       << "shard key value"
+                       << "$sortKey" << sortKey));
+    }
+
+    std::vector<RemoteCursor> remotes;
+    for (int i = 0; i < numRemotes; ++i) {
+        RemoteCursor remote;
+        remote.setShardId(str::stream() << "shard" << i);
+        remote.setHostAndPort(HostAndPort("localhost", 20000 + i));
+        remote.setCursorResponse(CursorResponse(kNss, CursorId(0), std::move(batches[i])));
+        remotes.push_back(std::move(remote));
+    }
+
+    AsyncResultsMergerParams params;
+    params.setNss(kNss);
+    params.setSort(BSON("a" << 1 << "b" << -1));
+    params.setRemotes(std::move(remotes));
+    return params;
+}
+
+/**
+ * Merges results which have already been received from every remote, so that only the work done
+ * by the router to buffer and order them is measured.
+ */
+void BM_SortedMerge(benchmark::State& state, int runLength) {
+    const int numRemotes = state.range(0);
+    const int docsPerRemote = state.range(1);
+
+    for (auto _ : state) {
+        // The cursor responses cannot be copied, so the parameters are rebuilt for each merge
+        state.PauseTiming();
+        auto params = makeSortedMergeParams(numRemotes, docsPerRemote, runLength);
+        state.ResumeTiming();
+
+        AsyncResultsMerger arm(nullptr, nullptr, std::move(params));
+        while (true) {
+            invariant(arm.ready());
+            auto next = uassertStatusOK(arm.nextReady());
+            if (next.isEOF()) {
+                break;
+            }
+            benchmark::DoNotOptimize(next);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numRemotes * docsPerRemote);
+}
+
+BENCHMARK_CAPTURE(BM_SortedMerge, Interleaved, 1)
+    ->Args({2, 1000})
+    ->Args({10, 1000})
+    ->Args({60, 1000})
+    ->Args({250, 100});
+BENCHMARK_CAPTURE(BM_SortedMerge, Runs, 100)
+    ->Args({2, 1000})
+    ->Args({10, 1000})
+    ->Args({60, 1000})
+    ->Args({250, 100});
+
+}  // namespace
+}  // namespace mongo
@@ -37,6 +37,7 @@
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/service_context.h"
+#include "mongo/platform/random.h"
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/chunk_writes_tracker.h"
 #include "mongo/s/shard_server_test_fixture.h"
@@ -50,6 +51,7 @@ namespace mongo {
 namespace {
 
 const ShardId kThisShard("thisShard");
+const ShardId kOtherShard("otherShard");
 const NamespaceString kNss("TestDB", "TestColl");
 
 /**
@@ -318,5 +320,399 @@ TEST_F(RoutingTableHistoryTestThreeInitialChunks,
                               expectedBytesInChunksNotSplit);
 }
 
+/**
+ * Builds a routing table for a collection sharded on "shardKeyPattern" whose chunks are all on this
+ * shard and are split at the given points, which must be sorted.
+ */
+std::shared_ptr<RoutingTableHistory> makeRoutingTable(const KeyPattern& shardKeyPattern,
+                                                      const std::vector<BSONObj>& splitPoints) {
+    const OID epoch = OID::gen();
+
+    std::vector<BSONObj> bounds{shardKeyPattern.globalMin()};
+    bounds.insert(bounds.end(), splitPoints.begin(), splitPoints.end());
+    bounds.push_back(shardKeyPattern.globalMax());
+
+    ChunkVersion version{1, 0, epoch};
+    std::vector<ChunkType> chunks;
+    for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+        chunks.emplace_back(kNss, ChunkRange{bounds[i], bounds[i + 1]}, version, kThisShard);
+        version.incMinor();
+    }
+
+    return RoutingTableHistory::makeNew(
+        kNss, UUID::gen(), shardKeyPattern, nullptr, false, epoch, chunks);
+}
+
+/**
+ * Builds a routing table for a collection sharded on {a: "hashed"} whose chunks are split at the
+ * given hash values, which must be sorted.
+ */
+std::shared_ptr<RoutingTableHistory> makeHashedRoutingTable(
+    const std::vector<BSONObj>& splitPoints) {
+    return makeRoutingTable(KeyPattern(BSON("a"
+                                            << "hashed")),
+                            splitPoints);
+}
+
+void assertFindsChunkContaining(const ChunkManager& cm, long long hash) {
+    const auto key = BSON("a" << hash);
+    const auto chunk = cm.findIntersectingChunkWithSimpleCollation(key);
+    ASSERT(chunk.containsKey(key));
+}
+
+TEST(RoutingTableHistoryHashedShardKey, FindIntersectingChunkUsesHashedIndex) {
+    std::vector<BSONObj> splitPoints;
+    std::vector<long long> hashes;
+
+    // Evenly spread chunks, as created for a hashed collection, plus a cluster of small chunks
+    // which land in a single bucket of the lookup table.
+    const long long kStep = std::numeric_limits<long long>::max() / 500;
+    for (long long i = -500; i < 500; ++i) {
+        hashes.push_back(i * kStep);
+    }
+    for (long long i = 1; i <= 50; ++i) {
+        hashes.push_back(7 * kStep + i);
+    }
+    std::sort(hashes.begin(), hashes.end());
+    for (auto hash : hashes) {
+        splitPoints.push_back(BSON("a" << hash));
+    }
+
+    ChunkManager cm(makeHashedRoutingTable(splitPoints), boost::none);
+    ASSERT_EQ(cm.numChunks(), static_cast<int>(hashes.size()) + 1);
+
+    for (auto hash : hashes) {
+        assertFindsChunkContaining(cm, hash - 1);
+        assertFindsChunkContaining(cm, hash);
+        assertFindsChunkContaining(cm, hash + 1);
+        ASSERT_BSONOBJ_EQ(
+            cm.findIntersectingChunkWithSimpleCollation(BSON("a" << hash)).getMin(),
+            BSON("a" << hash));
+    }
+    assertFindsChunkContaining(cm, std::numeric_limits<long long>::min());
+    assertFindsChunkContaining(cm, std::numeric_limits<long long>::max());
+
+    PseudoRandom random(12345);
+    for (int i = 0; i < 10000; ++i) {
+        assertFindsChunkContaining(cm, random.nextInt64());
+    }
+}
+
+TEST(RoutingTableHistoryHashedShardKey, FindIntersectingChunkWithNonHashSplitPoint) {
+    // A split point which is not a NumberLong disables the lookup table
+    ChunkManager cm(
+        makeHashedRoutingTable({BSON("a" << -10LL), BSON("a" << 0.5), BSON("a" << 10LL)}),
+        boost::none);
+
+    ASSERT_BSONOBJ_EQ(cm.findIntersectingChunkWithSimpleCollation(BSON("a" << 0LL)).getMin(),
+                      BSON("a" << -10LL));
+    ASSERT_BSONOBJ_EQ(cm.findIntersectingChunkWithSimpleCollation(BSON("a" << 1LL)).getMin(),
+                      BSON("a" << 0.5));
+    assertFindsChunkContaining(cm, std::numeric_limits<long long>::min());
+    assertFindsChunkContaining(cm, std::numeric_limits<long long>::max());
+}
+
+TEST(RoutingTableHistoryHashedShardKey, IncrementalRefreshLeavesPreviousTableUnchanged) {
+    std::vector<BSONObj> splitPoints;
+    for (long long i = -1000; i < 1000; ++i) {
+        splitPoints.push_back(BSON("a" << i * 1000));
+    }
+    auto rt = makeHashedRoutingTable(splitPoints);
+    const auto startingVersion = rt->getVersion();
+
+    // Migrate the chunk containing 0 to another shard, bumping the version of a chunk which stays
+    // behind on the donor, the same way a migration commit does.
+    const auto movedRange = ChunkManager(rt, boost::none)
+                                .findIntersectingChunkWithSimpleCollation(BSON("a" << 0LL))
+                                .getRange();
+    const auto controlRange = ChunkManager(rt, boost::none)
+                                  .findIntersectingChunkWithSimpleCollation(BSON("a" << 500500LL))
+                                  .getRange();
+
+    auto version = startingVersion;
+    version.incMajor();
+    std::vector<ChunkType> changedChunks;
+    changedChunks.emplace_back(kNss, movedRange, version, kOtherShard);
+    version.incMinor();
+    changedChunks.emplace_back(kNss, controlRange, version, kThisShard);
+
+    auto newRt = rt->makeUpdated(changedChunks);
+    ASSERT_NE(rt, newRt);
+    ASSERT_EQ(newRt->getChunkMap().size(), rt->getChunkMap().size());
+    ASSERT_EQ(newRt->getVersion(), version);
+    ASSERT_EQ(newRt->getVersion(kThisShard), version);
+    ASSERT_EQ(newRt->getVersion(kOtherShard), changedChunks.front().getVersion());
+
+    ASSERT_EQ(rt->getVersion(), startingVersion);
+    ASSERT_EQ(rt->getVersion(kThisShard), startingVersion);
+    ASSERT_EQ(
+        getChunkToSplit(rt, movedRange.getMin(), movedRange.getMax())->getShardIdAt(boost::none),
+        kThisShard);
+    ASSERT_EQ(
+        getChunkToSplit(newRt, movedRange.getMin(), movedRange.getMax())->getShardIdAt(boost::none),
+        kOtherShard);
+
+    // Chunks which were not touched by the refresh are shared between both routing tables
+    const auto untouchedMin = BSON("a" << -500000LL);
+    const auto untouchedMax = BSON("a" << -499000LL);
+    ASSERT_EQ(getChunkToSplit(rt, untouchedMin, untouchedMax),
+              getChunkToSplit(newRt, untouchedMin, untouchedMax));
+    ASSERT(std::equal(rt->getChunkMap().begin(),
+                      rt->getChunkMap().end(),
+                      newRt->getChunkMap().begin(),
+                      [](const auto& a, const auto& b) { return a.first == b.first; }));
+}
+
+/**
+ * Builds a routing table from scratch out of the chunks of "rt" and checks that "rt" has the same
+ * chunks, collection and shard versions, and finds the same chunk for every chunk's min.
+ */
+void assertMatchesTableBuiltFromScratch(const std::shared_ptr<RoutingTableHistory>& rt) {
+    std::vector<ChunkType> chunks;
+    for (const auto& entry : rt->getChunkMap()) {
+        const auto& chunk = *entry.second;
+        chunks.emplace_back(
+            kNss, chunk.getRange(), chunk.getLastmod(), chunk.getShardIdAt(boost::none));
+    }
+    std::sort(chunks.begin(), chunks.end(), [](const ChunkType& a, const ChunkType& b) {
+        return a.getVersion() < b.getVersion();
+    });
+
+    const auto expected =
+        RoutingTableHistory::makeNew(kNss,
+                                     rt->getUUID(),
+                                     KeyPattern(rt->getShardKeyPattern().getKeyPattern()),
+                                     nullptr,
+                                     false,
+                                     rt->getVersion().epoch(),
+                                     chunks);
+
+    ASSERT_EQ(expected->getChunkMap().size(), rt->getChunkMap().size());
+    auto it = rt->getChunkMap().begin();
+    for (const auto& [key, expectedChunk] : expected->getChunkMap()) {
+        ASSERT_EQ(key, it->first);
+        ASSERT_BSONOBJ_EQ(expectedChunk->getMin(), it->second->getMin());
+        ASSERT_BSONOBJ_EQ(expectedChunk->getMax(), it->second->getMax());
+        ASSERT_EQ(expectedChunk->getLastmod(), it->second->getLastmod());
+        ASSERT_EQ(expectedChunk->getShardIdAt(boost::none), it->second->getShardIdAt(boost::none));
+        ++it;
+    }
+
+    ASSERT_EQ(expected->getVersion(), rt->getVersion());
+    std::set<ShardId> expectedShardIds, shardIds;
+    expected->getAllShardIds(&expectedShardIds);
+    rt->getAllShardIds(&shardIds);
+    ASSERT(expectedShardIds == shardIds);
+    for (const auto& shardId : {kThisShard, kOtherShard}) {
+        ASSERT_EQ(expected->getVersion(shardId), rt->getVersion(shardId));
+    }
+
+    ChunkManager cm(rt, boost::none);
+    for (auto chunkIt = std::next(expected->getChunkMap().begin());
+         chunkIt != expected->getChunkMap().end();
+         ++chunkIt) {
+        const auto& min = chunkIt->second->getMin();
+        ASSERT_BSONOBJ_EQ(min, cm.findIntersectingChunkWithSimpleCollation(min).getMin());
+    }
+}
+
+/**
+ * Refreshes "rt" with "changedChunks", checks that every changed chunk which is not replaced by a
+ * later one in the same refresh is in the new routing table, and that the new routing table
+ * matches one built from scratch.
+ */
+std::shared_ptr<RoutingTableHistory> refreshAndCheck(
+    const std::shared_ptr<RoutingTableHistory>& rt, const std::vector<ChunkType>& changedChunks) {
+    auto newRt = rt->makeUpdated(changedChunks);
+    ASSERT_EQ(newRt->getVersion(), changedChunks.back().getVersion());
+
+    for (auto it = changedChunks.begin(); it != changedChunks.end(); ++it) {
+        const auto& range = it->getRange();
+        if (std::any_of(std::next(it), changedChunks.end(), [&](const ChunkType& later) {
+                return bool(later.getRange().overlapWith(range));
+            })) {
+            continue;
+        }
+
+        const auto chunk = getChunkToSplit(newRt, range.getMin(), range.getMax());
+        ASSERT_BSONOBJ_EQ(range.getMin(), chunk->getMin());
+        ASSERT_BSONOBJ_EQ(range.getMax(), chunk->getMax());
+        ASSERT_EQ(it->getVersion(), chunk->getLastmod());
+        ASSERT_EQ(it->getShard(), chunk->getShardIdAt(boost::none));
+    }
+
+    assertMatchesTableBuiltFromScratch(newRt);
+    return newRt;
+}
+
+/**
+ * Describes the chunks changed by a split, merge or migration of the chunks of a routing table,
+ * identified by their position in key order. Every changed chunk gets the next version.
+ */
+class ChunkChanges {
+public:
+    explicit ChunkChanges(const std::shared_ptr<RoutingTableHistory>& rt)
+        : _rt(rt), _version(rt->getVersion()) {}
+
+    /**
+     * Splits the chunk at "index", which must have numeric bounds, into "numPieces" chunks.
+     */
+    ChunkChanges& split(size_t index, int numPieces) {
+        const auto& chunk = *_chunkAt(index);
+        const long long min = chunk.getMin()["a"].numberLong();
+        const long long width = (chunk.getMax()["a"].numberLong() - min) / numPieces;
+        for (int i = 0; i < numPieces; ++i) {
+            const auto pieceMin = i == 0 ? chunk.getMin() : BSON("a" << min + width * i);
+            const auto pieceMax =
+                i + 1 == numPieces ? chunk.getMax() : BSON("a" << min + width * (i + 1));
+            _version.incMinor();
+            _changes.emplace_back(
+                kNss, ChunkRange{pieceMin, pieceMax}, _version, chunk.getShardIdAt(boost::none));
+        }
+        return *this;
+    }
+
+    /**
+     * Merges the chunks at positions "first" to "last" inclusive into one chunk on the shard which
+     * owns the first of them.
+     */
+    ChunkChanges& merge(size_t first, size_t last) {
+        _version.incMinor();
+        _changes.emplace_back(kNss,
+                              ChunkRange{_chunkAt(first)->getMin(), _chunkAt(last)->getMax()},
+                              _version,
+                              _chunkAt(first)->getShardIdAt(boost::none));
+        return *this;
+    }
+
+    /**
+     * Moves the chunk at "index" to "toShard".
+     */
+    ChunkChanges& move(size_t index, const ShardId& toShard) {
+        _version.incMajor();
+        _changes.emplace_back(kNss, _chunkAt(index)->getRange(), _version, toShard);
+        return *this;
+    }
+
+    const std::vector<ChunkType>& get() const {
+        return _changes;
+    }
+
+private:
+    const std::shared_ptr<ChunkInfo>& _chunkAt(size_t index) const {
+        invariant(index < _rt->getChunkMap().size());
+        return std::next(_rt->getChunkMap().begin(), index)->second;
+    }
+
+    std::shared_ptr<RoutingTableHistory> _rt;
+    ChunkVersion _version;
+    std::vector<ChunkType> _changes;
+};
+
+/**
+ * Returns 2048 sorted split points, 1000 apart, which make a routing table of 2049 chunks. Those
+ * are held in 9 blocks of up to 256 chunks, and refreshes of up to 8 chunks are applied to them
+ * incrementally.
+ */
+std::vector<BSONObj> makeIncrementalRefreshSplitPoints() {
+    std::vector<BSONObj> splitPoints;
+    for (long long i = -1024; i < 1024; ++i) {
+        splitPoints.push_back(BSON("a" << i * 1000));
+    }
+    return splitPoints;
+}
+
+TEST(RoutingTableHistoryIncrementalRefresh, SplitsAndMergesMatchTableBuiltFromScratch) {
+    auto rt = makeHashedRoutingTable(makeIncrementalRefreshSplitPoints());
+    ASSERT_EQ(rt->getChunkMap().size(), 2049ull);
+
+    rt = refreshAndCheck(rt, ChunkChanges(rt).split(100, 4).get());
+    ASSERT_EQ(rt->getChunkMap().size(), 2052ull);
+
+    rt = refreshAndCheck(rt, ChunkChanges(rt).merge(300, 303).get());
+    ASSERT_EQ(rt->getChunkMap().size(), 2049ull);
+
+    // A split and a merge in the same refresh, plus a chunk which is split and merged back, so
+    // that the pieces of the split are both added and removed by the refresh
+    rt = refreshAndCheck(
+        rt, ChunkChanges(rt).split(500, 2).merge(600, 602).split(700, 2).merge(700, 700).get());
+    ASSERT_EQ(rt->getChunkMap().size(), 2048ull);
+}
+
+TEST(RoutingTableHistoryIncrementalRefresh, UpdatesSpanningBlocksMatchTableBuiltFromScratch) {
+    auto rt = makeHashedRoutingTable(makeIncrementalRefreshSplitPoints());
+
+    // The last chunk of the first block and the first chunk of the second block
+    rt = refreshAndCheck(rt, ChunkChanges(rt).split(255, 2).split(256, 2).get());
+    ASSERT_EQ(rt->getChunkMap().size(), 2051ull);
+
+    // Merges across one and then several block boundaries
+    rt = refreshAndCheck(rt, ChunkChanges(rt).merge(250, 262).get());
+    rt = refreshAndCheck(rt, ChunkChanges(rt).merge(200, 600).get());
+    ASSERT_EQ(rt->getChunkMap().size(), 1639ull);
+
+    // Migrations of neighbouring chunks in different blocks
+    rt = refreshAndCheck(rt,
+                         ChunkChanges(rt)
+                             .move(199, kOtherShard)
+                             .move(200, kOtherShard)
+                             .move(201, kOtherShard)
+                             .get());
+
+    // Merges which include the first and the last chunk
+    const auto lastIndex = rt->getChunkMap().size() - 1;
+    rt = refreshAndCheck(rt, ChunkChanges(rt).merge(0, 5).merge(1500, lastIndex).get());
+    ASSERT_EQ(rt->getChunkMap().size(), 1634ull - (lastIndex - 1500));
+}
+
+TEST(RoutingTableHistoryIncrementalRefresh, BlockSplitMatchesTableBuiltFromScratch) {
+    auto rt = makeHashedRoutingTable(makeIncrementalRefreshSplitPoints());
+
+    // Split chunks of the first block until it has grown past twice its initial 256 chunks, so
+    // that it is split in two, and then some more
+    for (size_t i = 0; i < 45; ++i) {
+        rt = refreshAndCheck(rt, ChunkChanges(rt).split(1 + 8 * i, 8).get());
+    }
+    ASSERT_EQ(rt->getChunkMap().size(), 2049ull + 45 * 7);
+}
+
+TEST(RoutingTableHistoryIncrementalRefresh, LosingShardVersionChunkMatchesTableBuiltFromScratch) {
+    auto rt = makeHashedRoutingTable(makeIncrementalRefreshSplitPoints());
+    const auto epoch = rt->getVersion().epoch();
+    const size_t lastIndex = rt->getChunkMap().size() - 1;
+    ASSERT_EQ(rt->getVersion(kThisShard), ChunkVersion(1, 2048, epoch));
+
+    // Each time a shard loses the chunk which carries its version, the shard versions are rebuilt
+    // from all chunks
+    rt = refreshAndCheck(rt, ChunkChanges(rt).move(lastIndex, kOtherShard).get());
+    ASSERT_EQ(rt->getVersion(kThisShard), ChunkVersion(1, 2047, epoch));
+    ASSERT_EQ(rt->getVersion(kOtherShard), ChunkVersion(2, 0, epoch));
+
+    rt = refreshAndCheck(rt, ChunkChanges(rt).move(100, kOtherShard).get());
+    ASSERT_EQ(rt->getVersion(kThisShard), ChunkVersion(1, 2047, epoch));
+    ASSERT_EQ(rt->getVersion(kOtherShard), ChunkVersion(3, 0, epoch));
+
+    rt = refreshAndCheck(rt, ChunkChanges(rt).move(100, kThisShard).get());
+    ASSERT_EQ(rt->getVersion(kThisShard), ChunkVersion(4, 0, epoch));
+    ASSERT_EQ(rt->getVersion(kOtherShard), ChunkVersion(2, 0, epoch));
+
+    rt = refreshAndCheck(rt, ChunkChanges(rt).move(lastIndex, kThisShard).get());
+    ASSERT_EQ(rt->getVersion(kThisShard), ChunkVersion(5, 0, epoch));
+    ASSERT_EQ(rt->getVersion(kOtherShard), ChunkVersion(0, 0, epoch));
+    ASSERT_EQ(rt->getNShardsOwningChunks(), 1);
+}
+
+TEST(RoutingTableHistoryIncrementalRefresh, RangeShardKeyMatchesTableBuiltFromScratch) {
+    auto rt = makeRoutingTable(KeyPattern(BSON("a" << 1)), makeIncrementalRefreshSplitPoints());
+
+    rt = refreshAndCheck(rt, ChunkChanges(rt).split(100, 4).merge(300, 303).get());
+    rt = refreshAndCheck(rt, ChunkChanges(rt).split(255, 2).merge(500, 520).get());
+    rt = refreshAndCheck(rt, ChunkChanges(rt).move(256, kOtherShard).move(1000, kOtherShard).get());
+    rt = refreshAndCheck(rt, ChunkChanges(rt).move(256, kThisShard).get());
+
+    const auto lastIndex = rt->getChunkMap().size() - 1;
+    rt = refreshAndCheck(rt, ChunkChanges(rt).merge(0, 5).merge(2000, lastIndex).get());
+}
+
 }  // namespace
 }  // namespace mongo
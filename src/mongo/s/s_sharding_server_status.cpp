@@ -37,6 +37,7 @@
 #include "mongo/s/client/num_hosts_targeted_metrics.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
+#include "mongo/s/write_ops/shard_write_latency_metrics.h"
 
 namespace mongo {
 namespace {
@@ -88,6 +89,7 @@ public:
 
         numHostsTargetedMetrics.appendSection(&result);
         catalogCache->report(&result);
+        ShardWriteLatencyMetrics::get(opCtx).appendSection(&result);
         return result.obj();
     }
 
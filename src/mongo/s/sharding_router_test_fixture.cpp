@@ -245,6 +245,11 @@ void ShardingTestFixture::onCommandForPoolExecutor(NetworkTestEnv::OnCommandFunc
     _networkTestEnvForPool->onCommand(func);
 }
 
+void ShardingTestFixture::onConcurrentCommandsForPoolExecutor(
+    std::vector<NetworkTestEnv::OnCommandFunction> funcs) {
+    _networkTestEnvForPool->onConcurrentCommands(std::move(funcs));
+}
+
 void ShardingTestFixture::addRemoteShards(
     const std::vector<std::tuple<ShardId, HostAndPort>>& shardInfos) {
     std::vector<ShardType> shards;
@@ -73,6 +73,8 @@ public:
      * executor of the Grid's executorPool.
      */
     void onCommandForPoolExecutor(executor::NetworkTestEnv::OnCommandFunction func);
+    void onConcurrentCommandsForPoolExecutor(
+        std::vector<executor::NetworkTestEnv::OnCommandFunction> funcs);
 
     /**
      * Setup the shard registry to contain the given shards until the next reload.
@@ -33,6 +33,8 @@
 
 #include "mongo/s/write_ops/batch_write_exec.h"
 
+#include <deque>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/base/owned_pointer_map.h"
 #include "mongo/base/status.h"
@@ -47,7 +49,9 @@
 #include "mongo/s/grid.h"
 #include "mongo/s/multi_statement_transaction_requests_sender.h"
 #include "mongo/s/transaction_router.h"
+#include "mongo/s/write_ops/batch_write_exec_gen.h"
 #include "mongo/s/write_ops/batch_write_op.h"
+#include "mongo/s/write_ops/shard_write_latency_metrics.h"
 #include "mongo/s/write_ops/write_error_detail.h"
 #include "mongo/util/exit.h"
 
@@ -112,6 +116,15 @@ bool hasTransientTransactionError(const BatchedCommandResponse& response) {
 // applies when no writes are occurring and metadata is not changing on reload.
 const int kMaxRoundsWithoutProgress(5);
 
+/**
+ * The child batches of a round which have been sent to the shards, and the sender to collect their
+ * responses from.
+ */
+struct PendingRound {
+    OwnedPointerMap<ShardId, TargetedWriteBatch> batches;
+    boost::optional<MultiStatementTransactionRequestsSender> ars;
+};
+
 }  // namespace
 
 void BatchWriteExec::executeBatch(OperationContext* opCtx,
@@ -137,6 +150,17 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
     int numRoundsWithoutProgress = 0;
     bool abortBatch = false;
 
+    // Unordered writes outside of transactions keep targeting and sending rounds of child batches
+    // while the responses to earlier rounds are outstanding, so that each shard has up to
+    // 'maxRoundsInFlight' child batches to work on instead of waiting for a round trip between
+    // them. Ordered writes and transactions must see the outcome of each round before targeting
+    // the next one.
+    const int maxRoundsInFlight =
+        (clientRequest.getWriteCommandBase().getOrdered() || TransactionRouter::get(opCtx))
+        ? 1
+        : gMaxOutstandingWriteBatchesPerShard.load();
+    std::deque<std::unique_ptr<PendingRound>> pendingRounds;
+
     while (!batchOp.isFinished() && !abortBatch) {
         //
         // Get child batches to send using the targeter
@@ -161,67 +185,58 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
         //    deliver in this case, since for all the client knows we may have gotten the batch
         //    exactly when the metadata changed.
         //
+        // Only the write ops which are not already part of an outstanding round are targeted, so
+        // the ops of a child batch which failed with a stale routing error are retargeted as soon
+        // as the targeter has been refreshed, without waiting for the other outstanding rounds.
+        //
+
+        // Once too many rounds have completed without progress, stop targeting new rounds so that
+        // the outstanding ones drain and the batch can be aborted below.
+        bool abortOnTargetError = false;
+        while (static_cast<int>(pendingRounds.size()) < maxRoundsInFlight &&
+               numRoundsWithoutProgress <= kMaxRoundsWithoutProgress) {
+            auto round = std::make_unique<PendingRound>();
+            auto& childBatches = round->batches.mutableMap();
+
+            // If we've already had a targeting error, we've refreshed the metadata once and can
+            // record target errors definitively.
+            bool recordTargetErrors = refreshedTargeter;
+            Status targetStatus = batchOp.targetBatch(targeter, recordTargetErrors, &childBatches);
+            if (!targetStatus.isOK()) {
+                // Don't do anything until a targeter refresh
+                targeter.noteCouldNotTarget();
+                refreshedTargeter = true;
+                ++stats->numTargetErrors;
+                dassert(childBatches.size() == 0u);
+
+                if (TransactionRouter::get(opCtx)) {
+                    batchOp.forgetTargetedBatchesOnTransactionAbortingError();
+
+                    // Throw when there is a transient transaction error since this should be a top
+                    // level error and not just a write error.
+                    if (isTransientTransactionError(targetStatus.code(), false, false)) {
+                        uassertStatusOK(targetStatus);
+                    }
 
-        OwnedPointerMap<ShardId, TargetedWriteBatch> childBatchesOwned;
-        std::map<ShardId, TargetedWriteBatch*>& childBatches = childBatchesOwned.mutableMap();
-
-        // If we've already had a targeting error, we've refreshed the metadata once and can
-        // record target errors definitively.
-        bool recordTargetErrors = refreshedTargeter;
-        Status targetStatus = batchOp.targetBatch(targeter, recordTargetErrors, &childBatches);
-        if (!targetStatus.isOK()) {
-            // Don't do anything until a targeter refresh
-            targeter.noteCouldNotTarget();
-            refreshedTargeter = true;
-            ++stats->numTargetErrors;
-            dassert(childBatches.size() == 0u);
-
-            if (TransactionRouter::get(opCtx)) {
-                batchOp.forgetTargetedBatchesOnTransactionAbortingError();
-
-                // Throw when there is a transient transaction error since this should be a top
-                // level error and not just a write error.
-                if (isTransientTransactionError(targetStatus.code(), false, false)) {
-                    uassertStatusOK(targetStatus);
+                    abortOnTargetError = true;
                 }
 
                 break;
             }
-        }
 
-        //
-        // Send all child batches
-        //
-
-        const size_t numToSend = childBatches.size();
-        size_t numSent = 0;
-
-        while (numSent != numToSend) {
-            // Collect batches out on the network, mapped by endpoint
-            OwnedPointerMap<ShardId, TargetedWriteBatch> ownedPendingBatches;
-            OwnedPointerMap<ShardId, TargetedWriteBatch>::MapType& pendingBatches =
-                ownedPendingBatches.mutableMap();
+            if (childBatches.empty()) {
+                break;
+            }
 
             //
-            // Construct the requests.
+            // Send all child batches
             //
 
             std::vector<AsyncRequestsSender::Request> requests;
-
-            // Get as many batches as we can at once
-            for (auto& childBatch : childBatches) {
+            for (const auto& childBatch : childBatches) {
                 TargetedWriteBatch* const nextBatch = childBatch.second;
-
-                // If the batch is nullptr, we sent it previously, so skip
-                if (!nextBatch)
-                    continue;
-
-                // If we already have a batch for this shard, wait until the next time
                 const auto& targetShardId = nextBatch->getEndpoint().shardName;
 
-                if (pendingBatches.count(targetShardId))
-                    continue;
-
                 stats->noteTargetedShard(targetShardId);
 
                 const auto request = [&] {
@@ -242,30 +257,34 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                             "request"_attr = redact(request));
 
                 requests.emplace_back(targetShardId, request);
-
-                // Indicate we're done by setting the batch to nullptr. We'll only get duplicate
-                // hostEndpoints if we have broadcast and non-broadcast endpoints for the same host,
-                // so this should be pretty efficient without moving stuff around.
-                childBatch.second = nullptr;
-
-                // Recv-side is responsible for cleaning up the nextBatch when used
-                pendingBatches.emplace(targetShardId, nextBatch);
             }
 
             bool isRetryableWrite = opCtx->getTxnNumber() && !TransactionRouter::get(opCtx);
 
-            MultiStatementTransactionRequestsSender ars(
+            round->ars.emplace(
                 opCtx,
                 Grid::get(opCtx)->getExecutorPool()->getArbitraryExecutor(),
                 clientRequest.getNS().db().toString(),
                 requests,
                 kPrimaryOnlyReadPreference,
                 isRetryableWrite ? Shard::RetryPolicy::kIdempotent : Shard::RetryPolicy::kNoRetry);
-            numSent += pendingBatches.size();
+            pendingRounds.push_back(std::move(round));
+        }
 
-            //
-            // Receive the responses.
-            //
+        if (abortOnTargetError) {
+            break;
+        }
+
+        //
+        // Receive the responses of the oldest outstanding round.
+        //
+
+        if (!pendingRounds.empty()) {
+            auto round = std::move(pendingRounds.front());
+            pendingRounds.pop_front();
+
+            auto& pendingBatches = round->batches.mutableMap();
+            auto& ars = *round->ars;
 
             while (!ars.done()) {
                 // Block until a response is available.
@@ -275,6 +294,11 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                 dassert(pendingBatches.find(response.shardId) != pendingBatches.end());
                 TargetedWriteBatch* batch = pendingBatches.find(response.shardId)->second;
 
+                if (response.swResponse.isOK() && response.swResponse.getValue().elapsed) {
+                    ShardWriteLatencyMetrics::get(opCtx).record(
+                        response.shardId, *response.swResponse.getValue().elapsed);
+                }
+
                 const auto shardInfo = response.shardHostAndPort
                     ? response.shardHostAndPort->toString()
                     : batch->getEndpoint().shardName;
@@ -444,7 +468,7 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
         }
         numCompletedOps = currCompletedOps;
 
-        if (numRoundsWithoutProgress > kMaxRoundsWithoutProgress) {
+        if (numRoundsWithoutProgress > kMaxRoundsWithoutProgress && pendingRounds.empty()) {
             batchOp.abortBatch(errorFromStatus(
                 {ErrorCodes::NoProgressMade,
                  str::stream() << "no progress was made executing batch write op in "
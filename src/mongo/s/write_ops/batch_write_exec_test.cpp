@@ -45,6 +45,7 @@
 #include "mongo/s/write_ops/batched_command_request.h"
 #include "mongo/s/write_ops/batched_command_response.h"
 #include "mongo/s/write_ops/mock_ns_targeter.h"
+#include "mongo/s/write_ops/shard_write_latency_metrics.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -206,7 +207,13 @@ public:
 
     void expectInsertsReturnSuccess(std::vector<BSONObj>::const_iterator expectedFrom,
                                     std::vector<BSONObj>::const_iterator expectedTo) {
-        onCommandForPoolExecutor([&](const executor::RemoteCommandRequest& request) {
+        onCommandForPoolExecutor(insertsReturnSuccess(expectedFrom, expectedTo));
+    }
+
+    executor::NetworkTestEnv::OnCommandFunction insertsReturnSuccess(
+        std::vector<BSONObj>::const_iterator expectedFrom,
+        std::vector<BSONObj>::const_iterator expectedTo) {
+        return [this, expectedFrom, expectedTo](const executor::RemoteCommandRequest& request) {
             ASSERT_EQUALS(nss.db(), request.dbname);
 
             const auto opMsgRequest(OpMsgRequest::fromDBAndBody(request.dbname, request.cmdObj));
@@ -229,7 +236,7 @@ public:
             response.setN(inserted.size());
 
             return response.toBSON();
-        });
+        };
     }
 
     void expectInsertsReturnStaleVersionErrors(const std::vector<BSONObj>& expected) {
@@ -355,6 +362,58 @@ TEST_F(BatchWriteExecTest, MultiOpLarge) {
     future.default_timed_get();
 }
 
+TEST_F(BatchWriteExecTest, MultiOpLargeUnorderedPipelinesChildBatches) {
+    const int kNumDocsToInsert = 100'000;
+    const std::string kDocValue(200, 'x');
+
+    std::vector<BSONObj> docsToInsert;
+    docsToInsert.reserve(kNumDocsToInsert);
+    for (int i = 0; i < kNumDocsToInsert; i++) {
+        docsToInsert.push_back(BSON("_id" << i << "someLargeKeyToWasteSpace" << kDocValue));
+    }
+
+    BatchedCommandRequest request([&] {
+        write_ops::Insert insertOp(nss);
+        insertOp.setWriteCommandBase([] {
+            write_ops::WriteCommandBase writeCommandBase;
+            writeCommandBase.setOrdered(false);
+            return writeCommandBase;
+        }());
+        insertOp.setDocuments(docsToInsert);
+        return insertOp;
+    }());
+    request.setWriteConcern(BSONObj());
+
+    const auto getBatchesSentToShard1 = [&] {
+        BSONObjBuilder builder;
+        ShardWriteLatencyMetrics::get(getServiceContext()).appendSection(&builder);
+        const auto shardLatency = builder.obj()["writeBatchLatency"][kShardName1];
+        return shardLatency.isABSONObj() ? shardLatency["batches"].numberLong() : 0LL;
+    };
+    const auto batchesSentBefore = getBatchesSentToShard1();
+
+    auto future = launchAsync([&] {
+        BatchedCommandResponse response;
+        BatchWriteExecStats stats;
+        BatchWriteExec::executeBatch(
+            operationContext(), singleShardNSTargeter, request, &response, &stats);
+
+        ASSERT(response.getOk());
+        ASSERT_EQUALS(response.getN(), kNumDocsToInsert);
+        ASSERT_EQUALS(stats.numRounds, 2);
+    });
+
+    // The second child batch is targeted and sent without waiting for the response to the first,
+    // so both are outstanding before either is answered. They are answered in reverse order.
+    onConcurrentCommandsForPoolExecutor(
+        {insertsReturnSuccess(docsToInsert.begin(), docsToInsert.begin() + 66576),
+         insertsReturnSuccess(docsToInsert.begin() + 66576, docsToInsert.end())});
+
+    future.default_timed_get();
+
+    ASSERT_EQ(getBatchesSentToShard1() - batchesSentBefore, 2);
+}
+
 TEST_F(BatchWriteExecTest, SingleOpError) {
     BatchedCommandResponse errResponse;
     errResponse.setStatus({ErrorCodes::UnknownError, "mock error"});
@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/write_ops/shard_write_latency_metrics.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+namespace {
+
+const auto getShardWriteLatencyMetrics =
+    ServiceContext::declareDecoration<ShardWriteLatencyMetrics>();
+
+int getBucket(long long micros) {
+    if (micros <= 0) {
+        return 0;
+    }
+    const int bucket = 64 - countLeadingZeros64(static_cast<unsigned long long>(micros));
+    return std::min(bucket, ShardWriteLatencyMetrics::kNumBuckets - 1);
+}
+
+}  // namespace
+
+ShardWriteLatencyMetrics& ShardWriteLatencyMetrics::get(ServiceContext* serviceContext) {
+    return getShardWriteLatencyMetrics(serviceContext);
+}
+
+ShardWriteLatencyMetrics& ShardWriteLatencyMetrics::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+void ShardWriteLatencyMetrics::record(const ShardId& shardId, Microseconds latency) {
+    const auto micros = durationCount<Microseconds>(latency);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto& histogram = _histograms[shardId];
+    ++histogram.buckets[getBucket(micros)];
+    ++histogram.batches;
+    histogram.totalMicros += micros;
+}
+
+void ShardWriteLatencyMetrics::appendSection(BSONObjBuilder* builder) const {
+    BSONObjBuilder latencyBuilder(builder->subobjStart("writeBatchLatency"));
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (const auto& [shardId, histogram] : _histograms) {
+        BSONObjBuilder shardBuilder(latencyBuilder.subobjStart(shardId.toString()));
+        shardBuilder.append("batches", histogram.batches);
+        shardBuilder.append("latency", histogram.totalMicros);
+
+        BSONArrayBuilder bucketsBuilder(shardBuilder.subarrayStart("histogram"));
+        for (int i = 0; i < kNumBuckets; ++i) {
+            if (histogram.buckets[i] == 0) {
+                continue;
+            }
+            BSONObjBuilder bucketBuilder(bucketsBuilder.subobjStart());
+            bucketBuilder.append("micros", i == 0 ? 0LL : 1LL << (i - 1));
+            bucketBuilder.append("count", histogram.buckets[i]);
+        }
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,77 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+
+#include "mongo/platform/mutex.h"
+#include "mongo/s/shard_id.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Histograms of the round trip latency of the child write batches which mongos sends to each
+ * shard, reported under shardingStatistics in serverStatus.
+ */
+class ShardWriteLatencyMetrics {
+public:
+    // Bucket 'i' counts latencies in [2^(i - 1), 2^i) microseconds, and the last bucket counts all
+    // latencies of 2^(kNumBuckets - 2) microseconds (about 33 seconds) or more.
+    static constexpr int kNumBuckets = 27;
+
+    static ShardWriteLatencyMetrics& get(ServiceContext* serviceContext);
+    static ShardWriteLatencyMetrics& get(OperationContext* opCtx);
+
+    /**
+     * Records that a child write batch sent to 'shardId' completed after 'latency'.
+     */
+    void record(const ShardId& shardId, Microseconds latency);
+
+    void appendSection(BSONObjBuilder* builder) const;
+
+private:
+    struct Histogram {
+        std::array<long long, kNumBuckets> buckets{};
+        long long batches = 0;
+        long long totalMicros = 0;
+    };
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ShardWriteLatencyMetrics::_mutex");
+    stdx::unordered_map<ShardId, Histogram, ShardId::Hasher> _histograms;
+};
+
+}  // namespace mongo
@@ -240,6 +240,34 @@ TEST(ZstdMessageCompressor, Fidelity) {
     checkFidelity(testMessage, std::make_unique<ZstdMessageCompressor>());
 }
 
+TEST(ZstdMessageCompressor, ContextReuse) {
+    // The zstd compressor reuses pooled contexts, so state from an earlier (possibly failed) call
+    // must not leak into the next one. Contexts used for the largest message are freed instead.
+    ZstdMessageCompressor compressor;
+    checkOverflow(std::make_unique<ZstdMessageCompressor>());
+
+    for (size_t size : {1, 100, 64 * 1024, 10, 1024 * 1024}) {
+        std::string data;
+        for (size_t i = 0; i < size; ++i) {
+            data.push_back('a' + (i * 7 + size) % 26);
+        }
+
+        std::vector<char> compressed(compressor.getMaxCompressedSize(data.size()));
+        auto swCompressed = compressor.compressData(
+            ConstDataRange(data.data(), data.size()),
+            DataRange(compressed.data(), compressed.size()));
+        ASSERT_OK(swCompressed);
+
+        std::vector<char> decompressed(data.size());
+        auto swDecompressed = compressor.decompressData(
+            ConstDataRange(compressed.data(), swCompressed.getValue()),
+            DataRange(decompressed.data(), decompressed.size()));
+        ASSERT_OK(swDecompressed);
+        ASSERT_EQ(swDecompressed.getValue(), data.size());
+        ASSERT_EQ(memcmp(decompressed.data(), data.data(), data.size()), 0);
+    }
+}
+
 TEST(SnappyMessageCompressor, Overflow) {
     checkOverflow(std::make_unique<SnappyMessageCompressor>());
 }
@@ -30,14 +30,97 @@
 #include "mongo/platform/basic.h"
 
 #include <memory>
+#include <vector>
 
 #include <zstd.h>
 
 #include "mongo/base/init.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_zstd.h"
+#include "mongo/util/assert_util.h"
 
 namespace mongo {
+namespace {
+
+struct ZstdCCtxDeleter {
+    void operator()(ZSTD_CCtx* ctx) const {
+        ZSTD_freeCCtx(ctx);
+    }
+};
+
+struct ZstdDCtxDeleter {
+    void operator()(ZSTD_DCtx* ctx) const {
+        ZSTD_freeDCtx(ctx);
+    }
+};
+
+/**
+ * ZSTD_compress() and ZSTD_decompress() create and tear down a context, including its window and
+ * hash tables, on every call. Instead, the compressor, which every session shares, keeps idle
+ * contexts in a pool: each call checks a context out and returns it when done.
+ *
+ * A context keeps the tables sized for the largest message it has handled, up to about a
+ * megabyte for compression, so the pool keeps at most kMaxIdleContexts of them, and frees rather
+ * than keeps the contexts which handled messages over kMaxPooledMessageSize. Its memory therefore
+ * does not grow with the number of threads or connections.
+ */
+template <typename Context, typename Deleter, Context* (*create)()>
+class ZstdContextPool {
+public:
+    using ContextPtr = std::unique_ptr<Context, Deleter>;
+
+    static constexpr size_t kMaxIdleContexts = 8;
+    static constexpr size_t kMaxPooledMessageSize = 128 * 1024;
+
+    ContextPtr acquire() {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (!_idleContexts.empty()) {
+                auto ctx = std::move(_idleContexts.back());
+                _idleContexts.pop_back();
+                return ctx;
+            }
+        }
+
+        ContextPtr ctx{create()};
+        invariant(ctx);
+        return ctx;
+    }
+
+    /**
+     * Returns 'ctx', which was last used for a message of 'messageSize' bytes, to the pool.
+     */
+    void release(ContextPtr ctx, size_t messageSize) {
+        if (messageSize > kMaxPooledMessageSize) {
+            return;
+        }
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_idleContexts.size() < kMaxIdleContexts) {
+            _idleContexts.push_back(std::move(ctx));
+        }
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("ZstdContextPool::_mutex");
+    std::vector<ContextPtr> _idleContexts;
+};
+
+using ZstdCompressionContextPool = ZstdContextPool<ZSTD_CCtx, ZstdCCtxDeleter, ZSTD_createCCtx>;
+using ZstdDecompressionContextPool = ZstdContextPool<ZSTD_DCtx, ZstdDCtxDeleter, ZSTD_createDCtx>;
+
+ZstdCompressionContextPool& compressionContextPool() {
+    static auto& pool = *new ZstdCompressionContextPool();
+    return pool;
+}
+
+ZstdDecompressionContextPool& decompressionContextPool() {
+    static auto& pool = *new ZstdDecompressionContextPool();
+    return pool;
+}
+
+}  // namespace
 
 ZstdMessageCompressor::ZstdMessageCompressor() : MessageCompressorBase(MessageCompressor::kZstd) {}
 
@@ -47,11 +130,14 @@ std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
 
 StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
                                                             DataRange output) {
-    size_t ret = ZSTD_compress(const_cast<char*>(output.data()),
-                               output.length(),
-                               input.data(),
-                               input.length(),
-                               ZSTD_CLEVEL_DEFAULT);
+    auto ctx = compressionContextPool().acquire();
+    size_t ret = ZSTD_compressCCtx(ctx.get(),
+                                   const_cast<char*>(output.data()),
+                                   output.length(),
+                                   input.data(),
+                                   input.length(),
+                                   ZSTD_CLEVEL_DEFAULT);
+    compressionContextPool().release(std::move(ctx), input.length());
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -63,8 +149,13 @@ StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input
 
 StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
                                                               DataRange output) {
-    size_t ret = ZSTD_decompress(
-        const_cast<char*>(output.data()), output.length(), input.data(), input.length());
+    auto ctx = decompressionContextPool().acquire();
+    size_t ret = ZSTD_decompressDCtx(ctx.get(),
+                                     const_cast<char*>(output.data()),
+                                     output.length(),
+                                     input.data(),
+                                     input.length());
+    decompressionContextPool().release(std::move(ctx), output.length());
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
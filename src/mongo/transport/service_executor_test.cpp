@@ -38,6 +38,7 @@
 #include "mongo/transport/service_executor_adaptive.h"
 #include "mongo/transport/service_executor_synchronous.h"
 #include "mongo/transport/service_executor_task_names.h"
+#include "mongo/transport/service_executor_work_stealing.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/scopeguard.h"
 
@@ -182,6 +183,39 @@ protected:
     std::unique_ptr<ServiceExecutorSynchronous> executor;
 };
 
+struct WorkStealingTestOptions : public ServiceExecutorWorkStealing::Options {
+    int workerThreads() const final {
+        return 2;
+    }
+
+    Milliseconds reactorPollTime() const final {
+        return Milliseconds{10};
+    }
+
+    int recursionLimit() const final {
+        return 0;
+    }
+
+    bool pinWorkersToCores() const final {
+        return false;
+    }
+};
+
+class ServiceExecutorWorkStealingFixture : public unittest::Test {
+protected:
+    void setUp() override {
+        auto scOwned = ServiceContext::make();
+        setGlobalServiceContext(std::move(scOwned));
+
+        executor = std::make_unique<ServiceExecutorWorkStealing>(
+            getGlobalServiceContext(),
+            std::make_shared<ASIOReactor>(),
+            std::make_unique<WorkStealingTestOptions>());
+    }
+
+    std::unique_ptr<ServiceExecutorWorkStealing> executor;
+};
+
 void scheduleBasicTask(ServiceExecutor* exec, bool expectSuccess) {
     stdx::condition_variable cond;
     auto mutex = MONGO_MAKE_LATCH();
@@ -223,6 +257,52 @@ TEST_F(ServiceExecutorSynchronousFixture, ScheduleFailsBeforeStartup) {
     scheduleBasicTask(executor.get(), false);
 }
 
+TEST_F(ServiceExecutorWorkStealingFixture, BasicTaskRuns) {
+    ASSERT_OK(executor->start());
+    auto guard = makeGuard([this] { ASSERT_OK(executor->shutdown(kShutdownTime)); });
+
+    scheduleBasicTask(executor.get(), true);
+}
+
+TEST_F(ServiceExecutorWorkStealingFixture, ScheduleFailsBeforeStartup) {
+    scheduleBasicTask(executor.get(), false);
+}
+
+TEST_F(ServiceExecutorWorkStealingFixture, TaskScheduledByBlockedWorkerIsStolen) {
+    ASSERT_OK(executor->start());
+    auto guard = makeGuard([this] { ASSERT_OK(executor->shutdown(kShutdownTime)); });
+
+    auto mutex = MONGO_MAKE_LATCH();
+    stdx::condition_variable cond;
+    bool stolenTaskRan = false;
+    stdx::thread::id blockedThread;
+    stdx::thread::id stolenTaskThread;
+
+    // The first task queues a second task on its own worker and then blocks until the second task
+    // has run, which can only happen if the other worker steals it.
+    auto blockingTask = [&] {
+        stdx::unique_lock<Latch> lk(mutex);
+        blockedThread = stdx::this_thread::get_id();
+        ASSERT_OK(executor->schedule(
+            [&] {
+                stdx::lock_guard<Latch> lk(mutex);
+                stolenTaskThread = stdx::this_thread::get_id();
+                stolenTaskRan = true;
+                cond.notify_all();
+            },
+            ServiceExecutor::kEmptyFlags,
+            ServiceExecutorTaskName::kSSMProcessMessage));
+        cond.wait(lk, [&] { return stolenTaskRan; });
+    };
+
+    ASSERT_OK(executor->schedule(std::move(blockingTask),
+                                 ServiceExecutor::kEmptyFlags,
+                                 ServiceExecutorTaskName::kSSMStartSession));
+
+    stdx::unique_lock<Latch> lk(mutex);
+    cond.wait(lk, [&] { return stolenTaskRan; });
+    ASSERT_NE(blockedThread, stolenTaskThread);
+}
 
 }  // namespace
 }  // namespace mongo
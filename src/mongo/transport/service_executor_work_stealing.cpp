@@ -0,0 +1,352 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kExecutor
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/service_executor_work_stealing.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "mongo/logv2/log.h"
+#include "mongo/transport/service_entry_point_utils.h"
+#include "mongo/transport/service_executor_gen.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/processinfo.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+constexpr auto kTotalQueued = "totalQueued"_sd;
+constexpr auto kTotalExecuted = "totalExecuted"_sd;
+constexpr auto kTotalStolen = "totalStolen"_sd;
+constexpr auto kThreadsRunning = "threadsRunning"_sd;
+constexpr auto kThreadsPolling = "threadsPolling"_sd;
+constexpr auto kExecutorLabel = "executor"_sd;
+constexpr auto kExecutorName = "workStealing"_sd;
+
+struct ServerParameterOptions : public ServiceExecutorWorkStealing::Options {
+    int workerThreads() const final {
+        if (workStealingServiceExecutorThreadCount > 0) {
+            return workStealingServiceExecutorThreadCount;
+        }
+        return std::max(static_cast<int>(ProcessInfo::getNumAvailableCores()), 1);
+    }
+
+    Milliseconds reactorPollTime() const final {
+        return Milliseconds{workStealingServiceExecutorPollTimeMillis.load()};
+    }
+
+    int recursionLimit() const final {
+        return workStealingServiceExecutorRecursionLimit.load();
+    }
+
+    bool pinWorkersToCores() const final {
+        return workStealingServiceExecutorPinWorkersToCores;
+    }
+};
+
+/**
+ * Binds the calling thread to one of the cores this process is allowed to run on, chosen by
+ * 'workerId'.
+ */
+void pinThreadToCore(size_t workerId) {
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        LOGV2_WARNING(5135210,
+                      "Failed to read the CPU affinity of the process",
+                      "error"_attr = errnoWithDescription());
+        return;
+    }
+
+    const auto numAllowed = static_cast<size_t>(CPU_COUNT(&allowed));
+    if (numAllowed == 0) {
+        return;
+    }
+
+    // Find the (workerId % numAllowed)-th core in the allowed set.
+    auto target = workerId % numAllowed;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (!CPU_ISSET(cpu, &allowed) || target-- > 0) {
+            continue;
+        }
+
+        cpu_set_t pinned;
+        CPU_ZERO(&pinned);
+        CPU_SET(cpu, &pinned);
+        if (int ret = pthread_setaffinity_np(pthread_self(), sizeof(pinned), &pinned); ret != 0) {
+            LOGV2_WARNING(5135211,
+                          "Failed to pin worker thread to core",
+                          "core"_attr = cpu,
+                          "error"_attr = errnoWithDescription(ret));
+        }
+        return;
+    }
+#endif
+}
+
+}  // namespace
+
+thread_local ServiceExecutorWorkStealing* ServiceExecutorWorkStealing::_localExecutor = nullptr;
+thread_local ServiceExecutorWorkStealing::Worker* ServiceExecutorWorkStealing::_localWorker =
+    nullptr;
+
+ServiceExecutorWorkStealing::ServiceExecutorWorkStealing(ServiceContext* ctx,
+                                                         ReactorHandle reactor)
+    : ServiceExecutorWorkStealing(
+          ctx, std::move(reactor), std::make_unique<ServerParameterOptions>()) {}
+
+ServiceExecutorWorkStealing::ServiceExecutorWorkStealing(ServiceContext* ctx,
+                                                         ReactorHandle reactor,
+                                                         std::unique_ptr<Options> config)
+    : _reactorHandle(std::move(reactor)), _config(std::move(config)) {}
+
+ServiceExecutorWorkStealing::~ServiceExecutorWorkStealing() {
+    invariant(!_isRunning.load());
+}
+
+Status ServiceExecutorWorkStealing::start() {
+    invariant(!_isRunning.load());
+    invariant(_workers.empty());
+
+    // Every worker must exist before any thread starts, since idle workers look at all of their
+    // peers' queues.
+    const auto numWorkers = static_cast<size_t>(std::max(_config->workerThreads(), 1));
+    for (size_t i = 0; i < numWorkers; ++i) {
+        _workers.emplace_back(std::make_unique<Worker>(i));
+    }
+
+    _isRunning.store(true);
+    for (auto& worker : _workers) {
+        _threadsRunning.addAndFetch(1);
+        auto status = launchServiceWorkerThread(
+            [this, worker = worker.get()] { _workerThreadRoutine(worker); });
+        if (!status.isOK()) {
+            _threadsRunning.subtractAndFetch(1);
+            return status;
+        }
+    }
+
+    LOGV2(5135212, "Started work stealing service executor", "numWorkers"_attr = numWorkers);
+    return Status::OK();
+}
+
+Status ServiceExecutorWorkStealing::shutdown(Milliseconds timeout) {
+    if (!_isRunning.load())
+        return Status::OK();
+
+    _isRunning.store(false);
+    _reactorHandle->stop();
+
+    stdx::unique_lock<Latch> lk(_shutdownMutex);
+    bool result = _shutdownCondition.wait_for(
+        lk, timeout.toSystemDuration(), [this] { return _threadsRunning.load() == 0; });
+
+    return result
+        ? Status::OK()
+        : Status(ErrorCodes::Error::ExceededTimeLimit,
+                 "work stealing executor couldn't shutdown all worker threads within time limit.");
+}
+
+Status ServiceExecutorWorkStealing::schedule(Task task,
+                                             ScheduleFlags flags,
+                                             ServiceExecutorTaskName taskName) {
+    if (!_isRunning.load()) {
+        return {ErrorCodes::ShutdownInProgress, "Executor is not running"};
+    }
+
+    auto worker = _currentWorker();
+    _totalQueued.addAndFetch(1);
+
+    // If the task is allowed to recurse and we are not over the depth limit, run it immediately on
+    // this worker.
+    if (worker && (flags & kMayRecurse) &&
+        (worker->recursionDepth + 1 < _config->recursionLimit())) {
+        _runTask(worker, task);
+        return Status::OK();
+    }
+
+    // Keep tasks scheduled by a worker on that worker so that a ServiceStateMachine keeps running
+    // on the same core. Tasks scheduled from other threads are spread across the workers.
+    auto target = worker ? worker : _workers[_nextWorker.fetchAndAdd(1) % _workers.size()].get();
+    {
+        stdx::lock_guard<Latch> lk(target->mutex);
+        target->queue.emplace_back(std::move(task));
+    }
+    _tasksQueued.addAndFetch(1);
+
+    // A worker that is running a task returns to its queue once the task finishes. Otherwise the
+    // task may sit behind a worker that is blocked in the reactor, so wake up a polling worker to
+    // run or steal it.
+    const bool willRunAfterCurrentTask = worker && worker->recursionDepth > 0;
+    if (!willRunAfterCurrentTask && _workersPolling.load() > 0) {
+        _reactorHandle->schedule([this](Status status) {
+            if (!status.isOK()) {
+                return;
+            }
+            if (auto worker = _currentWorker()) {
+                _runQueuedTasks(worker);
+            }
+        });
+    }
+
+    return Status::OK();
+}
+
+ServiceExecutorWorkStealing::Worker* ServiceExecutorWorkStealing::_currentWorker() const {
+    return _localExecutor == this ? _localWorker : nullptr;
+}
+
+void ServiceExecutorWorkStealing::_runTask(Worker* worker, Task& task) {
+    // A worker may run tasks from inside a reactor callback, in which case it is no longer idle.
+    const bool wasPolling = worker->polling.swap(false);
+    if (wasPolling) {
+        _workersPolling.subtractAndFetch(1);
+    }
+
+    ++worker->recursionDepth;
+    const auto guard = makeGuard([&] {
+        --worker->recursionDepth;
+        worker->executed.addAndFetch(1);
+        if (wasPolling) {
+            worker->polling.store(true);
+            _workersPolling.addAndFetch(1);
+        }
+    });
+
+    task();
+}
+
+void ServiceExecutorWorkStealing::_runQueuedTasks(Worker* worker) {
+    Task task;
+    while (_isRunning.load() && (_popLocalTask(worker, &task) || _stealTask(worker, &task))) {
+        _runTask(worker, task);
+        task = nullptr;
+    }
+}
+
+bool ServiceExecutorWorkStealing::_popLocalTask(Worker* worker, Task* task) {
+    stdx::lock_guard<Latch> lk(worker->mutex);
+    if (worker->queue.empty()) {
+        return false;
+    }
+
+    *task = std::move(worker->queue.front());
+    worker->queue.pop_front();
+    _tasksQueued.subtractAndFetch(1);
+    return true;
+}
+
+bool ServiceExecutorWorkStealing::_stealTask(Worker* thief, Task* task) {
+    // Steal from the back of a peer's queue, which is the task its owner would run last.
+    const auto numWorkers = _workers.size();
+    for (size_t i = 1; i < numWorkers; ++i) {
+        auto victim = _workers[(thief->id + i) % numWorkers].get();
+        stdx::lock_guard<Latch> lk(victim->mutex);
+        if (victim->queue.empty()) {
+            continue;
+        }
+
+        *task = std::move(victim->queue.back());
+        victim->queue.pop_back();
+        _tasksQueued.subtractAndFetch(1);
+        thief->stolen.addAndFetch(1);
+        return true;
+    }
+
+    return false;
+}
+
+void ServiceExecutorWorkStealing::_workerThreadRoutine(Worker* worker) {
+    _localExecutor = this;
+    _localWorker = worker;
+    {
+        std::string threadName = str::stream() << "worker-" << worker->id;
+        setThreadName(threadName);
+    }
+
+    if (_config->pinWorkersToCores()) {
+        pinThreadToCore(worker->id);
+    }
+
+    LOGV2_DEBUG(5135213, 3, "Started work stealing executor worker", "id"_attr = worker->id);
+
+    const auto guard = makeGuard([this] {
+        _localExecutor = nullptr;
+        _localWorker = nullptr;
+
+        stdx::lock_guard<Latch> lk(_shutdownMutex);
+        _threadsRunning.subtractAndFetch(1);
+        _shutdownCondition.notify_all();
+    });
+
+    while (_isRunning.load()) {
+        _runQueuedTasks(worker);
+
+        // Announce that this worker is about to poll before checking for queued tasks one last
+        // time. A concurrent schedule() either sees this worker polling and wakes it up, or queued
+        // its task early enough for the check below to find it.
+        worker->polling.store(true);
+        _workersPolling.addAndFetch(1);
+        if (_tasksQueued.load() == 0) {
+            _reactorHandle->runFor(_config->reactorPollTime());
+        }
+        _workersPolling.subtractAndFetch(1);
+        worker->polling.store(false);
+    }
+}
+
+void ServiceExecutorWorkStealing::appendStats(BSONObjBuilder* bob) const {
+    int64_t totalExecuted = 0;
+    int64_t totalStolen = 0;
+    for (const auto& worker : _workers) {
+        totalExecuted += worker->executed.load();
+        totalStolen += worker->stolen.load();
+    }
+
+    *bob << kExecutorLabel << kExecutorName            //
+         << kTotalQueued << _totalQueued.load()        //
+         << kTotalExecuted << totalExecuted            //
+         << kTotalStolen << totalStolen                //
+         << kThreadsRunning << _threadsRunning.load()  //
+         << kThreadsPolling << _workersPolling.load();
+}
+
+}  // namespace transport
+}  // namespace mongo
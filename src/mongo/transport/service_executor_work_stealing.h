@@ -0,0 +1,157 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/transport/service_executor.h"
+#include "mongo/transport/service_executor_task_names.h"
+#include "mongo/transport/transport_layer.h"
+
+namespace mongo {
+namespace transport {
+
+/**
+ * This is an ASIO-based ServiceExecutor that runs a fixed number of worker threads, by default one
+ * per core. Each worker owns a run queue. Tasks scheduled from a worker thread are queued on that
+ * worker so that the tasks of a ServiceStateMachine tend to stay on the same core, and workers
+ * that run out of tasks steal queued tasks from their peers before polling the reactor for
+ * network events.
+ */
+class ServiceExecutorWorkStealing final : public ServiceExecutor {
+public:
+    struct Options {
+        virtual ~Options() = default;
+        // The number of worker threads the executor runs.
+        virtual int workerThreads() const = 0;
+
+        // The longest time an idle worker polls the reactor before looking for tasks to steal.
+        virtual Milliseconds reactorPollTime() const = 0;
+
+        // The maximum allowable depth of recursion for tasks scheduled with the MayRecurse flag
+        // before stack unwinding is forced.
+        virtual int recursionLimit() const = 0;
+
+        // Whether each worker thread is bound to a single core.
+        virtual bool pinWorkersToCores() const = 0;
+    };
+
+    explicit ServiceExecutorWorkStealing(ServiceContext* ctx, ReactorHandle reactor);
+    explicit ServiceExecutorWorkStealing(ServiceContext* ctx,
+                                         ReactorHandle reactor,
+                                         std::unique_ptr<Options> config);
+
+    ~ServiceExecutorWorkStealing();
+
+    Status start() override;
+    Status shutdown(Milliseconds timeout) override;
+    Status schedule(Task task, ScheduleFlags flags, ServiceExecutorTaskName taskName) override;
+
+    Mode transportMode() const override {
+        return Mode::kAsynchronous;
+    }
+
+    void appendStats(BSONObjBuilder* bob) const override;
+
+    int threadsRunning() const {
+        return _threadsRunning.load();
+    }
+
+private:
+    struct Worker {
+        explicit Worker(size_t id) : id(id) {}
+
+        const size_t id;
+
+        Mutex mutex = MONGO_MAKE_LATCH("ServiceExecutorWorkStealing::Worker::mutex");
+        std::deque<Task> queue;
+
+        // Set while the worker is blocked in the reactor rather than running tasks.
+        AtomicWord<bool> polling{false};
+        int recursionDepth = 0;
+
+        AtomicWord<int64_t> executed{0};
+        AtomicWord<int64_t> stolen{0};
+    };
+
+    void _workerThreadRoutine(Worker* worker);
+
+    /**
+     * Runs 'task' on 'worker', which must be the worker that owns the calling thread.
+     */
+    void _runTask(Worker* worker, Task& task);
+
+    /**
+     * Runs the tasks queued on the current worker, then tasks stolen from its peers, until there
+     * are none left or the executor is shut down.
+     */
+    void _runQueuedTasks(Worker* worker);
+
+    bool _popLocalTask(Worker* worker, Task* task);
+    bool _stealTask(Worker* thief, Task* task);
+
+    /**
+     * Returns the worker that owns the calling thread, or nullptr if the calling thread is not one
+     * of this executor's workers.
+     */
+    Worker* _currentWorker() const;
+
+    ReactorHandle _reactorHandle;
+    std::unique_ptr<Options> _config;
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    AtomicWord<size_t> _nextWorker{0};
+
+    AtomicWord<bool> _isRunning{false};
+    AtomicWord<int> _threadsRunning{0};
+    AtomicWord<int> _workersPolling{0};
+
+    // The number of tasks sitting in the workers' queues.
+    AtomicWord<int64_t> _tasksQueued{0};
+
+    mutable Mutex _shutdownMutex = MONGO_MAKE_LATCH("ServiceExecutorWorkStealing::_shutdownMutex");
+    stdx::condition_variable _shutdownCondition;
+
+    // These counters are only used for reporting in serverStatus.
+    AtomicWord<int64_t> _totalQueued{0};
+
+    static thread_local ServiceExecutorWorkStealing* _localExecutor;
+    static thread_local Worker* _localWorker;
+};
+
+}  // namespace transport
+}  // namespace mongo
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <utility>
 
 #include "mongo/base/system_error.h"
@@ -382,15 +383,16 @@ private:
     Future<Message> sourceMessageImpl(const BatonHandle& baton = nullptr) {
         static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
 
-        auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
-        auto ptr = headerBuffer.get();
-        return read(asio::buffer(ptr, kHeaderSize), baton)
-            .then([headerBuffer = std::move(headerBuffer), this, baton]() mutable {
-                if (checkForHTTPRequest(asio::buffer(headerBuffer.get(), kHeaderSize))) {
+        // The header is read into storage owned by the session so that each message costs a single
+        // allocation, sized from the header, which the parsed request then shares ownership of.
+        return read(asio::buffer(_headerBuffer.data(), kHeaderSize), baton)
+            .then([this, baton]() mutable {
+                if (checkForHTTPRequest(asio::buffer(_headerBuffer.data(), kHeaderSize))) {
                     return sendHTTPResponse(baton);
                 }
 
-                const auto msgLen = size_t(MSGHEADER::View(headerBuffer.get()).getMessageLength());
+                const auto msgLen =
+                    size_t(MSGHEADER::View(_headerBuffer.data()).getMessageLength());
                 if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
                     StringBuilder sb;
                     sb << "recv(): message msgLen " << msgLen << " is invalid. "
@@ -406,17 +408,17 @@ private:
                     return Future<Message>::makeReady(Status(ErrorCodes::ProtocolError, str));
                 }
 
+                auto buffer = SharedBuffer::allocate(msgLen);
+                memcpy(buffer.get(), _headerBuffer.data(), kHeaderSize);
+
                 if (msgLen == kHeaderSize) {
                     // This probably isn't a real case since all (current) messages have bodies.
                     if (_isIngressSession) {
                         networkCounter.hitPhysicalIn(msgLen);
                     }
-                    return Future<Message>::makeReady(Message(std::move(headerBuffer)));
+                    return Future<Message>::makeReady(Message(std::move(buffer)));
                 }
 
-                auto buffer = SharedBuffer::allocate(msgLen);
-                memcpy(buffer.get(), headerBuffer.get(), kHeaderSize);
-
                 MsgData::View msgView(buffer.get());
                 return read(asio::buffer(msgView.data(), msgView.dataLen()), baton)
                     .then([this, buffer = std::move(buffer), msgLen]() mutable {
@@ -777,6 +779,10 @@ private:
 
     TransportLayerASIO* const _tl;
     bool _isIngressSession;
+
+    // Only one sourceMessage() may be outstanding on a session at a time, so the header of the
+    // message being received can live here rather than in a separate allocation.
+    std::array<char, sizeof(MSGHEADER::Value)> _headerBuffer;
 };
 
 }  // namespace transport
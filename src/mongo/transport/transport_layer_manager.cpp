@@ -43,6 +43,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/transport/service_executor_adaptive.h"
 #include "mongo/transport/service_executor_synchronous.h"
+#include "mongo/transport/service_executor_work_stealing.h"
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer_asio.h"
 #include "mongo/util/net/ssl_types.h"
@@ -143,6 +144,8 @@ std::unique_ptr<TransportLayer> TransportLayerManager::createWithConfig(
                       "The adaptive service executor implementation is deprecated, please leave "
                       "--serviceExecutor unspecified");
         opts.transportMode = transport::Mode::kAsynchronous;
+    } else if (config->serviceExecutor == "workStealing") {
+        opts.transportMode = transport::Mode::kAsynchronous;
     } else if (config->serviceExecutor == "synchronous") {
         opts.transportMode = transport::Mode::kSynchronous;
     } else {
@@ -154,6 +157,10 @@ std::unique_ptr<TransportLayer> TransportLayerManager::createWithConfig(
     if (config->serviceExecutor == "adaptive") {
         auto reactor = transportLayerASIO->getReactor(TransportLayer::kIngress);
         ctx->setServiceExecutor(std::make_unique<ServiceExecutorAdaptive>(ctx, std::move(reactor)));
+    } else if (config->serviceExecutor == "workStealing") {
+        auto reactor = transportLayerASIO->getReactor(TransportLayer::kIngress);
+        ctx->setServiceExecutor(
+            std::make_unique<ServiceExecutorWorkStealing>(ctx, std::move(reactor)));
     } else if (config->serviceExecutor == "synchronous") {
         ctx->setServiceExecutor(std::make_unique<ServiceExecutorSynchronous>(ctx));
     }